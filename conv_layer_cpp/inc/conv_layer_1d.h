@@ -111,13 +111,14 @@ protected:
     std::size_t numPaddings() const;
 
     void calculateKernelError();
-    std::vector<double> pad(const std::vector<double>& data);
+    void pad(const std::vector<double>& data, std::vector<double>& padded);
 
     std::vector<double> myInputPadded{};
     std::vector<double> myKernel{};
     std::vector<double> myOutput{};
     std::vector<double> myKernelError{};
     std::vector<double> myInputError{};
+    std::vector<double> myOutputErrorPadded{};
 };
 
 } // namespace ml
\ No newline at end of file
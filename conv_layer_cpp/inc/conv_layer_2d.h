@@ -113,7 +113,8 @@ public:
 
 protected:
     void initKernel(const std::size_t kernelSize);
-    std::vector<std::vector<double>> pad(const std::vector<std::vector<double>>& input);
+    void pad(const std::vector<std::vector<double>>& input, 
+             std::vector<std::vector<double>>& padded);
     std::size_t numPaddings() const;
 
     static std::size_t width(const std::vector<std::vector<double>>& input);
@@ -124,6 +125,7 @@ protected:
     std::vector<std::vector<double>> myOutput{};
     std::vector<std::vector<double>> myInputError{};
     std::vector<std::vector<double>> myKernelError{};
+    std::vector<std::vector<double>> myOutputErrorPadded{};
 };
 
 } // namespace ml
\ No newline at end of file
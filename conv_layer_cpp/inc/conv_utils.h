@@ -134,6 +134,60 @@ std::vector<std::vector<T>> pad(const std::vector<std::vector<T>>& data,
                                 const std::vector<std::vector<double>>& kernel,
                                 const T padValue = 0);
 
+/********************************************************************************
+ * @brief Stores a padded copy of referenced vector in another vector. The
+ *        storage of the destination is reused, so no memory is allocated once
+ *        the destination has been padded to the same size before.
+ * 
+ * @tparam T The vector type (must be arithmetic).
+ * 
+ * @param data        Reference to the vector to copy.
+ * @param padded      Reference to the vector to store the padded copy in.
+ * @param numPaddings The number of paddings to add to each side of the copy.
+ * @param padValue    The value to pad the copy with (default = 0).
+ ********************************************************************************/
+template <typename T>
+void padInto(const std::vector<T>& data, 
+             std::vector<T>& padded,
+             const std::size_t numPaddings,
+             const T padValue = 0);
+
+/********************************************************************************
+ * @brief Stores a padded copy of referenced two-dimensional vector in another 
+ *        vector. The storage of the destination is reused, so no memory is 
+ *        allocated once the destination has been padded to the same size before.
+ * 
+ * @tparam T The vector type (must be arithmetic).
+ * 
+ * @param data        Reference to the vector to copy.
+ * @param padded      Reference to the vector to store the padded copy in.
+ * @param numPaddings The number of paddings to add to each side of the copy.
+ * @param padValue    The value to pad the copy with (default = 0).
+ ********************************************************************************/
+template <typename T>
+void padInto(const std::vector<std::vector<T>>& data, 
+             std::vector<std::vector<T>>& padded,
+             const std::size_t numPaddings,
+             const T padValue = 0);
+
+/********************************************************************************
+ * @brief Resizes referenced two-dimensional vector and sets all values. The 
+ *        storage of the vector is reused, so no memory is allocated unless the
+ *        vector grows.
+ * 
+ * @tparam T The vector type (must be arithmetic).
+ * 
+ * @param data       Reference to the vector to resize.
+ * @param numRows    The new number of rows.
+ * @param numColumns The new number of columns.
+ * @param value      The value to set (default = 0).
+ ********************************************************************************/
+template <typename T>
+void assign(std::vector<std::vector<T>>& data, 
+            const std::size_t numRows, 
+            const std::size_t numColumns,
+            const T value = 0);
+
 /********************************************************************************
  * @brief Prints number held by referenced one-dimensional vector. 
  * 
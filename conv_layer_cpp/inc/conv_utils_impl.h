@@ -40,11 +40,8 @@ std::vector<T> pad(const std::vector<T>& data,
 {
     static_assert(std::is_arithmetic<T>::value, 
         "Function ml::pad does not support non-arithmetic types!");
-    std::vector<T> padded(numPaddings * 2 + data.size(), padValue);
-    for (std::size_t i{}; i < data.size(); ++i)
-    {
-        padded[numPaddings + i] = data[i];
-    }
+    std::vector<T> padded{};
+    padInto<T>(data, padded, numPaddings, padValue);
     return padded;
 }
 
@@ -67,10 +64,53 @@ std::vector<std::vector<T>> pad(const std::vector<std::vector<T>>& data,
 {
     static_assert(std::is_arithmetic<T>::value, 
         "Function ml::pad does not support non-arithmetic types!");
-    if (data.empty()) { return {}; }
-    const auto numValuesPerRow(numPaddings * 2 + data[0].size());
-    std::vector<std::vector<double>> padded(numPaddings * 2 + data.size(), 
-        std::vector<double>(numValuesPerRow, padValue));
+    std::vector<std::vector<T>> padded{};
+    padInto<T>(data, padded, numPaddings, padValue);
+    return padded;
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+std::vector<std::vector<T>> pad(const std::vector<std::vector<T>>& data, 
+                                const std::vector<std::vector<double>>& kernel,
+                                const T padValue)
+{
+    static_assert(std::is_arithmetic<T>::value, 
+        "Function ml::pad does not support non-arithmetic types!");
+    return pad(data, numPaddings(kernel), padValue);
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void padInto(const std::vector<T>& data, 
+             std::vector<T>& padded,
+             const std::size_t numPaddings,
+             const T padValue)
+{
+    static_assert(std::is_arithmetic<T>::value, 
+        "Function ml::padInto does not support non-arithmetic types!");
+    padded.assign(numPaddings * 2 + data.size(), padValue);
+    for (std::size_t i{}; i < data.size(); ++i)
+    {
+        padded[numPaddings + i] = data[i];
+    }
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void padInto(const std::vector<std::vector<T>>& data, 
+             std::vector<std::vector<T>>& padded,
+             const std::size_t numPaddings,
+             const T padValue)
+{
+    static_assert(std::is_arithmetic<T>::value, 
+        "Function ml::padInto does not support non-arithmetic types!");
+    if (data.empty()) 
+    { 
+        padded.clear();
+        return;
+    }
+    assign<T>(padded, numPaddings * 2 + data.size(), numPaddings * 2 + data[0].size(), padValue);
     for (std::size_t i{}; i < data.size(); ++i)
     {
         for (std::size_t j{}; j < data[0].size(); ++j)
@@ -78,18 +118,22 @@ std::vector<std::vector<T>> pad(const std::vector<std::vector<T>>& data,
             padded[numPaddings + i][numPaddings + j] = data[i][j];
         }
     }
-    return padded;
 }
 
 // -----------------------------------------------------------------------------
 template <typename T>
-std::vector<std::vector<T>> pad(const std::vector<std::vector<T>>& data, 
-                                const std::vector<std::vector<double>>& kernel,
-                                const T padValue)
+void assign(std::vector<std::vector<T>>& data, 
+            const std::size_t numRows, 
+            const std::size_t numColumns,
+            const T value)
 {
     static_assert(std::is_arithmetic<T>::value, 
-        "Function ml::pad does not support non-arithmetic types!");
-    return pad(data, numPaddings(kernel), padValue);
+        "Function ml::assign does not support non-arithmetic types!");
+    data.resize(numRows);
+    for (auto& row : data)
+    {
+        row.assign(numColumns, value);
+    }
 }
 
 // -----------------------------------------------------------------------------
@@ -138,7 +182,7 @@ inline void initRandomGenerator()
 }
 
 // -----------------------------------------------------------------------------
-template <typename T = int>
+template <typename T>
 enable_if_integral<T, T> random(const T min, const T max)
 {
     static_assert(std::is_integral<T>::value);
@@ -146,7 +190,7 @@ enable_if_integral<T, T> random(const T min, const T max)
 }
 
 // -----------------------------------------------------------------------------
-template <typename T = double>
+template <typename T>
 enable_if_float<T, T> random(const T min, const T max)
 {
     static_assert(std::is_floating_point<T>::value);
@@ -38,8 +38,8 @@ std::size_t ConvLayer1D::kernelSize() const { return myKernel.size(); }
 // -----------------------------------------------------------------------------
 void ConvLayer1D::feedforward(const std::vector<double>& input)
 {
-    myInputPadded = pad(input);
-    myOutput.resize(input.size(), 0);
+    setInputPadded(input);
+    myOutput.assign(input.size(), 0);
     
     for (std::size_t i{}; i < imageSize(); ++i)
     {
@@ -53,17 +53,16 @@ void ConvLayer1D::feedforward(const std::vector<double>& input)
 // -----------------------------------------------------------------------------
 void ConvLayer1D::backpropagate(const std::vector<double>& outputError)
 {
-    std::vector<double> outputErrorPadded{pad(outputError)};
-
-    myKernelError.resize(kernelSize(), 0);
-    myInputError.resize(imageSize(), 0);
+    pad(outputError, myOutputErrorPadded);
+    myKernelError.assign(kernelSize(), 0);
+    myInputError.assign(imageSize(), 0);
 
     for (std::size_t i{}; i < imageSize(); ++i)
     {
         for (std::size_t j{}; j < kernelSize(); ++j)
         {
             myKernelError[j] += myInputPadded[i + j] * outputError[i];
-            myInputError[i] += outputErrorPadded[kernelSize() - 1 + i - j] * myKernel[j];
+            myInputError[i] += myOutputErrorPadded[kernelSize() - 1 + i - j] * myKernel[j];
         }
     }
 }
@@ -92,20 +91,16 @@ void ConvLayer1D::initKernel(const std::size_t kernelSize)
 // -----------------------------------------------------------------------------
 void ConvLayer1D::setInputPadded(const std::vector<double>& input)
 {
-    myInputPadded.resize(numPaddings() * 2 + input.size(), 0);
-    for (std::size_t i{}; i < input.size(); ++i)
-    {
-        myInputPadded[i + numPaddings()] = input[i];
-    }
+    pad(input, myInputPadded);
 }
 
 // -----------------------------------------------------------------------------
 std::size_t ConvLayer1D::numPaddings() const { return kernelSize() / 2; }
 
 // -----------------------------------------------------------------------------
-std::vector<double> ConvLayer1D::pad(const std::vector<double>& data)
+void ConvLayer1D::pad(const std::vector<double>& data, std::vector<double>& padded)
 {
-    return utils::pad<double>(data, numPaddings());
+    utils::padInto<double>(data, padded, numPaddings());
 }
 
 } // namespace ml
\ No newline at end of file
@@ -59,8 +59,8 @@ std::size_t ConvLayer2D::kernelSize() const { return myKernel.size(); }
 void ConvLayer2D::feedforward(const std::vector<std::vector<double>>& input)
 {
     if (input.empty()) { return; }
-    myInputPadded = pad(input);
-    myOutput.resize(input.size(), std::vector<double>(input[0].size(), 0));
+    pad(input, myInputPadded);
+    utils::assign<double>(myOutput, width(input), height(input));
 
     for (std::size_t i{}; i < imageWidth(); ++i)
     {
@@ -80,9 +80,9 @@ void ConvLayer2D::feedforward(const std::vector<std::vector<double>>& input)
 // -----------------------------------------------------------------------------
 void ConvLayer2D::backpropagate(const std::vector<std::vector<double>>& outputError)
 {
-    myKernelError.resize(kernelSize(), std::vector<double>(kernelSize(), 0));
-    myInputError.resize(imageWidth(), std::vector<double>(imageHeight(), 0));
-    const std::vector<std::vector<double>> outputErrorPadded{pad(outputError)};
+    utils::assign<double>(myKernelError, kernelSize(), kernelSize());
+    utils::assign<double>(myInputError, imageWidth(), imageHeight());
+    pad(outputError, myOutputErrorPadded);
     const auto offset{kernelSize() - 1};
 
     for (std::size_t i{}; i < imageWidth(); ++i)
@@ -95,7 +95,7 @@ void ConvLayer2D::backpropagate(const std::vector<std::vector<double>>& outputEr
                 {
                     myKernelError[k][l] += myInputPadded[i + k][j + l] * outputError[i][j];
                     myInputError[i][j] += 
-                        outputErrorPadded[offset + i - k][offset + j - l] * myKernel[k][l];
+                        myOutputErrorPadded[offset + i - k][offset + j - l] * myKernel[k][l];
                 }
             }
         }
@@ -128,9 +128,10 @@ void ConvLayer2D::initKernel(const std::size_t kernelSize)
 }
 
 // -----------------------------------------------------------------------------
-std::vector<std::vector<double>> ConvLayer2D::pad(const std::vector<std::vector<double>>& input)
+void ConvLayer2D::pad(const std::vector<std::vector<double>>& input, 
+                      std::vector<std::vector<double>>& padded)
 {
-    return utils::pad<double>(input, myKernel);
+    utils::padInto<double>(input, padded, numPaddings());
 }
 
 // -----------------------------------------------------------------------------
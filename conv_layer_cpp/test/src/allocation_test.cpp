@@ -0,0 +1,110 @@
+/********************************************************************************
+ * @brief Tests verifying that the convolutional layers don't allocate memory 
+ *        once warmed up. The global allocation functions are replaced by 
+ *        versions counting the allocations made while a test has armed the 
+ *        counter, so any allocation in the steady state is caught.
+ ********************************************************************************/
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#include "conv_layer_1d.h"
+#include "conv_layer_2d.h"
+
+namespace
+{
+
+/********************************************************************************
+ * @brief The number of allocations made while armed, see AllocationCounter.
+ ********************************************************************************/
+thread_local bool armed{false};
+thread_local std::size_t numAllocations{0};
+
+void* allocate(const std::size_t size)
+{
+    if (armed) { ++numAllocations; }
+    auto data{std::malloc(size > 0 ? size : 1)};
+    if (data == nullptr) { throw std::bad_alloc{}; }
+    return data;
+}
+
+/********************************************************************************
+ * @brief Counts the allocations of the calling thread during its lifetime.
+ ********************************************************************************/
+class AllocationCounter
+{
+public:
+    AllocationCounter()
+    {
+        numAllocations = 0;
+        armed = true;
+    }
+    ~AllocationCounter() { armed = false; }
+    std::size_t count() const { return numAllocations; }
+};
+
+} // namespace
+
+void* operator new(std::size_t size) { return allocate(size); }
+void* operator new[](std::size_t size) { return allocate(size); }
+void operator delete(void* data) noexcept { std::free(data); }
+void operator delete[](void* data) noexcept { std::free(data); }
+void operator delete(void* data, std::size_t) noexcept { std::free(data); }
+void operator delete[](void* data, std::size_t) noexcept { std::free(data); }
+
+namespace
+{
+
+// -----------------------------------------------------------------------------
+TEST(AllocationTest, ConvLayer1DSteadyState)
+{
+    ml::ConvLayer1D layer{3};
+    const std::vector<double> input{1, -2, 3, 0.5, -1, 2, 0, 1};
+    const std::vector<double> outputError(input.size(), 0.1);
+
+    // The first pass sizes the buffers of the layer.
+    layer.feedforward(input);
+    layer.backpropagate(outputError);
+    layer.optimize(0.01);
+
+    const AllocationCounter counter{};
+    for (std::size_t i{}; i < 10; ++i)
+    {
+        layer.feedforward(input);
+        layer.backpropagate(outputError);
+        layer.optimize(0.01);
+    }
+    EXPECT_EQ(counter.count(), 0U);
+}
+
+// -----------------------------------------------------------------------------
+TEST(AllocationTest, ConvLayer2DSteadyState)
+{
+    ml::ConvLayer2D layer{3};
+    const std::vector<std::vector<double>> input{{1, 2, 3, 4}, {4, -5, 6, 0}, 
+                                                 {7, 8, -9, 1}, {0, 1, 2, 3}};
+    const std::vector<std::vector<double>> outputError(input.size(), 
+        std::vector<double>(input.size(), 0.1));
+
+    layer.feedforward(input);
+    layer.backpropagate(outputError);
+    layer.optimize(0.01);
+
+    const AllocationCounter counter{};
+    for (std::size_t i{}; i < 10; ++i)
+    {
+        layer.feedforward(input);
+        layer.backpropagate(outputError);
+        layer.optimize(0.01);
+    }
+    EXPECT_EQ(counter.count(), 0U);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
\ No newline at end of file
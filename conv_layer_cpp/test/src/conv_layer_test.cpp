@@ -0,0 +1,158 @@
+/********************************************************************************
+ * @brief Unit tests for the convolutional layers. The output and the errors 
+ *        are compared with convolutions calculated in the tests, also when the
+ *        layers are run repeatedly, since every pass starts from zero.
+ ********************************************************************************/
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "conv_layer_1d.h"
+#include "conv_layer_2d.h"
+
+namespace
+{
+
+/********************************************************************************
+ * @brief Provides the output of a one-dimensional convolution with a centered
+ *        kernel, where values outside the input are zero.
+ ********************************************************************************/
+std::vector<double> convolve(const std::vector<double>& input, 
+                             const std::vector<double>& kernel)
+{
+    std::vector<double> output(input.size(), 0);
+    for (std::size_t i{}; i < input.size(); ++i)
+    {
+        for (std::size_t j{}; j < kernel.size(); ++j)
+        {
+            const auto k{static_cast<long>(i + j) - static_cast<long>(kernel.size() / 2)};
+            if (k >= 0 && k < static_cast<long>(input.size())) 
+            { 
+                output[i] += input[k] * kernel[j]; 
+            }
+        }
+    }
+    return output;
+}
+
+/********************************************************************************
+ * @brief Provides the output of a two-dimensional convolution with a centered
+ *        kernel, where values outside the input are zero.
+ ********************************************************************************/
+std::vector<std::vector<double>> convolve(const std::vector<std::vector<double>>& input, 
+                                          const std::vector<std::vector<double>>& kernel)
+{
+    const auto offset{static_cast<long>(kernel.size() / 2)};
+    const auto size{static_cast<long>(input.size())};
+    std::vector<std::vector<double>> output(input.size(), 
+        std::vector<double>(input[0].size(), 0));
+    for (long i{}; i < size; ++i)
+    {
+        for (long j{}; j < size; ++j)
+        {
+            for (long k{}; k < static_cast<long>(kernel.size()); ++k)
+            {
+                for (long l{}; l < static_cast<long>(kernel.size()); ++l)
+                {
+                    const auto x{i + k - offset};
+                    const auto y{j + l - offset};
+                    if (x >= 0 && x < size && y >= 0 && y < size) 
+                    { 
+                        output[i][j] += input[x][y] * kernel[k][l]; 
+                    }
+                }
+            }
+        }
+    }
+    return output;
+}
+
+// -----------------------------------------------------------------------------
+TEST(ConvLayerTest, Feedforward1DStartsFromZero)
+{
+    ml::ConvLayer1D layer{3};
+    const std::vector<double> input{1, -2, 3, 0.5, -1, 2};
+    const auto expected{convolve(input, layer.kernel())};
+
+    for (std::size_t i{}; i < 3; ++i)
+    {
+        layer.feedforward(input);
+        ASSERT_EQ(layer.output().size(), expected.size());
+        for (std::size_t j{}; j < expected.size(); ++j)
+        {
+            EXPECT_NEAR(layer.output()[j], expected[j], 1e-12);
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+TEST(ConvLayerTest, Backpropagate1DStartsFromZero)
+{
+    ml::ConvLayer1D layer{3};
+    const std::vector<double> input{1, -2, 3, 0.5, -1, 2};
+    const std::vector<double> outputError{0.5, 1, -1, 2, 0, -0.5};
+    layer.feedforward(input);
+    layer.backpropagate(outputError);
+    const auto kernelError{layer.kernelError()};
+    const auto inputError{layer.inputError()};
+
+    // The errors are the same for every pass with the same input and kernel.
+    for (std::size_t i{}; i < 3; ++i)
+    {
+        layer.feedforward(input);
+        layer.backpropagate(outputError);
+        EXPECT_EQ(layer.kernelError(), kernelError);
+        EXPECT_EQ(layer.inputError(), inputError);
+    }
+    double expected{};
+    for (std::size_t i{}; i < input.size(); ++i) { expected += input[i] * outputError[i]; }
+    EXPECT_NEAR(kernelError[1], expected, 1e-12);
+}
+
+// -----------------------------------------------------------------------------
+TEST(ConvLayerTest, Feedforward2DStartsFromZero)
+{
+    ml::ConvLayer2D layer{3};
+    const std::vector<std::vector<double>> input{{1, 2, 3}, {4, -5, 6}, {7, 8, -9}};
+    const auto expected{convolve(input, layer.kernel())};
+
+    for (std::size_t i{}; i < 3; ++i)
+    {
+        layer.feedforward(input);
+        ASSERT_EQ(layer.output().size(), expected.size());
+        for (std::size_t j{}; j < expected.size(); ++j)
+        {
+            for (std::size_t k{}; k < expected[j].size(); ++k)
+            {
+                EXPECT_NEAR(layer.output()[j][k], expected[j][k], 1e-12);
+            }
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+TEST(ConvLayerTest, Backpropagate2DStartsFromZero)
+{
+    ml::ConvLayer2D layer{2};
+    const std::vector<std::vector<double>> input{{1, 2, 3}, {4, -5, 6}, {7, 8, -9}};
+    const std::vector<std::vector<double>> outputError{{1, 0, -1}, {0.5, 1, 0}, {2, -1, 1}};
+    layer.feedforward(input);
+    layer.backpropagate(outputError);
+    const auto kernelError{layer.kernelError()};
+    const auto inputError{layer.inputError()};
+
+    for (std::size_t i{}; i < 3; ++i)
+    {
+        layer.feedforward(input);
+        layer.backpropagate(outputError);
+        EXPECT_EQ(layer.kernelError(), kernelError);
+        EXPECT_EQ(layer.inputError(), inputError);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
\ No newline at end of file
@@ -0,0 +1,158 @@
+/********************************************************************************
+ * @brief Benchmarks of the linear algebra kernels used by the dense layers. 
+ *        Every kernel is run with each supported instruction set for a range of 
+ *        layer sizes, so the speedup of the SIMD kernels can be compared with
+ *        the scalar fallback.
+ ********************************************************************************/
+#include <benchmark/benchmark.h>
+
+#include <linalg.hpp>
+#include <matrix.hpp>
+#include <utils.hpp>
+
+using namespace yrgo::machine_learning;
+
+namespace {
+
+const char* SimdLevelName(const linalg::SimdLevel level) {
+    switch (level) {
+        case linalg::SimdLevel::kAvx512: return "avx512";
+        case linalg::SimdLevel::kAvx2:   return "avx2";
+        default:                         return "scalar";
+    }
+}
+
+bool SelectSimdLevel(benchmark::State& state) {
+    const auto requested{static_cast<linalg::SimdLevel>(state.range(1))};
+    if (linalg::SetSimdLevel(requested) != requested) {
+        state.SkipWithError("Instruction set not supported by this CPU!");
+        return false;
+    }
+    state.SetLabel(SimdLevelName(requested));
+    return true;
+}
+
+Matrix<double> RandomMatrix(const std::size_t num_rows, const std::size_t num_columns) {
+    Matrix<double> matrix{num_rows, num_columns};
+    for (std::size_t i{}; i < num_rows; ++i) {
+        for (std::size_t j{}; j < num_columns; ++j) {
+            matrix.Row(i)[j] = yrgo::utils::random::GetNumber<double>(-1, 1);
+        }
+    }
+    return matrix;
+}
+
+void SetFlops(benchmark::State& state, const double flops_per_iteration) {
+    state.counters["GFLOP/s"] = benchmark::Counter(flops_per_iteration * 1e-9,
+        benchmark::Counter::kIsIterationInvariantRate);
+}
+
+void BM_Dot(benchmark::State& state) {
+    if (!SelectSimdLevel(state)) { return; }
+    const auto size{static_cast<std::size_t>(state.range(0))};
+    const auto x{RandomMatrix(1, size)}, y{RandomMatrix(1, size)};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(linalg::Dot(x.Row(0), y.Row(0), size));
+    }
+    SetFlops(state, 2.0 * size);
+}
+
+void BM_Axpy(benchmark::State& state) {
+    if (!SelectSimdLevel(state)) { return; }
+    const auto size{static_cast<std::size_t>(state.range(0))};
+    const auto x{RandomMatrix(1, size)};
+    auto y{RandomMatrix(1, size)};
+    for (auto _ : state) {
+        linalg::Axpy(1e-9, x.Row(0), y.Row(0), size);
+        benchmark::ClobberMemory();
+    }
+    SetFlops(state, 2.0 * size);
+}
+
+// Feedforward of one sample through a square layer (gemv).
+void BM_Gemv(benchmark::State& state) {
+    if (!SelectSimdLevel(state)) { return; }
+    const auto size{static_cast<std::size_t>(state.range(0))};
+    const auto weights{RandomMatrix(size, size)}, input{RandomMatrix(1, size)};
+    Matrix<double> output{1, size};
+    for (auto _ : state) {
+        linalg::MultiplyTransposed(input.View(), weights.View(), output.View());
+        benchmark::ClobberMemory();
+    }
+    SetFlops(state, 2.0 * size * size);
+}
+
+// Backpropagation of one sample through a square hidden layer (transposed gemv).
+void BM_GemvTransposed(benchmark::State& state) {
+    if (!SelectSimdLevel(state)) { return; }
+    const auto size{static_cast<std::size_t>(state.range(0))};
+    const auto weights{RandomMatrix(size, size)}, error{RandomMatrix(1, size)};
+    Matrix<double> output{1, size};
+    for (auto _ : state) {
+        linalg::Multiply(error.View(), weights.View(), output.View());
+        benchmark::ClobberMemory();
+    }
+    SetFlops(state, 2.0 * size * size);
+}
+
+// The batch kernels of a square layer with kBatchSize samples, i.e. feedforward
+// (gemm), backpropagation (transposed gemm) and the weight gradients.
+constexpr std::size_t kBatchSize{64};
+
+void BM_Gemm(benchmark::State& state) {
+    if (!SelectSimdLevel(state)) { return; }
+    const auto size{static_cast<std::size_t>(state.range(0))};
+    const auto weights{RandomMatrix(size, size)}, input{RandomMatrix(kBatchSize, size)};
+    Matrix<double> output{kBatchSize, size};
+    for (auto _ : state) {
+        linalg::MultiplyTransposed(input.View(), weights.View(), output.View());
+        benchmark::ClobberMemory();
+    }
+    SetFlops(state, 2.0 * kBatchSize * size * size);
+}
+
+void BM_GemmTransposed(benchmark::State& state) {
+    if (!SelectSimdLevel(state)) { return; }
+    const auto size{static_cast<std::size_t>(state.range(0))};
+    const auto weights{RandomMatrix(size, size)}, error{RandomMatrix(kBatchSize, size)};
+    Matrix<double> output{kBatchSize, size};
+    for (auto _ : state) {
+        linalg::Multiply(error.View(), weights.View(), output.View());
+        benchmark::ClobberMemory();
+    }
+    SetFlops(state, 2.0 * kBatchSize * size * size);
+}
+
+void BM_WeightGradient(benchmark::State& state) {
+    if (!SelectSimdLevel(state)) { return; }
+    const auto size{static_cast<std::size_t>(state.range(0))};
+    const auto error{RandomMatrix(kBatchSize, size)}, input{RandomMatrix(kBatchSize, size)};
+    auto gradient{RandomMatrix(size, size)};
+    for (auto _ : state) {
+        linalg::AddTransposedProduct(error.View(), input.View(), gradient.View());
+        benchmark::ClobberMemory();
+    }
+    SetFlops(state, 2.0 * kBatchSize * size * size);
+}
+
+void SimdArguments(benchmark::internal::Benchmark* benchmark) {
+    for (const auto size : {16, 64, 128, 512, 1024}) {
+        for (const auto level : {linalg::SimdLevel::kScalar, linalg::SimdLevel::kAvx2, 
+                                 linalg::SimdLevel::kAvx512}) {
+            benchmark->Args({size, static_cast<long>(level)});
+        }
+    }
+    benchmark->ArgNames({"size", "simd"});
+}
+
+BENCHMARK(BM_Dot)->Apply(SimdArguments);
+BENCHMARK(BM_Axpy)->Apply(SimdArguments);
+BENCHMARK(BM_Gemv)->Apply(SimdArguments);
+BENCHMARK(BM_GemvTransposed)->Apply(SimdArguments);
+BENCHMARK(BM_Gemm)->Apply(SimdArguments);
+BENCHMARK(BM_GemmTransposed)->Apply(SimdArguments);
+BENCHMARK(BM_WeightGradient)->Apply(SimdArguments);
+
+} /* namespace */
+
+BENCHMARK_MAIN();
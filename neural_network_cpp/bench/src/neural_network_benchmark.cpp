@@ -0,0 +1,181 @@
+/********************************************************************************
+ * @brief Benchmarks of the dense layers and the neural network, run for a grid
+ *        of layer sizes. Every benchmark reports the throughput in samples/s
+ *        and GFLOP/s, so regressions can be caught before a new version is
+ *        rolled out.
+ *
+ * @note The floating-point operations are counted as 2 per weight for every
+ *       pass over the weights (feedforward, backpropagation and optimization),
+ *       which is the dominating cost for all but the smallest layers.
+ ********************************************************************************/
+#include <benchmark/benchmark.h>
+
+#include <dense_layer.hpp>
+#include <matrix.hpp>
+#include <neural_network.hpp>
+#include <static_neural_network.hpp>
+#include <utils.hpp>
+
+using namespace yrgo::machine_learning;
+
+namespace {
+
+/********************************************************************************
+ * @brief The number of training sets used by the network benchmarks.
+ ********************************************************************************/
+constexpr std::size_t kNumSets{256};
+
+std::vector<double> RandomVector(const std::size_t size) {
+    std::vector<double> vector{};
+    yrgo::utils::random::InitVector<double>(vector, size, -1, 1);
+    return vector;
+}
+
+Matrix<double> RandomMatrix(const std::size_t num_rows, const std::size_t num_columns) {
+    Matrix<double> matrix{num_rows, num_columns};
+    for (std::size_t i{}; i < num_rows; ++i) {
+        yrgo::utils::random::Fill(matrix.Row(i), num_columns, -1.0, 1.0);
+    }
+    return matrix;
+}
+
+void SetThroughput(benchmark::State& state, const double samples_per_iteration,
+                   const double flops_per_sample) {
+    state.counters["samples/s"] = benchmark::Counter(samples_per_iteration,
+        benchmark::Counter::kIsIterationInvariantRate);
+    const auto flops{samples_per_iteration * flops_per_sample};
+    state.counters["GFLOP/s"] = benchmark::Counter(flops * 1e-9,
+        benchmark::Counter::kIsIterationInvariantRate);
+}
+
+// Feedforward of one sample through a square layer.
+void BM_LayerFeedforward(benchmark::State& state) {
+    const auto size{static_cast<std::size_t>(state.range(0))};
+    DenseLayer layer{size, size, ActFunc::kTanh};
+    const auto input{RandomVector(size)};
+    for (auto _ : state) {
+        layer.Feedforward(input);
+        benchmark::DoNotOptimize(layer.Output().data());
+    }
+    SetThroughput(state, 1, 2.0 * size * size);
+}
+
+// Backpropagation of one sample from the reference values (output layer).
+void BM_LayerBackpropagateOutput(benchmark::State& state) {
+    const auto size{static_cast<std::size_t>(state.range(0))};
+    DenseLayer layer{size, size, ActFunc::kTanh};
+    layer.Feedforward(RandomVector(size));
+    const auto reference{RandomVector(size)};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(layer.Backpropagate(reference));
+    }
+    SetThroughput(state, 1, 3.0 * size);
+}
+
+// Backpropagation of one sample from the next layer (hidden layer).
+void BM_LayerBackpropagateHidden(benchmark::State& state) {
+    const auto size{static_cast<std::size_t>(state.range(0))};
+    DenseLayer layer{size, size, ActFunc::kTanh};
+    DenseLayer next_layer{size, size, ActFunc::kTanh};
+    layer.Feedforward(RandomVector(size));
+    next_layer.Feedforward(layer.Output());
+    next_layer.Backpropagate(RandomVector(size));
+    for (auto _ : state) {
+        layer.Backpropagate(next_layer);
+        benchmark::DoNotOptimize(layer.Error().data());
+    }
+    SetThroughput(state, 1, 2.0 * size * size);
+}
+
+// Parameter update of one sample with stochastic gradient descent.
+void BM_LayerOptimize(benchmark::State& state) {
+    const auto size{static_cast<std::size_t>(state.range(0))};
+    DenseLayer layer{size, size, ActFunc::kTanh};
+    const auto input{RandomVector(size)};
+    layer.Feedforward(input);
+    layer.Backpropagate(RandomVector(size));
+    for (auto _ : state) {
+        layer.Optimize(input, 1e-9);
+        benchmark::ClobberMemory();
+    }
+    SetThroughput(state, 1, 2.0 * size * size);
+}
+
+// One training epoch of a network with two square hidden layers.
+void BM_NetworkTrainEpoch(benchmark::State& state) {
+    const auto size{static_cast<std::size_t>(state.range(0))};
+    const auto batch_size{static_cast<std::size_t>(state.range(1))};
+    NeuralNetwork network{size, std::vector<std::size_t>{size, size}, 1, ActFunc::kTanh,
+                          ActFunc::kTanh};
+    network.AddTrainingData(RandomMatrix(kNumSets, size), RandomMatrix(kNumSets, 1));
+    for (auto _ : state) {
+        network.Train(1, 1e-6, batch_size);
+        benchmark::ClobberMemory();
+    }
+    const auto num_weights{2.0 * size * size + size};
+    SetThroughput(state, kNumSets, 3 * 2.0 * num_weights);
+}
+
+// Prediction of one sample at a time.
+void BM_NetworkPredict(benchmark::State& state) {
+    const auto size{static_cast<std::size_t>(state.range(0))};
+    NeuralNetwork network{size, std::vector<std::size_t>{size, size}, 1, ActFunc::kTanh,
+                          ActFunc::kTanh};
+    const auto input{RandomVector(size)};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(network.Predict(input).data());
+    }
+    SetThroughput(state, 1, 2.0 * (2.0 * size * size + size));
+}
+
+// Prediction of a batch of samples in one pass over the weights.
+void BM_NetworkPredictBatch(benchmark::State& state) {
+    const auto size{static_cast<std::size_t>(state.range(0))};
+    NeuralNetwork network{size, std::vector<std::size_t>{size, size}, 1, ActFunc::kTanh,
+                          ActFunc::kTanh};
+    const auto input{RandomMatrix(kNumSets, size)};
+    Matrix<double> output{kNumSets, 1};
+    for (auto _ : state) {
+        network.PredictBatch(input.View(), output.View());
+        benchmark::ClobberMemory();
+    }
+    SetThroughput(state, kNumSets, 2.0 * (2.0 * size * size + size));
+}
+
+// Prediction with the 2-3-1 XOR network, dynamic (range 0) or static (range 1).
+void BM_XorPredict(benchmark::State& state) {
+    NeuralNetwork network{2, 3, 1, ActFunc::kTanh};
+    const StaticNeuralNetwork<ActFunc::kTanh, ActFunc::kRelu, 2, 3, 1> copy{network};
+    const std::vector<double> input{0, 1};
+    if (state.range(0) == 0) {
+        for (auto _ : state) { benchmark::DoNotOptimize(network.Predict(input).data()); }
+    } else {
+        for (auto _ : state) { benchmark::DoNotOptimize(copy.Predict({input[0], input[1]})); }
+    }
+    SetThroughput(state, 1, 2.0 * (2 * 3 + 3));
+}
+
+void SizeArguments(benchmark::internal::Benchmark* benchmark) {
+    for (const auto size : {16, 64, 256, 1024}) { benchmark->Args({size}); }
+    benchmark->ArgNames({"size"});
+}
+
+void TrainArguments(benchmark::internal::Benchmark* benchmark) {
+    for (const auto size : {16, 64, 256}) {
+        for (const auto batch_size : {1, 32}) { benchmark->Args({size, batch_size}); }
+    }
+    benchmark->ArgNames({"size", "batch"});
+}
+
+BENCHMARK(BM_LayerFeedforward)->Apply(SizeArguments);
+BENCHMARK(BM_LayerBackpropagateOutput)->Apply(SizeArguments);
+BENCHMARK(BM_LayerBackpropagateHidden)->Apply(SizeArguments);
+BENCHMARK(BM_LayerOptimize)->Apply(SizeArguments);
+BENCHMARK(BM_NetworkTrainEpoch)->Apply(TrainArguments)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_NetworkPredict)->Apply(SizeArguments);
+BENCHMARK(BM_NetworkPredictBatch)->Apply(SizeArguments)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_XorPredict)->ArgName("static")->Arg(0)->Arg(1);
+
+} /* namespace */
+
+BENCHMARK_MAIN();
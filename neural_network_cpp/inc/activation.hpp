@@ -0,0 +1,307 @@
+/********************************************************************************
+ * @brief Contains the activation functions of the dense layers. Each activation
+ *        function is a policy type, so that the layer kernels can be compiled
+ *        once per activation function instead of branching on every element.
+ ********************************************************************************/
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#include <fast_math.hpp>
+
+namespace yrgo {
+namespace machine_learning {
+
+/********************************************************************************
+ * @brief Enumeration for selecting activation function. The enumerators are
+ *        stored in model files, so new functions must be appended.
+ *
+ * @param kRelu      Enumerator for selecting ReLU (Rectified Linear Unit).
+ * @param kTanh      Enumerator for selecting Tanh (the hyperbolic tangent function).
+ * @param kSigmoid   Enumerator for selecting the logistic sigmoid function.
+ * @param kLeakyRelu Enumerator for selecting leaky ReLU (slope 0.01 for x < 0).
+ * @param kElu       Enumerator for selecting ELU (Exponential Linear Unit).
+ * @param kIdentity  Enumerator for selecting identity (linear) output.
+ * @param kSoftmax   Enumerator for selecting softmax, for output layers only.
+ *                   Training uses the gradient of the cross-entropy loss.
+ ********************************************************************************/
+enum class ActFunc { kRelu, kTanh, kSigmoid, kLeakyRelu, kElu, kIdentity, kSoftmax };
+
+namespace activation {
+
+/********************************************************************************
+ * @brief Indicates if specified value is a valid activation function, for
+ *        instance when read from a file.
+ ********************************************************************************/
+constexpr bool IsValid(const ActFunc act_func) {
+    return act_func >= ActFunc::kRelu && act_func <= ActFunc::kSoftmax;
+}
+
+/********************************************************************************
+ * @brief ReLU (Rectified Linear Unit) activation, i.e. y = max(x, 0).
+ ********************************************************************************/
+struct Relu {
+    static constexpr ActFunc kActFunc{ActFunc::kRelu};
+    static constexpr bool kElementwise{true};
+
+    /********************************************************************************
+     * @brief Provides the output of a node with specified weighted sum.
+     ********************************************************************************/
+    template <typename T>
+    static T Output(const T sum) { return sum > 0 ? sum : T{}; }
+
+    /********************************************************************************
+     * @brief Provides the derivative of the activation function, calculated from
+     *        the output of the node.
+     ********************************************************************************/
+    template <typename T>
+    static T Delta(const T output) { return output > 0 ? T{1} : T{}; }
+
+    /********************************************************************************
+     * @brief Replaces specified weighted sums with the corresponding outputs.
+     *        ReLU is exact, so the accuracy is ignored.
+     ********************************************************************************/
+    template <typename T>
+    static void Apply(T* sums, const std::size_t size, const fast_math::Accuracy) {
+        for (std::size_t i{}; i < size; ++i) { sums[i] = Output(sums[i]); }
+    }
+};
+
+/********************************************************************************
+ * @brief Hyperbolic tangent activation, i.e. y = tanh(x).
+ ********************************************************************************/
+struct Tanh {
+    static constexpr ActFunc kActFunc{ActFunc::kTanh};
+    static constexpr bool kElementwise{true};
+
+    /********************************************************************************
+     * @brief Provides the output of a node with specified weighted sum.
+     ********************************************************************************/
+    template <typename T>
+    static T Output(const T sum) { return std::tanh(sum); }
+
+    /********************************************************************************
+     * @brief Provides the derivative of the activation function, calculated from
+     *        the output of the node, i.e. 1 - y^2 (no tanh is evaluated).
+     ********************************************************************************/
+    template <typename T>
+    static T Delta(const T output) { return T{1} - output * output; }
+
+    /********************************************************************************
+     * @brief Replaces specified weighted sums with the corresponding outputs,
+     *        vectorized unless the exact accuracy tier is selected.
+     ********************************************************************************/
+    template <typename T>
+    static void Apply(T* sums, const std::size_t size, const fast_math::Accuracy accuracy) {
+        fast_math::Tanh(sums, size, accuracy);
+    }
+};
+
+/********************************************************************************
+ * @brief Logistic sigmoid activation, i.e. y = 1 / (1 + e^-x).
+ ********************************************************************************/
+struct Sigmoid {
+    static constexpr ActFunc kActFunc{ActFunc::kSigmoid};
+    static constexpr bool kElementwise{true};
+
+    /********************************************************************************
+     * @brief Provides the output of a node with specified weighted sum.
+     ********************************************************************************/
+    template <typename T>
+    static T Output(const T sum) { return T{1} / (T{1} + std::exp(-sum)); }
+
+    /********************************************************************************
+     * @brief Provides the derivative of the activation function, calculated from
+     *        the output of the node, i.e. y * (1 - y).
+     ********************************************************************************/
+    template <typename T>
+    static T Delta(const T output) { return output * (T{1} - output); }
+
+    /********************************************************************************
+     * @brief Replaces specified weighted sums with the corresponding outputs,
+     *        vectorized unless the exact accuracy tier is selected.
+     ********************************************************************************/
+    template <typename T>
+    static void Apply(T* sums, const std::size_t size, const fast_math::Accuracy accuracy) {
+        fast_math::Sigmoid(sums, size, accuracy);
+    }
+};
+
+/********************************************************************************
+ * @brief Leaky ReLU activation, i.e. y = x for x > 0, else y = 0.01x.
+ ********************************************************************************/
+struct LeakyRelu {
+    static constexpr ActFunc kActFunc{ActFunc::kLeakyRelu};
+    static constexpr bool kElementwise{true};
+    static constexpr double kSlope{0.01};
+
+    /********************************************************************************
+     * @brief Provides the output of a node with specified weighted sum.
+     ********************************************************************************/
+    template <typename T>
+    static T Output(const T sum) { return sum > 0 ? sum : static_cast<T>(kSlope) * sum; }
+
+    /********************************************************************************
+     * @brief Provides the derivative of the activation function, calculated from
+     *        the output of the node (the output has the same sign as the sum).
+     ********************************************************************************/
+    template <typename T>
+    static T Delta(const T output) { return output > 0 ? T{1} : static_cast<T>(kSlope); }
+
+    /********************************************************************************
+     * @brief Replaces specified weighted sums with the corresponding outputs.
+     *        Leaky ReLU is exact, so the accuracy is ignored.
+     ********************************************************************************/
+    template <typename T>
+    static void Apply(T* sums, const std::size_t size, const fast_math::Accuracy) {
+        for (std::size_t i{}; i < size; ++i) { sums[i] = Output(sums[i]); }
+    }
+};
+
+/********************************************************************************
+ * @brief ELU (Exponential Linear Unit) activation, i.e. y = x for x > 0, else
+ *        y = e^x - 1.
+ ********************************************************************************/
+struct Elu {
+    static constexpr ActFunc kActFunc{ActFunc::kElu};
+    static constexpr bool kElementwise{true};
+
+    /********************************************************************************
+     * @brief Provides the output of a node with specified weighted sum.
+     ********************************************************************************/
+    template <typename T>
+    static T Output(const T sum) { return sum > 0 ? sum : std::expm1(sum); }
+
+    /********************************************************************************
+     * @brief Provides the derivative of the activation function, calculated from
+     *        the output of the node, i.e. 1 for y > 0, else e^x = y + 1.
+     ********************************************************************************/
+    template <typename T>
+    static T Delta(const T output) { return output > 0 ? T{1} : output + T{1}; }
+
+    /********************************************************************************
+     * @brief Replaces specified weighted sums with the corresponding outputs,
+     *        vectorized unless the exact accuracy tier is selected.
+     ********************************************************************************/
+    template <typename T>
+    static void Apply(T* sums, const std::size_t size, const fast_math::Accuracy accuracy) {
+        fast_math::Elu(sums, size, accuracy);
+    }
+};
+
+/********************************************************************************
+ * @brief Identity activation, i.e. y = x, used for regression outputs.
+ ********************************************************************************/
+struct Identity {
+    static constexpr ActFunc kActFunc{ActFunc::kIdentity};
+    static constexpr bool kElementwise{true};
+
+    /********************************************************************************
+     * @brief Provides the output of a node with specified weighted sum.
+     ********************************************************************************/
+    template <typename T>
+    static T Output(const T sum) { return sum; }
+
+    /********************************************************************************
+     * @brief Provides the derivative of the activation function, always 1.
+     ********************************************************************************/
+    template <typename T>
+    static T Delta(const T) { return T{1}; }
+
+    /********************************************************************************
+     * @brief Leaves the weighted sums as they are.
+     ********************************************************************************/
+    template <typename T>
+    static void Apply(T*, const std::size_t, const fast_math::Accuracy) {}
+};
+
+/********************************************************************************
+ * @brief Softmax activation, i.e. y_i = e^x_i / sum(e^x_j), for output layers.
+ *        The output of each node depends on all weighted sums of the layer, so
+ *        there is no elementwise output function.
+ *
+ * @note Softmax is trained with the cross-entropy loss. The gradient of the loss
+ *       with respect to the weighted sums is then reference - output, so the
+ *       derivative is 1 and no Jacobian of the softmax is ever formed.
+ ********************************************************************************/
+struct Softmax {
+    static constexpr ActFunc kActFunc{ActFunc::kSoftmax};
+    static constexpr bool kElementwise{false};
+
+    /********************************************************************************
+     * @brief Provides the derivative used with the fused cross-entropy gradient.
+     ********************************************************************************/
+    template <typename T>
+    static T Delta(const T) { return T{1}; }
+
+    /********************************************************************************
+     * @brief Replaces specified weighted sums with the corresponding outputs. The
+     *        largest sum is subtracted first, so e^x never overflows.
+     ********************************************************************************/
+    template <typename T>
+    static void Apply(T* sums, const std::size_t size, const fast_math::Accuracy accuracy) {
+        if (size == 0) { return; }
+        const T max{*std::max_element(sums, sums + size)};
+        for (std::size_t i{}; i < size; ++i) { sums[i] -= max; }
+        fast_math::Exp(sums, size, accuracy);
+        T sum{};
+        for (std::size_t i{}; i < size; ++i) { sum += sums[i]; }
+        const T scale{T{1} / sum};
+        for (std::size_t i{}; i < size; ++i) { sums[i] *= scale; }
+    }
+};
+
+/********************************************************************************
+ * @brief Calls specified function with the policy type of specified activation
+ *        function. Used to select a specialized kernel once per layer instead of
+ *        branching on the activation function for every node.
+ *
+ * @param act_func The activation function.
+ * @param function The function to call, taking the policy as argument.
+ *
+ * @return The value returned by the function.
+ ********************************************************************************/
+template <typename Function>
+decltype(auto) Dispatch(const ActFunc act_func, Function&& function) {
+    switch (act_func) {
+        case ActFunc::kTanh:
+            return function(Tanh{});
+        case ActFunc::kSigmoid:
+            return function(Sigmoid{});
+        case ActFunc::kLeakyRelu:
+            return function(LeakyRelu{});
+        case ActFunc::kElu:
+            return function(Elu{});
+        case ActFunc::kIdentity:
+            return function(Identity{});
+        case ActFunc::kSoftmax:
+            return function(Softmax{});
+        default:
+            return function(Relu{});
+    }
+}
+
+/********************************************************************************
+ * @brief Provides the policy type of an activation function selected at compile
+ *        time, the compile-time counterpart of Dispatch.
+ *
+ * @tparam act_func The activation function.
+ ********************************************************************************/
+template <ActFunc act_func>
+struct PolicyOf { using Type = Relu; };
+
+template <> struct PolicyOf<ActFunc::kTanh> { using Type = Tanh; };
+template <> struct PolicyOf<ActFunc::kSigmoid> { using Type = Sigmoid; };
+template <> struct PolicyOf<ActFunc::kLeakyRelu> { using Type = LeakyRelu; };
+template <> struct PolicyOf<ActFunc::kElu> { using Type = Elu; };
+template <> struct PolicyOf<ActFunc::kIdentity> { using Type = Identity; };
+template <> struct PolicyOf<ActFunc::kSoftmax> { using Type = Softmax; };
+
+template <ActFunc act_func>
+using Policy = typename PolicyOf<act_func>::Type;
+
+} /* namespace activation */
+} /* namespace machine_learning */
+} /* namespace yrgo */
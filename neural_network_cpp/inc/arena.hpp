@@ -0,0 +1,133 @@
+/********************************************************************************
+ * @brief Contains an arena used for storing all buffers of a model in a single
+ *        cache line aligned slab of memory.
+ ********************************************************************************/
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <span>
+#include <type_traits>
+
+#include <utils.hpp>
+
+namespace yrgo {
+namespace machine_learning {
+
+/********************************************************************************
+ * @brief Arena allocating buffers from a single zero-initialized slab of memory.
+ *        Every buffer starts at a cache line boundary. Buffers are never freed
+ *        individually; the whole slab is released with the arena.
+ *
+ *        Since all buffers of a model are stored in one slab, the buffers are
+ *        kept close in memory (and on the same NUMA node), and snapshots and
+ *        copies of a model are made by copying the slab at once.
+ ********************************************************************************/
+class Arena {
+  public:
+
+    /********************************************************************************
+     * @brief Creates empty arena.
+     ********************************************************************************/
+    Arena(void) = default;
+
+    /********************************************************************************
+     * @brief Creates new arena holding specified number of bytes.
+     *
+     * @param size The size of the arena in bytes, see SizeOf.
+     ********************************************************************************/
+    explicit Arena(const std::size_t size) : data_(size) {}
+
+    /********************************************************************************
+     * @brief Provides the number of bytes an arena buffer holding specified
+     *        number of elements occupies, i.e. the size rounded up to a whole
+     *        number of cache lines.
+     *
+     * @tparam U The type of the elements.
+     *
+     * @param num_elements The number of elements of the buffer.
+     ********************************************************************************/
+    template <typename U>
+    static constexpr std::size_t SizeOf(const std::size_t num_elements) {
+        return utils::memory::PaddedSize<std::byte>(num_elements * sizeof(U));
+    }
+
+    /********************************************************************************
+     * @brief Allocates a zero-initialized buffer from the arena.
+     *
+     * @tparam U The type of the elements (must be trivially copyable).
+     *
+     * @param num_elements The number of elements of the buffer.
+     *
+     * @return A view of the allocated buffer.
+     *
+     * @throw std::bad_alloc if the arena doesn't have room for the buffer.
+     ********************************************************************************/
+    template <typename U>
+    std::span<U> Allocate(const std::size_t num_elements) {
+        static_assert(std::is_trivially_copyable_v<U>,
+            "Arena buffers must hold trivially copyable types!");
+        const auto size{SizeOf<U>(num_elements)};
+        if (size > data_.size() - used_) { throw std::bad_alloc{}; }
+        const auto data{reinterpret_cast<U*>(data_.data() + used_)};
+        used_ += size;
+        return {data, num_elements};
+    }
+
+    /********************************************************************************
+     * @brief Provides view of the buffer at the same position in this arena as
+     *        specified buffer has in another arena. Used for redirecting views
+     *        of the buffers of a copied arena to the copy.
+     *
+     * @tparam U The type of the elements.
+     *
+     * @param buffer View of the buffer allocated from the source arena.
+     * @param source Reference to the arena the buffer was allocated from.
+     *
+     * @return A view of the corresponding buffer of this arena.
+     ********************************************************************************/
+    template <typename U>
+    std::span<U> Rebase(const std::span<U> buffer, const Arena& source) {
+        const auto offset{reinterpret_cast<const std::byte*>(buffer.data()) - source.Data()};
+        return {reinterpret_cast<U*>(Data() + offset), buffer.size()};
+    }
+
+    /********************************************************************************
+     * @brief Copies the content of another arena of the same size.
+     *
+     * @param source Reference to the arena to copy.
+     *
+     * @return True if the content was copied, false if the sizes don't match.
+     ********************************************************************************/
+    bool CopyFrom(const Arena& source) {
+        if (source.Size() != Size()) { return false; }
+        std::copy(source.data_.begin(), source.data_.end(), data_.begin());
+        return true;
+    }
+
+    /********************************************************************************
+     * @brief Sets all bytes of the arena to zero.
+     ********************************************************************************/
+    void Clear(void) { std::fill(data_.begin(), data_.end(), std::byte{}); }
+
+    std::byte* Data(void) { return data_.data(); }
+    const std::byte* Data(void) const { return data_.data(); }
+
+    /********************************************************************************
+     * @brief Provides the size of the arena in bytes.
+     ********************************************************************************/
+    std::size_t Size(void) const { return data_.size(); }
+
+    /********************************************************************************
+     * @brief Provides the number of bytes allocated from the arena.
+     ********************************************************************************/
+    std::size_t Used(void) const { return used_; }
+
+  private:
+    utils::memory::AlignedVector<std::byte> data_{}; /* The slab holding all buffers. */
+    std::size_t used_{};                             /* Bytes allocated from the slab. */
+};
+
+} /* namespace machine_learning */
+} /* namespace yrgo */
@@ -0,0 +1,249 @@
+/********************************************************************************
+ * @brief Contains readers streaming training sets from files in chunks, so that
+ *        neural networks can be trained on datasets larger than the memory.
+ *
+ * @note Every reader provides the sets of the dataset in file order, one row per
+ *       set holding the inputs followed by the outputs. The training shuffles the
+ *       sets with a shuffle buffer, see BasicNeuralNetwork::Train.
+ ********************************************************************************/
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <matrix.hpp>
+
+namespace yrgo {
+namespace machine_learning {
+
+/********************************************************************************
+ * @brief Interface of readers providing the training sets of a dataset.
+ *
+ * @tparam T The type of the values provided (float or double).
+ ********************************************************************************/
+template <typename T>
+class DatasetReader {
+  public:
+
+    /********************************************************************************
+     * @brief Deletes the reader.
+     ********************************************************************************/
+    virtual ~DatasetReader(void) = default;
+
+    /********************************************************************************
+     * @brief Provides the number of inputs of each set.
+     ********************************************************************************/
+    virtual std::size_t NumInputs(void) const = 0;
+
+    /********************************************************************************
+     * @brief Provides the number of outputs of each set.
+     ********************************************************************************/
+    virtual std::size_t NumOutputs(void) const = 0;
+
+    /********************************************************************************
+     * @brief Reads the next sets of the dataset.
+     *
+     * @param input  View of the buffer to write the inputs to, one row per set and
+     *               one column per input.
+     * @param output View of the buffer to write the outputs to, one row per set and
+     *               one column per output.
+     *
+     * @return The number of sets read, which is less than the number of rows of
+     *         the buffers only at the end of the dataset (0 when the end has been
+     *         reached).
+     ********************************************************************************/
+    virtual std::size_t Read(const MatrixView<T>& input, const MatrixView<T>& output) = 0;
+
+    /********************************************************************************
+     * @brief Restarts reading from the first set of the dataset.
+     ********************************************************************************/
+    virtual void Rewind(void) = 0;
+};
+
+/********************************************************************************
+ * @brief Reads training sets from a CSV file, one set per line holding the
+ *        inputs followed by the outputs.
+ *
+ * @tparam T The type of the values provided (float or double).
+ ********************************************************************************/
+template <typename T>
+class CsvReader : public DatasetReader<T> {
+  public:
+
+    /********************************************************************************
+     * @brief Opens specified CSV file.
+     *
+     * @param path        The path of the file.
+     * @param num_inputs  The number of inputs of each set.
+     * @param num_outputs The number of outputs of each set.
+     * @param has_header  Indicates if the first line is a header to skip.
+     * @param delimiter   The character separating the values (default = ',').
+     *
+     * @throw std::runtime_error if the file cannot be opened.
+     ********************************************************************************/
+    CsvReader(const std::string& path, const std::size_t num_inputs,
+              const std::size_t num_outputs, const bool has_header = false,
+              const char delimiter = ',');
+
+    std::size_t NumInputs(void) const override { return num_inputs_; }
+    std::size_t NumOutputs(void) const override { return num_outputs_; }
+
+    /********************************************************************************
+     * @brief Reads the next sets of the dataset, see DatasetReader::Read. Empty
+     *        lines are skipped.
+     *
+     * @throw std::runtime_error if a line doesn't hold the expected number of
+     *        numeric values.
+     ********************************************************************************/
+    std::size_t Read(const MatrixView<T>& input, const MatrixView<T>& output) override;
+
+    void Rewind(void) override;
+
+  private:
+    std::ifstream file_{};      /* The file to read from. */
+    std::string path_{};        /* The path of the file (for error messages). */
+    std::string line_{};        /* The current line (reused between reads). */
+    std::vector<T> values_{};   /* The values of the current line. */
+    std::size_t num_inputs_{};  /* The number of inputs of each set. */
+    std::size_t num_outputs_{}; /* The number of outputs of each set. */
+    std::size_t line_number_{}; /* The number of lines read (for error messages). */
+    bool has_header_{};         /* Indicates if the first line is a header. */
+    char delimiter_{};          /* The character separating the values. */
+};
+
+/********************************************************************************
+ * @brief Enumeration of the value types of raw binary dataset files.
+ ********************************************************************************/
+enum class BinaryFormat { kFloat32, kFloat64 };
+
+/********************************************************************************
+ * @brief Reads training sets from a raw binary file of float32 or float64 values
+ *        (native byte order) stored row-major without any header, one row per
+ *        set holding the inputs followed by the outputs.
+ *
+ * @tparam T The type of the values provided (float or double).
+ ********************************************************************************/
+template <typename T>
+class BinaryReader : public DatasetReader<T> {
+  public:
+
+    /********************************************************************************
+     * @brief Opens specified binary file.
+     *
+     * @param path        The path of the file.
+     * @param num_inputs  The number of inputs of each set.
+     * @param num_outputs The number of outputs of each set.
+     * @param format      The value type of the file (default = float32).
+     *
+     * @throw std::runtime_error if the file cannot be opened or its size isn't a
+     *        multiple of the size of one set.
+     ********************************************************************************/
+    BinaryReader(const std::string& path, const std::size_t num_inputs,
+                 const std::size_t num_outputs,
+                 const BinaryFormat format = BinaryFormat::kFloat32);
+
+    std::size_t NumInputs(void) const override { return num_inputs_; }
+    std::size_t NumOutputs(void) const override { return num_outputs_; }
+
+    /********************************************************************************
+     * @brief Provides the number of sets in the file.
+     ********************************************************************************/
+    std::size_t NumSets(void) const { return num_sets_; }
+
+    std::size_t Read(const MatrixView<T>& input, const MatrixView<T>& output) override;
+    void Rewind(void) override;
+
+  private:
+    std::ifstream file_{};       /* The file to read from. */
+    std::vector<char> buffer_{}; /* The raw bytes of the sets being read. */
+    std::size_t num_inputs_{};   /* The number of inputs of each set. */
+    std::size_t num_outputs_{};  /* The number of outputs of each set. */
+    std::size_t num_sets_{};     /* The number of sets in the file. */
+    std::size_t next_set_{};     /* Index of the next set to read. */
+    BinaryFormat format_{};      /* The value type of the file. */
+};
+
+/********************************************************************************
+ * @brief Reader wrapping another reader, which reads the next chunk of sets on a
+ *        background thread while the current chunk is consumed. I/O and parsing
+ *        thereby overlap with the training.
+ *
+ * @note The background thread is started once by the constructor and then 
+ *       reused for every chunk, so reading doesn't allocate memory.
+ *
+ * @tparam T The type of the values provided (float or double).
+ ********************************************************************************/
+template <typename T>
+class PrefetchReader : public DatasetReader<T> {
+  public:
+
+    /********************************************************************************
+     * @brief Creates prefetching reader and starts its background thread. No 
+     *        sets are read until the first read.
+     *
+     * @param source     Reference to the reader to read from, which must outlive
+     *                   this reader and must not be used directly meanwhile.
+     * @param chunk_size The number of sets per chunk (default = 4096).
+     ********************************************************************************/
+    explicit PrefetchReader(DatasetReader<T>& source, const std::size_t chunk_size = 4096);
+
+    /********************************************************************************
+     * @brief Waits for any pending read and stops the background thread before 
+     *        deleting the reader.
+     ********************************************************************************/
+    ~PrefetchReader(void) override;
+
+    PrefetchReader(const PrefetchReader&) = delete;
+    PrefetchReader& operator=(const PrefetchReader&) = delete;
+
+    std::size_t NumInputs(void) const override { return source_.NumInputs(); }
+    std::size_t NumOutputs(void) const override { return source_.NumOutputs(); }
+
+    /********************************************************************************
+     * @brief Reads the next sets of the dataset, see DatasetReader::Read.
+     *        Exceptions thrown by the source reader are rethrown here.
+     ********************************************************************************/
+    std::size_t Read(const MatrixView<T>& input, const MatrixView<T>& output) override;
+
+    void Rewind(void) override;
+
+  private:
+    struct Chunk {
+        Matrix<T> input{};      /* The inputs of the chunk. */
+        Matrix<T> output{};     /* The outputs of the chunk. */
+        std::size_t size{};     /* The number of sets in the chunk. */
+        std::size_t position{}; /* Index of the next set to consume. */
+    };
+
+    void Fetch(void);
+    std::size_t Wait(void);
+    void Run(void);
+
+    DatasetReader<T>& source_;            /* The reader to read from. */
+    Chunk chunks_[2]{};                   /* The consumed and the prefetched chunk. */
+    std::size_t current_{};               /* Index of the consumed chunk. */
+    std::size_t fetched_size_{};          /* Size of the chunk last prefetched. */
+    std::exception_ptr error_{};          /* Exception thrown by the last prefetch. */
+    bool pending_{};                      /* Indicates if a prefetch hasn't been waited for. */
+    bool requested_{};                    /* Indicates if the thread is to prefetch. */
+    bool stopped_{};                      /* Indicates if the thread is to stop. */
+    std::mutex mutex_{};                  /* Protects the state shared with the thread. */
+    std::condition_variable condition_{}; /* Signals requests and finished prefetches. */
+    std::thread thread_{};                /* The thread prefetching the chunks. */
+};
+
+extern template class CsvReader<double>;
+extern template class CsvReader<float>;
+extern template class BinaryReader<double>;
+extern template class BinaryReader<float>;
+extern template class PrefetchReader<double>;
+extern template class PrefetchReader<float>;
+
+} /* namespace machine_learning */
+} /* namespace yrgo */
@@ -0,0 +1,169 @@
+/********************************************************************************
+ * @brief Contains the binary dataset file format used for storing training sets
+ *        without any parsing, and a dataset using the sets directly from the
+ *        memory-mapped file.
+ *
+ * @note The file layout is as follows (native byte order):
+ *       - One FileHeader.
+ *       - The input block, holding the inputs of every set.
+ *       - The optional output block, holding the outputs (labels) of every set.
+ *       Each block starts at a cache line boundary and is stored row-major, one
+ *       row per set, with the same padded stride as Matrix. The mapped blocks
+ *       can therefore be used as matrix views as is.
+ ********************************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+#include <dataset.hpp>
+#include <matrix.hpp>
+
+namespace yrgo {
+namespace machine_learning {
+namespace dataset_file {
+
+/********************************************************************************
+ * @brief Identifies dataset files, stored in the beginning of every file.
+ ********************************************************************************/
+constexpr char kMagic[8]{'Y', 'R', 'G', 'O', 'D', 'S', '\0', '\0'};
+
+/********************************************************************************
+ * @brief The version of the file format. Incremented upon every change of the
+ *        layout, files of other versions are rejected.
+ ********************************************************************************/
+constexpr std::uint32_t kVersion{1};
+
+/********************************************************************************
+ * @brief Enumeration of the value types the sets can be stored with.
+ ********************************************************************************/
+enum class ValueType : std::uint32_t { kDouble, kFloat };
+
+/********************************************************************************
+ * @brief Provides the file format identifier of value type T.
+ ********************************************************************************/
+template <typename T>
+constexpr ValueType ValueTypeOf(void) {
+    if constexpr (std::is_same_v<T, double>) {
+        return ValueType::kDouble;
+    } else {
+        static_assert(std::is_same_v<T, float>, "Unsupported value type!");
+        return ValueType::kFloat;
+    }
+}
+
+/********************************************************************************
+ * @brief Header stored in the beginning of every dataset file. Offsets are
+ *        counted in bytes from the beginning of the file, strides in values.
+ ********************************************************************************/
+struct FileHeader {
+    char magic[8]{};               /* Always kMagic. */
+    std::uint32_t version{};       /* Version of the file format. */
+    ValueType value_type{};        /* Value type of the sets. */
+    std::uint64_t num_sets{};      /* The number of sets. */
+    std::uint64_t num_inputs{};    /* The number of inputs of each set. */
+    std::uint64_t num_outputs{};   /* The number of outputs of each set (0 = no outputs). */
+    std::uint64_t input_stride{};  /* Distance in values between two input rows. */
+    std::uint64_t output_stride{}; /* Distance in values between two output rows. */
+    std::uint64_t input_offset{};  /* Offset of the input block. */
+    std::uint64_t output_offset{}; /* Offset of the output block (0 = no outputs). */
+    std::uint64_t file_size{};     /* The total size of the file in bytes. */
+};
+
+/********************************************************************************
+ * @brief Saves specified training sets to a dataset file.
+ *
+ * @tparam T The value type of the sets (float or double).
+ *
+ * @param input  View of the input sets, one row per set and one column per input.
+ * @param output View of the output sets, one row per set and one column per
+ *               output. Pass an empty view to save the inputs only.
+ * @param path   The path of the file to create (overwritten if it exists).
+ *
+ * @return True if the file was written, false if the number of output sets
+ *         doesn't match the number of input sets or if the file couldn't be
+ *         written.
+ ********************************************************************************/
+template <typename T>
+bool Save(const MatrixView<const T>& input, const MatrixView<const T>& output,
+          const std::string& path);
+
+} /* namespace dataset_file */
+
+/********************************************************************************
+ * @brief Read-only dataset backed by a memory-mapped dataset file. The sets are
+ *        used directly from the mapped pages without parsing or copying, so any
+ *        set can be accessed at random. Pass the views of the dataset to
+ *        BasicNeuralNetwork::AddTrainingData to train on the mapped sets; the
+ *        shuffled sets are then read straight from the page cache.
+ *
+ * @tparam T The value type of the sets, which must match the file.
+ ********************************************************************************/
+template <typename T>
+class MappedDataset : public DatasetReader<T> {
+  public:
+
+    /********************************************************************************
+     * @brief Default constructor deleted.
+     ********************************************************************************/
+    MappedDataset(void) = delete;
+
+    /********************************************************************************
+     * @brief Maps specified dataset file into memory.
+     *
+     * @param path The path of the dataset file.
+     *
+     * @throw std::runtime_error if the file cannot be mapped or isn't a valid
+     *        dataset file with values of type T.
+     ********************************************************************************/
+    explicit MappedDataset(const std::string& path);
+
+    MappedDataset(const MappedDataset&) = delete;
+    MappedDataset& operator=(const MappedDataset&) = delete;
+
+    /********************************************************************************
+     * @brief Unmaps the dataset file.
+     ********************************************************************************/
+    ~MappedDataset(void) override;
+
+    /********************************************************************************
+     * @brief Provides the number of sets in the dataset.
+     ********************************************************************************/
+    std::size_t NumSets(void) const { return input_.NumRows(); }
+
+    std::size_t NumInputs(void) const override { return input_.NumColumns(); }
+    std::size_t NumOutputs(void) const override { return output_.NumColumns(); }
+
+    /********************************************************************************
+     * @brief Provides view of the mapped input sets, one row per set. The view is
+     *        valid for the lifetime of the dataset.
+     ********************************************************************************/
+    const MatrixView<const T>& Inputs(void) const { return input_; }
+
+    /********************************************************************************
+     * @brief Provides view of the mapped output sets, one row per set. The view is
+     *        empty if the file holds no outputs.
+     ********************************************************************************/
+    const MatrixView<const T>& Outputs(void) const { return output_; }
+
+    /********************************************************************************
+     * @brief Copies the next sets of the dataset, see DatasetReader::Read.
+     ********************************************************************************/
+    std::size_t Read(const MatrixView<T>& input, const MatrixView<T>& output) override;
+
+    void Rewind(void) override { next_set_ = 0; }
+
+  private:
+    void* data_{nullptr};          /* Start of the mapped file. */
+    std::size_t size_{};           /* Size of the mapped file. */
+    MatrixView<const T> input_{};  /* View of the mapped input block. */
+    MatrixView<const T> output_{}; /* View of the mapped output block. */
+    std::size_t next_set_{};       /* Index of the next set to read. */
+};
+
+extern template class MappedDataset<double>;
+extern template class MappedDataset<float>;
+
+} /* namespace machine_learning */
+} /* namespace yrgo */
@@ -3,27 +3,48 @@
  ********************************************************************************/
 #pragma once
 
+#include <span>
 #include <vector>
+#include <activation.hpp>
+#include <arena.hpp>
+#include <instrumentation.hpp>
+#include <matrix.hpp>
+#include <optimizer.hpp>
+#include <scalar.hpp>
+#include <training.hpp>
 #include <utils.hpp>
 
 namespace yrgo {
 namespace machine_learning {
 
+template <typename T>
+class BasicNeuralNetwork;
+
 /********************************************************************************
- * @brief Enumeration for selecting activation function between ReLU and tanH.
+ * @brief Dense layer whose weights are stored with scalar type T. Output values,
+ *        errors, bias values and gradients are stored with the compute type of
+ *        T, which is T itself for float and double and float for BFloat16.
+ *
+ *        The weights, bias values, output values, errors and optimizer state
+ *        are allocated from one arena (see Arena). A layer of a network uses 
+ *        the arena of the network, holding the buffers of all its layers; 
+ *        other layers, including copies, own an arena of their own.
  *
- * @param kRelu Enumerator for selecting ReLU (Rectified Linear Unit)-
- * @param kTanh Enumerator for selecting Tanh (the hyperbolic tangent function).
+ * @tparam T The scalar type of the weights (double, float or BFloat16).
  ********************************************************************************/
-enum class ActFunc { kRelu, kTanh };
-
-class DenseLayer {
+template <typename T>
+class BasicDenseLayer {
   public:
+
+    /********************************************************************************
+     * @brief The type used for arithmetic, activations, errors and gradients.
+     ********************************************************************************/
+    using Compute = ComputeType<T>;
   
     /********************************************************************************
      * @brief Default constructor deleted.
      ********************************************************************************/
-    DenseLayer(void) = delete;
+    BasicDenseLayer(void) = delete;
 
     /********************************************************************************
      * @brief Creates new dense layer with specified number of nodes and weights.
@@ -32,39 +53,179 @@ class DenseLayer {
      * @param num_weights_per_node The number of weights per node in the layer.
      * @param act_func             Activation function (default = ReLU).
      ********************************************************************************/
-    DenseLayer(const std::size_t num_nodes, 
-               const std::size_t num_weights_per_node,
-               const enum ActFunc act_func = ActFunc::kRelu);
+    BasicDenseLayer(const std::size_t num_nodes, 
+                    const std::size_t num_weights_per_node,
+                    const enum ActFunc act_func = ActFunc::kRelu);
 
     /********************************************************************************
      * @brief Provides the output values of the dense layer.
      * 
-     * @return A reference to vector holding the output values.
+     * @return A view of the output values, one per node.
      ********************************************************************************/
-    const std::vector<double>& Output(void) const { return this->output_; }
+    std::span<const Compute> Output(void) const { return buffers_.output; }
 
     /********************************************************************************
      * @brief Provides the number of nodes in the dense layer.
      * 
      * @return The number of nodes in the layer.
      ********************************************************************************/
-    std::size_t NumNodes(void) const { return output_.size(); }
+    std::size_t NumNodes(void) const { return buffers_.output.size(); }
 
     /********************************************************************************
      * @brief Provides the number of weights per node in the dense layer.
      * 
      * @return The number of weights per node in the layer.
      ********************************************************************************/
-    std::size_t NumWeightsPerNode(void) const { 
-        return weights_.size() > 0 ? weights_[0].size() : 0;
+    std::size_t NumWeightsPerNode(void) const { return num_weights_per_node_; }
+
+    /********************************************************************************
+     * @brief Provides the activation function of the dense layer.
+     * 
+     * @return The selected activation function.
+     ********************************************************************************/
+    enum ActFunc ActivationFunction(void) const { return act_func_; }
+
+    /********************************************************************************
+     * @brief Provides the accuracy tier used for calculating the activations.
+     * 
+     * @return The selected accuracy tier (exact by default).
+     ********************************************************************************/
+    fast_math::Accuracy ActivationAccuracy(void) const { return accuracy_; }
+
+    /********************************************************************************
+     * @brief Selects the accuracy tier used for calculating the activations. The
+     *        approximate tiers evaluate tanh vectorized over whole rows, trading
+     *        a small error (see fast_math::Accuracy) for speed.
+     * 
+     * @param accuracy The accuracy tier to use.
+     ********************************************************************************/
+    void SetActivationAccuracy(const fast_math::Accuracy accuracy) { accuracy_ = accuracy; }
+
+    /********************************************************************************
+     * @brief Provides the optimizer used for adjusting bias and weights.
+     * 
+     * @return Reference to the optimizer configuration (SGD by default).
+     ********************************************************************************/
+    const OptimizerConfig& Optimizer(void) const { return optimizer_; }
+
+    /********************************************************************************
+     * @brief Selects the optimizer used for adjusting bias and weights. The state
+     *        of the optimizer (if any) is allocated with the same layout as the
+     *        weights and bias and is reset to zero.
+     * 
+     * @param optimizer The optimizer and its hyperparameters.
+     ********************************************************************************/
+    void SetOptimizer(const OptimizerConfig& optimizer);
+
+    /********************************************************************************
+     * @brief Provides the distance (in elements) between the first weight of two
+     *        adjacent nodes. Each row is padded to a whole number of cache lines.
+     * 
+     * @return The stride of the weight matrix.
+     ********************************************************************************/
+    std::size_t WeightStride(void) const { return weight_stride_; }
+
+    /********************************************************************************
+     * @brief Provides the weights of specified node.
+     * 
+     * @param node Index of the node.
+     * 
+     * @return A view of the weights of the node (padding excluded).
+     ********************************************************************************/
+    std::span<const T> Weights(const std::size_t node) const { 
+        return {buffers_.weights.data() + node * weight_stride_, num_weights_per_node_};
+    }
+
+    /********************************************************************************
+     * @brief Provides the weights of specified node.
+     * 
+     * @param node Index of the node.
+     * 
+     * @return A mutable view of the weights of the node (padding excluded).
+     ********************************************************************************/
+    std::span<T> Weights(const std::size_t node) { 
+        return {buffers_.weights.data() + node * weight_stride_, num_weights_per_node_};
     }
+
+    /********************************************************************************
+     * @brief Provides the whole weight matrix, stored row-major with one row per
+     *        node and a row length of WeightStride() elements.
+     * 
+     * @return A view of the weight matrix (padding included).
+     ********************************************************************************/
+    std::span<const T> WeightMatrix(void) const { return buffers_.weights; }
+
+    /********************************************************************************
+     * @brief Provides the bias values of the dense layer.
+     * 
+     * @return A view of the bias values, one per node.
+     ********************************************************************************/
+    std::span<const Compute> Bias(void) const { return buffers_.bias; }
+
+    /********************************************************************************
+     * @brief Provides the bias values of the dense layer.
+     * 
+     * @return A mutable view of the bias values, one per node.
+     ********************************************************************************/
+    std::span<Compute> Bias(void) { return buffers_.bias; }
+
+    /********************************************************************************
+     * @brief Provides the errors calculated during the last backpropagation.
+     * 
+     * @return A view of the errors, one per node.
+     ********************************************************************************/
+    std::span<const Compute> Error(void) const { return buffers_.error; }
+
+    /********************************************************************************
+     * @brief Provides the number of floating-point operations performed by the
+     *        layer since the last reset. Only counted if the instrumentation is
+     *        enabled, see instrumentation.hpp.
+     * 
+     * @return The number of floating-point operations (2 per multiply-add).
+     ********************************************************************************/
+    std::uint64_t NumFlops(void) const { return flops_.Value(); }
+
+    /********************************************************************************
+     * @brief Resets the number of floating-point operations of the layer.
+     ********************************************************************************/
+    void ResetFlops(void) { flops_.Reset(); }
     
+    /********************************************************************************
+     * @brief Updates the output of all nodes in the layer.
+     * 
+     * @param inputs View of the new input values.
+     ********************************************************************************/
+    void Feedforward(const std::span<const Compute> inputs);
+
     /********************************************************************************
      * @brief Updates the output of all nodes in the layer.
      * 
      * @param inputs Reference to vector holding the new input values.
      ********************************************************************************/
-    void Feedforward(const std::vector<double>& inputs);
+    void Feedforward(const std::vector<Compute>& inputs) { 
+        Feedforward(std::span<const Compute>{inputs}); 
+    }
+
+    /********************************************************************************
+     * @brief Calculates the output of all nodes in the layer without modifying the
+     *        layer, which makes it possible to share the layer between threads.
+     * 
+     * @param inputs View of the input values.
+     * @param output View of the buffer to write the output values to (one per node).
+     ********************************************************************************/
+    void Feedforward(const std::span<const Compute> inputs, const std::span<Compute> output) const;
+
+    /********************************************************************************
+     * @brief Calculates current errors in output layer by comparing the output
+     *        values with corresponding reference values.
+     * 
+     * @note This function is for output layers only.
+     * 
+     * @param reference View of the reference values.
+     * 
+     * @return The loss of the output values, see training::Loss.
+     ********************************************************************************/
+    double Backpropagate(const std::span<const Compute> reference);
 
     /********************************************************************************
      * @brief Calculates current errors in output layer by comparing the output
@@ -73,8 +234,12 @@ class DenseLayer {
      * @note This function is for output layers only.
      * 
      * @param reference Reference to vector holding the reference values.
+     * 
+     * @return The loss of the output values, see training::Loss.
      ********************************************************************************/
-    void Backpropagate(const std::vector<double>& reference);
+    double Backpropagate(const std::vector<Compute>& reference) {
+        return Backpropagate(std::span<const Compute>{reference});
+    }
 
     /********************************************************************************
      * @brief Calculates current error in hidden layer by using the errors and
@@ -84,7 +249,15 @@ class DenseLayer {
      * 
      * @param next_layer Reference to next layer (holds errors and weights we need).
      ********************************************************************************/
-    void Backpropagate(const DenseLayer& next_layer);
+    void Backpropagate(const BasicDenseLayer& next_layer);
+
+    /********************************************************************************
+     * @brief Adjusts bias och weights in the dense layer to increase the precision.
+     * 
+     * @param inputs View of the input values (for adjusting weights).
+     * @param learning_rate The amount of adjustment (default = 1 %).
+     ********************************************************************************/
+    void Optimize(const std::span<const Compute> inputs, const Compute learning_rate = 0.01);
 
     /********************************************************************************
      * @brief Adjusts bias och weights in the dense layer to increase the precision.
@@ -92,15 +265,212 @@ class DenseLayer {
      * @param inputs Reference to vector holding input values (for adjusting weights).
      * @param learning_rate The amount of adjustment (default = 1 %).
      ********************************************************************************/
-    void Optimize(const std::vector<double>& inputs, const double learning_rate = 0.01);
+    void Optimize(const std::vector<Compute>& inputs, const Compute learning_rate = 0.01) {
+        Optimize(std::span<const Compute>{inputs}, learning_rate);
+    }
+
+    /********************************************************************************
+     * @brief Adjusts bias och weights in the dense layer with specified update step.
+     *        Used by networks, which count the updates of all layers, instead of 
+     *        the update count of the layer itself.
+     * 
+     * @param inputs View of the input values (for adjusting weights).
+     * @param step   The learning rate and the update count (the scale is ignored).
+     ********************************************************************************/
+    void Optimize(const std::span<const Compute> inputs, const optimizer::UpdateStep& step);
+
+    /********************************************************************************
+     * @brief Provides the output values of the dense layer for the last batch.
+     * 
+     * @return A view of the batch output, one row per sample and one column per node.
+     ********************************************************************************/
+    MatrixView<const Compute> BatchOutput(void) const { return batch_output_.View(); }
+
+    /********************************************************************************
+     * @brief Updates the output of all nodes in the layer for a batch of samples.
+     * 
+     * @param inputs View of the input values, one row per sample.
+     ********************************************************************************/
+    void FeedforwardBatch(const MatrixView<const Compute>& inputs);
+
+    /********************************************************************************
+     * @brief Calculates the output of all nodes in the layer for a batch of samples
+     *        without modifying the layer.
+     * 
+     * @param inputs View of the input values, one row per sample.
+     * @param output View of the buffer to write the output values to, one row per 
+     *               sample and one column per node.
+     ********************************************************************************/
+    void FeedforwardBatch(const MatrixView<const Compute>& inputs, 
+                          const MatrixView<Compute>& output) const;
+
+    /********************************************************************************
+     * @brief Calculates current errors in output layer for the last batch by 
+     *        comparing the batch output with corresponding reference values.
+     * 
+     * @note This function is for output layers only.
+     * 
+     * @param reference View of the reference values, one row per sample.
+     * 
+     * @return The sum of the losses of the samples, see training::Loss.
+     ********************************************************************************/
+    double BackpropagateBatch(const MatrixView<const Compute>& reference);
+
+    /********************************************************************************
+     * @brief Calculates current errors in hidden layer for the last batch by using
+     *        the batch errors and weights in the next layer.
+     * 
+     * @note This function is for hidden layers only.
+     * 
+     * @param next_layer Reference to next layer (holds errors and weights we need).
+     ********************************************************************************/
+    void BackpropagateBatch(const BasicDenseLayer& next_layer);
+
+    /********************************************************************************
+     * @brief Accumulates the gradients of the whole batch and adjusts bias and 
+     *        weights once with the average gradient.
+     * 
+     * @param inputs View of the input values used for the last batch.
+     * @param learning_rate The amount of adjustment (default = 1 %).
+     ********************************************************************************/
+    void OptimizeBatch(const MatrixView<const Compute>& inputs, 
+                       const Compute learning_rate = 0.01);
+
+    /********************************************************************************
+     * @brief Calculates the errors of an output layer for a batch without modifying
+     *        the layer, which makes it possible to share the layer between threads.
+     * 
+     * @param output    View of the batch output of the layer.
+     * @param reference View of the reference values, one row per sample.
+     * @param error     View of the buffer to write the errors to.
+     * 
+     * @return The sum of the losses of the samples, see training::Loss.
+     ********************************************************************************/
+    double BackpropagateBatch(const MatrixView<const Compute>& output,
+                              const MatrixView<const Compute>& reference,
+                              const MatrixView<Compute>& error) const;
+
+    /********************************************************************************
+     * @brief Calculates the errors of a hidden layer for a batch without modifying
+     *        the layer, which makes it possible to share the layer between threads.
+     * 
+     * @param output     View of the batch output of the layer.
+     * @param next_layer Reference to next layer (holds the weights we need).
+     * @param next_error View of the batch errors of the next layer.
+     * @param error      View of the buffer to write the errors to.
+     ********************************************************************************/
+    void BackpropagateBatch(const MatrixView<const Compute>& output,
+                            const BasicDenseLayer& next_layer,
+                            const MatrixView<const Compute>& next_error,
+                            const MatrixView<Compute>& error) const;
+
+    /********************************************************************************
+     * @brief Adds the gradients of a batch to specified buffers without modifying 
+     *        the layer. The gradients are summed, not averaged.
+     * 
+     * @param inputs          View of the input values used for the batch.
+     * @param error           View of the errors calculated for the batch.
+     * @param weight_gradient View of the weight gradients to add to, one row per node.
+     * @param bias_gradient   View of the bias gradients to add to, one per node.
+     ********************************************************************************/
+    void AccumulateGradients(const MatrixView<const Compute>& inputs,
+                             const MatrixView<const Compute>& error,
+                             const MatrixView<Compute>& weight_gradient,
+                             const std::span<Compute> bias_gradient) const;
+
+    /********************************************************************************
+     * @brief Adjusts bias and weights of specified nodes with accumulated gradients
+     *        by using the selected optimizer. Different threads may update disjoint
+     *        ranges of nodes concurrently.
+     * 
+     * @param weight_gradient View of the weight gradients, one row per node.
+     * @param bias_gradient   View of the bias gradients, one per node.
+     * @param step            Description of the update, holding the learning rate,
+     *                        the factor to scale the gradients with (typically one
+     *                        divided by the number of samples) and the update count.
+     * @param first_node      Index of the first node to adjust (default = 0).
+     * @param num_nodes       The number of nodes to adjust (default = all nodes).
+     ********************************************************************************/
+    void ApplyGradients(const MatrixView<const Compute>& weight_gradient,
+                        const std::span<const Compute> bias_gradient,
+                        const optimizer::UpdateStep& step,
+                        const std::size_t first_node = 0,
+                        const std::size_t num_nodes = static_cast<std::size_t>(-1));
 
   private:
-    std::vector<double> output_{};               /* Holds output values. */
-    std::vector<double> bias_{};                 /* Holds bias values. */
-    std::vector<double> error_{};                /* Holds calculated errors. */
-    std::vector<std::vector<double>> weights_{}; /* Holds weights for all nodes. */
-    enum ActFunc act_func_{ActFunc::kRelu};      /* Selected activation function. */
+    friend class BasicNeuralNetwork<T>;
+
+    /********************************************************************************
+     * @brief Holds views of the buffers of the layer and, unless the buffers are
+     *        allocated from the arena of a network, the arena holding them. 
+     *        Copies always allocate their own arena, while assignments between
+     *        buffers of the same size copy the values in place.
+     ********************************************************************************/
+    struct Buffers {
+        Buffers(void) = default;
+        Buffers(const std::size_t num_nodes, const std::size_t num_weights, 
+                const std::size_t num_state_buffers);
+        Buffers(const Buffers& source, Arena& storage);
+        Buffers(const Buffers& source);
+        Buffers(Buffers&&) = default;
+        Buffers& operator=(const Buffers& source);
+        Buffers& operator=(Buffers&&) = default;
+
+        static std::size_t Size(const std::size_t num_nodes, const std::size_t num_weights, 
+                                const std::size_t num_state_buffers);
+        std::size_t Size(void) const;
+        std::size_t NumStateBuffers(void) const;
+        void Allocate(Arena& storage, const std::size_t num_nodes, 
+                      const std::size_t num_weights, const std::size_t num_state_buffers);
+        void CopyFrom(const Buffers& source);
+        void Rebase(const Buffers& buffers, const Arena& source, Arena& storage);
+
+        Arena arena{};                      /* Arena owned by the layer (if any). */
+        std::span<T> weights{};             /* Weights, one padded row per node. */
+        std::span<Compute> bias{};          /* Bias values. */
+        std::span<Compute> output{};        /* Output values. */
+        std::span<Compute> error{};         /* Calculated errors. */
+        std::span<Compute> weight_state{};  /* Optimizer state of the weights. */
+        std::span<Compute> bias_state{};    /* Optimizer state of the bias values. */
+    };
+
+    BasicDenseLayer(const BasicDenseLayer& source, const Arena& source_arena, Arena& arena);
+
+    MatrixView<const T> WeightView(void) const {
+        return {buffers_.weights.data(), NumNodes(), num_weights_per_node_, weight_stride_};
+    }
+
+    Compute* WeightState(const std::size_t node) {
+        return buffers_.weight_state.empty() ? 
+            nullptr : buffers_.weight_state.data() + node * weight_stride_;
+    }
+
+    Compute* BiasState(const std::size_t node) {
+        return buffers_.bias_state.empty() ? nullptr : buffers_.bias_state.data() + node;
+    }
+
+    Buffers buffers_{};                         /* Weights, bias, outputs, errors and state. */
+    std::size_t num_weights_per_node_{};        /* Number of weights per node. */
+    std::size_t weight_stride_{};               /* Padded length of each row. */
+    enum ActFunc act_func_{ActFunc::kRelu};     /* Selected activation function. */
+    fast_math::Accuracy accuracy_{};            /* Accuracy of the activations. */
+    Matrix<Compute> batch_output_{};            /* Holds output values of last batch. */
+    Matrix<Compute> batch_error_{};             /* Holds errors of last batch. */
+    Matrix<Compute> weight_gradient_{};         /* Holds accumulated weight gradients. */
+    std::vector<Compute> bias_gradient_{};      /* Holds accumulated bias gradients. */
+    OptimizerConfig optimizer_{};               /* Selected optimizer. */
+    std::size_t num_updates_{};                 /* Number of updates of a standalone layer. */
+    mutable instrumentation::Counter flops_{};  /* Floating-point operations. */
 };
 
+/********************************************************************************
+ * @brief Dense layer with double precision (the default).
+ ********************************************************************************/
+using DenseLayer = BasicDenseLayer<double>;
+
+extern template class BasicDenseLayer<double>;
+extern template class BasicDenseLayer<float>;
+extern template class BasicDenseLayer<BFloat16>;
+
 } /* namespace machine_learning */
 } /* namespace yrgo */
\ No newline at end of file
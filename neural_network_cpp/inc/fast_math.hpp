@@ -0,0 +1,105 @@
+/********************************************************************************
+ * @brief Contains vectorized approximations of transcendental activation
+ *        functions with selectable accuracy. All functions operate in place on
+ *        arrays, so that whole rows of a layer are processed with SIMD.
+ ********************************************************************************/
+#pragma once
+
+#include <cstddef>
+
+namespace yrgo {
+namespace machine_learning {
+namespace fast_math {
+
+/********************************************************************************
+ * @brief Enumeration of the accuracy tiers of the approximations. The maximum
+ *        errors hold for inputs of any magnitude and are absolute errors, or
+ *        relative errors for outputs whose magnitude exceeds one.
+ *
+ * @param kExact Uses the standard library (std::tanh, std::exp, ...), i.e. no
+ *               approximation and no vectorization.
+ * @param kHigh  Polynomial approximations with a maximum absolute error of
+ *               1e-6 (about the precision of float).
+ * @param kLow   Low-degree polynomial approximations with a maximum absolute
+ *               error of 1e-3, for networks tolerating coarse activations.
+ ********************************************************************************/
+enum class Accuracy { kExact, kHigh, kLow };
+
+/********************************************************************************
+ * @brief Calculates e^x of each value. Results are clamped to the normal range
+ *        of T instead of overflowing or underflowing.
+ *
+ * @tparam T The type of the values (float or double).
+ *
+ * @param values   Pointer to the values to update.
+ * @param size     The number of values.
+ * @param accuracy The accuracy tier to use (default = high).
+ ********************************************************************************/
+template <typename T>
+void Exp(T* values, const std::size_t size, const Accuracy accuracy = Accuracy::kHigh);
+
+/********************************************************************************
+ * @brief Calculates the hyperbolic tangent of each value.
+ *
+ * @tparam T The type of the values (float or double).
+ *
+ * @param values   Pointer to the values to update.
+ * @param size     The number of values.
+ * @param accuracy The accuracy tier to use (default = high).
+ ********************************************************************************/
+template <typename T>
+void Tanh(T* values, const std::size_t size, const Accuracy accuracy = Accuracy::kHigh);
+
+/********************************************************************************
+ * @brief Calculates the logistic sigmoid 1 / (1 + e^-x) of each value.
+ *
+ * @tparam T The type of the values (float or double).
+ *
+ * @param values   Pointer to the values to update.
+ * @param size     The number of values.
+ * @param accuracy The accuracy tier to use (default = high).
+ ********************************************************************************/
+template <typename T>
+void Sigmoid(T* values, const std::size_t size, const Accuracy accuracy = Accuracy::kHigh);
+
+/********************************************************************************
+ * @brief Calculates the GELU (Gaussian Error Linear Unit) of each value, using
+ *        the tanh formulation 0.5x * (1 + tanh(sqrt(2 / pi) * (x + 0.044715x^3))).
+ *
+ * @tparam T The type of the values (float or double).
+ *
+ * @param values   Pointer to the values to update.
+ * @param size     The number of values.
+ * @param accuracy The accuracy tier to use (default = high).
+ ********************************************************************************/
+template <typename T>
+void Gelu(T* values, const std::size_t size, const Accuracy accuracy = Accuracy::kHigh);
+
+/********************************************************************************
+ * @brief Calculates the softplus log(1 + e^x) of each value.
+ *
+ * @tparam T The type of the values (float or double).
+ *
+ * @param values   Pointer to the values to update.
+ * @param size     The number of values.
+ * @param accuracy The accuracy tier to use (default = high).
+ ********************************************************************************/
+template <typename T>
+void Softplus(T* values, const std::size_t size, const Accuracy accuracy = Accuracy::kHigh);
+
+/********************************************************************************
+ * @brief Calculates the ELU (Exponential Linear Unit) of each value, i.e. x for
+ *        x > 0, else e^x - 1.
+ *
+ * @tparam T The type of the values (float or double).
+ *
+ * @param values   Pointer to the values to update.
+ * @param size     The number of values.
+ * @param accuracy The accuracy tier to use (default = high).
+ ********************************************************************************/
+template <typename T>
+void Elu(T* values, const std::size_t size, const Accuracy accuracy = Accuracy::kHigh);
+
+} /* namespace fast_math */
+} /* namespace machine_learning */
+} /* namespace yrgo */
@@ -0,0 +1,250 @@
+/********************************************************************************
+ * @brief Contains low-overhead instrumentation of the training loop: scoped
+ *        timers measuring the time spent in each phase of training, and
+ *        counters of the floating-point operations of each layer.
+ *
+ * @note The instrumentation is selected at compile time by defining
+ *       NEURAL_NETWORK_INSTRUMENTATION=1 (CMake option INSTRUMENTATION). When
+ *       disabled, which is the default, the timers and counters compile to
+ *       nothing. When enabled, each timer costs two time stamp reads (rdtsc on
+ *       x86, else std::chrono::steady_clock) and one relaxed atomic addition.
+ ********************************************************************************/
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include <span>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define INSTRUMENTATION_RDTSC
+#endif
+
+#ifndef NEURAL_NETWORK_INSTRUMENTATION
+#define NEURAL_NETWORK_INSTRUMENTATION 0
+#endif
+
+namespace yrgo {
+namespace machine_learning {
+namespace instrumentation {
+
+/********************************************************************************
+ * @brief Indicates if the instrumentation is enabled.
+ ********************************************************************************/
+constexpr bool kEnabled{NEURAL_NETWORK_INSTRUMENTATION != 0};
+
+/********************************************************************************
+ * @brief Enumeration of the timed phases of training.
+ *
+ * @param kShuffle       Randomization of the training order.
+ * @param kData          Gathering and reading of the training sets.
+ * @param kFeedforward   Feedforward through the layers (including predictions).
+ * @param kBackpropagate Backpropagation of the errors through the layers.
+ * @param kGradients     Accumulation of the gradients of a batch.
+ * @param kOptimize      Adjustment of the parameters by the optimizer.
+ * @param kValidation    Measurement of the validation loss (except feedforward).
+ ********************************************************************************/
+enum class Phase { kShuffle, kData, kFeedforward, kBackpropagate, kGradients, kOptimize,
+                   kValidation };
+
+/********************************************************************************
+ * @brief The number of timed phases.
+ ********************************************************************************/
+constexpr std::size_t kNumPhases{7};
+
+/********************************************************************************
+ * @brief Provides the name of specified phase.
+ ********************************************************************************/
+constexpr const char* PhaseName(const Phase phase) {
+    constexpr const char* kNames[kNumPhases]{"shuffle", "data", "feedforward", "backpropagate",
+                                             "gradients", "optimize", "validation"};
+    return kNames[static_cast<std::size_t>(phase)];
+}
+
+/********************************************************************************
+ * @brief Provides the current time stamp in ticks, see TicksPerSecond.
+ ********************************************************************************/
+inline std::uint64_t Ticks(void) {
+#ifdef INSTRUMENTATION_RDTSC
+    return __rdtsc();
+#else
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+/********************************************************************************
+ * @brief Provides the number of ticks per second. The time stamp counter is
+ *        calibrated against the steady clock upon the first call.
+ ********************************************************************************/
+inline double TicksPerSecond(void) {
+#ifdef INSTRUMENTATION_RDTSC
+    static const double ticks_per_second{[]() {
+        const auto start_time{std::chrono::steady_clock::now()};
+        const auto start{Ticks()};
+        std::this_thread::sleep_for(std::chrono::milliseconds{20});
+        const auto ticks{static_cast<double>(Ticks() - start)};
+        const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() -
+                                                    start_time};
+        return ticks / elapsed.count();
+    }()};
+    return ticks_per_second;
+#else
+    return 1e9;
+#endif
+}
+
+/********************************************************************************
+ * @brief Counter that can be incremented concurrently from multiple threads.
+ *        Increments are ignored unless the instrumentation is enabled.
+ ********************************************************************************/
+class Counter {
+  public:
+    Counter(void) = default;
+    Counter(const Counter& other) : value_{other.Value()} {}
+    Counter& operator=(const Counter& other) {
+        value_.store(other.Value(), std::memory_order_relaxed);
+        return *this;
+    }
+
+    /********************************************************************************
+     * @brief Adds specified amount to the counter.
+     ********************************************************************************/
+    void Add(const std::uint64_t amount) {
+        if constexpr (kEnabled) { value_.fetch_add(amount, std::memory_order_relaxed); }
+    }
+
+    /********************************************************************************
+     * @brief Provides the value of the counter.
+     ********************************************************************************/
+    std::uint64_t Value(void) const { return value_.load(std::memory_order_relaxed); }
+
+    /********************************************************************************
+     * @brief Resets the counter to zero.
+     ********************************************************************************/
+    void Reset(void) { value_.store(0, std::memory_order_relaxed); }
+
+  private:
+    std::atomic<std::uint64_t> value_{}; /* The value of the counter. */
+};
+
+/********************************************************************************
+ * @brief Holds the accumulated time and number of calls of one phase.
+ ********************************************************************************/
+struct PhaseStats {
+    Counter ticks{}; /* Ticks spent in the phase. */
+    Counter calls{}; /* The number of timed calls. */
+};
+
+/********************************************************************************
+ * @brief Provides the statistics of each phase, shared by all threads.
+ ********************************************************************************/
+inline std::array<PhaseStats, kNumPhases>& Phases(void) {
+    static std::array<PhaseStats, kNumPhases> phases{};
+    return phases;
+}
+
+/********************************************************************************
+ * @brief Resets the statistics of every phase.
+ ********************************************************************************/
+inline void Reset(void) {
+    for (auto& phase : Phases()) {
+        phase.ticks.Reset();
+        phase.calls.Reset();
+    }
+}
+
+/********************************************************************************
+ * @brief Timer adding the time from its construction to its destruction to
+ *        specified phase. Timers may be nested, in which case the time of the
+ *        inner timer is only counted for the inner phase, so that the phases
+ *        add up to the total time.
+ ********************************************************************************/
+class ScopedTimer {
+  public:
+
+    /********************************************************************************
+     * @brief Starts timing specified phase.
+     ********************************************************************************/
+    explicit ScopedTimer(const Phase phase) {
+        if constexpr (kEnabled) {
+            phase_ = phase;
+            parent_ = Active();
+            Active() = this;
+            start_ = Ticks();
+        }
+    }
+
+    /********************************************************************************
+     * @brief Stops timing and records the time of the phase.
+     ********************************************************************************/
+    ~ScopedTimer(void) {
+        if constexpr (kEnabled) {
+            const auto elapsed{Ticks() - start_};
+            auto& stats{Phases()[static_cast<std::size_t>(phase_)]};
+            stats.ticks.Add(elapsed > children_ ? elapsed - children_ : 0);
+            stats.calls.Add(1);
+            if (parent_ != nullptr) { parent_->children_ += elapsed; }
+            Active() = parent_;
+        }
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+  private:
+    static ScopedTimer*& Active(void) {
+        thread_local ScopedTimer* active{nullptr};
+        return active;
+    }
+
+    Phase phase_{};            /* The timed phase. */
+    ScopedTimer* parent_{};    /* The enclosing timer of the thread, if any. */
+    std::uint64_t start_{};    /* Time stamp of the start. */
+    std::uint64_t children_{}; /* Ticks spent in nested timers. */
+};
+
+/********************************************************************************
+ * @brief Prints the time spent in each phase and the floating-point operations
+ *        of each layer.
+ *
+ * @param layer_flops The number of floating-point operations of each layer.
+ * @param ostream     Reference to the output stream.
+ ********************************************************************************/
+inline void Print(const std::span<const std::uint64_t> layer_flops, std::ostream& ostream) {
+    const auto ticks_per_second{TicksPerSecond()};
+    std::uint64_t total_ticks{};
+    for (const auto& phase : Phases()) { total_ticks += phase.ticks.Value(); }
+    const auto total_seconds{static_cast<double>(total_ticks) / ticks_per_second};
+
+    const auto flags{ostream.flags()};
+    ostream << std::fixed << std::setprecision(3) << "Training profile:\n";
+    for (std::size_t i{}; i < kNumPhases; ++i) {
+        const auto& phase{Phases()[i]};
+        const auto seconds{static_cast<double>(phase.ticks.Value()) / ticks_per_second};
+        ostream << "  " << std::left << std::setw(14) << PhaseName(static_cast<Phase>(i))
+                << std::right << std::setw(12) << seconds * 1e3 << " ms"
+                << std::setw(9) << (total_ticks > 0 ? 100.0 * phase.ticks.Value() /
+                                                      total_ticks : 0.0) << " %"
+                << std::setw(12) << phase.calls.Value() << " calls\n";
+    }
+    std::uint64_t total_flops{};
+    for (std::size_t i{}; i < layer_flops.size(); ++i) {
+        ostream << "  layer " << std::left << std::setw(8) << i << std::right << std::setw(12)
+                << layer_flops[i] * 1e-6 << " MFLOP\n";
+        total_flops += layer_flops[i];
+    }
+    ostream << "  total " << std::setw(20) << total_seconds * 1e3 << " ms, "
+            << (total_seconds > 0 ? total_flops * 1e-9 / total_seconds : 0.0) << " GFLOP/s\n";
+    ostream.flags(flags);
+}
+
+} /* namespace instrumentation */
+} /* namespace machine_learning */
+} /* namespace yrgo */
@@ -0,0 +1,148 @@
+/********************************************************************************
+ * @brief Contains linear algebra kernels used by the dense layers.
+ ********************************************************************************/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <matrix.hpp>
+#include <scalar.hpp>
+
+namespace yrgo {
+namespace machine_learning {
+namespace linalg {
+
+/********************************************************************************
+ * @brief Enumeration of the instruction sets the kernels can be executed with.
+ *
+ * @param kScalar Portable kernels, used if no SIMD support is detected. The matrix
+ *                products use 128-bit GCC vectors (SSE2 on x86-64) at this level.
+ * @param kAvx2   256-bit kernels using AVX2 and FMA instructions.
+ * @param kAvx512 512-bit kernels using AVX-512F instructions.
+ ********************************************************************************/
+enum class SimdLevel { kScalar, kAvx2, kAvx512 };
+
+/********************************************************************************
+ * @brief Provides the best instruction set supported by the CPU.
+ * 
+ * @return The highest SIMD level supported by the CPU running the program.
+ ********************************************************************************/
+SimdLevel SupportedSimdLevel(void);
+
+/********************************************************************************
+ * @brief Provides the instruction set currently used by the kernels. The best
+ *        supported instruction set is selected automatically upon first use.
+ * 
+ * @return The SIMD level currently in use.
+ ********************************************************************************/
+SimdLevel ActiveSimdLevel(void);
+
+/********************************************************************************
+ * @brief Selects the instruction set to use for the kernels, for instance to
+ *        compare the SIMD kernels with the scalar kernels. Levels not supported
+ *        by the CPU are replaced by the best supported level.
+ * 
+ * @note This function may be called while other threads use the kernels, which
+ *       switch to the selected level at their next call.
+ * 
+ * @param level The requested SIMD level.
+ * 
+ * @return The SIMD level actually selected.
+ ********************************************************************************/
+SimdLevel SetSimdLevel(const SimdLevel level);
+
+/********************************************************************************
+ * @brief Provides the dot product of two vectors, accumulated with the compute
+ *        type of the second vector.
+ * 
+ * @tparam T The type of the first vector (typically the weights).
+ * @tparam U The type of the second vector (typically the activations).
+ * 
+ * @param x    Pointer to the first vector.
+ * @param y    Pointer to the second vector.
+ * @param size The number of elements in each vector.
+ * 
+ * @return The dot product x * y.
+ ********************************************************************************/
+template <typename T, typename U>
+U Dot(const T* x, const U* y, const std::size_t size);
+
+/********************************************************************************
+ * @brief Provides the dot product of two vectors of 8-bit integers, accumulated
+ *        with 32-bit integers. Used for quantized inference.
+ * 
+ * @param x    Pointer to the first vector.
+ * @param y    Pointer to the second vector.
+ * @param size The number of elements in each vector (at most 2^17 to rule out
+ *             overflow of the accumulator).
+ * 
+ * @return The dot product x * y.
+ ********************************************************************************/
+std::int32_t DotInt8(const std::int8_t* x, const std::int8_t* y, const std::size_t size);
+
+/********************************************************************************
+ * @brief Adds a scaled vector to another vector, i.e. y += alpha * x.
+ * 
+ * @tparam T The type of the vector to scale and add.
+ * @tparam U The type of the vector to update.
+ * 
+ * @param alpha The scale factor.
+ * @param x     Pointer to the vector to scale and add.
+ * @param y     Pointer to the vector to update.
+ * @param size  The number of elements in each vector.
+ ********************************************************************************/
+template <typename T, typename U>
+void Axpy(const ComputeType<U> alpha, const T* x, U* y, const std::size_t size);
+
+/********************************************************************************
+ * @brief Calculates c = a * transpose(b), i.e. c[i][j] = a[i] * b[j]. Used for
+ *        feedforward of batches, where a holds the input samples and b holds
+ *        the weights with one row per node.
+ * 
+ * @tparam T The type of the right matrix (the weights).
+ * @tparam U The type of the left and result matrices (the activations).
+ * 
+ * @param a View of the left matrix (m x k).
+ * @param b View of the right matrix (n x k).
+ * @param c View of the result matrix (m x n).
+ ********************************************************************************/
+template <typename T, typename U>
+void MultiplyTransposed(const MatrixView<const U>& a, 
+                        const MatrixView<const T>& b,
+                        const MatrixView<U>& c);
+
+/********************************************************************************
+ * @brief Calculates c = a * b. Used for backpropagation of batches, where a 
+ *        holds the errors of the next layer and b holds its weights.
+ * 
+ * @tparam T The type of the right matrix (the weights).
+ * @tparam U The type of the left and result matrices (the errors).
+ * 
+ * @param a View of the left matrix (m x k).
+ * @param b View of the right matrix (k x n).
+ * @param c View of the result matrix (m x n).
+ ********************************************************************************/
+template <typename T, typename U>
+void Multiply(const MatrixView<const U>& a, 
+              const MatrixView<const T>& b,
+              const MatrixView<U>& c);
+
+/********************************************************************************
+ * @brief Calculates c += transpose(a) * b. Used for accumulating weight 
+ *        gradients of batches, where a holds the errors and b holds the inputs.
+ * 
+ * @tparam T The type of the matrices.
+ * 
+ * @param a View of the left matrix (k x m).
+ * @param b View of the right matrix (k x n).
+ * @param c View of the result matrix (m x n).
+ ********************************************************************************/
+template <typename T>
+void AddTransposedProduct(const MatrixView<const T>& a, 
+                          const MatrixView<const T>& b,
+                          const MatrixView<T>& c);
+
+} /* namespace linalg */
+} /* namespace machine_learning */
+} /* namespace yrgo */
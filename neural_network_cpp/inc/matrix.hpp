@@ -0,0 +1,170 @@
+/********************************************************************************
+ * @brief Contains dense row-major matrices and non-owning views of such
+ *        matrices, used for storing batches of samples.
+ ********************************************************************************/
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+
+#include <utils.hpp>
+
+namespace yrgo {
+namespace machine_learning {
+
+/********************************************************************************
+ * @brief Non-owning view of a dense row-major matrix.
+ *
+ * @tparam T The element type (const-qualified for read-only views).
+ ********************************************************************************/
+template <typename T>
+class MatrixView {
+  public:
+
+    /********************************************************************************
+     * @brief Creates empty matrix view.
+     ********************************************************************************/
+    MatrixView(void) = default;
+
+    /********************************************************************************
+     * @brief Creates new view of specified matrix data.
+     *
+     * @param data        Pointer to the first element of the matrix.
+     * @param num_rows    The number of rows of the matrix.
+     * @param num_columns The number of columns of the matrix.
+     * @param stride      The distance in elements between two adjacent rows
+     *                    (default = num_columns, i.e. tightly packed rows).
+     ********************************************************************************/
+    MatrixView(T* data, const std::size_t num_rows, const std::size_t num_columns,
+               const std::size_t stride = 0)
+        : data_{data}
+        , num_rows_{num_rows}
+        , num_columns_{num_columns}
+        , stride_{stride > 0 ? stride : num_columns} {}
+
+    /********************************************************************************
+     * @brief Creates read-only view from a mutable view.
+     *
+     * @param view Reference to the mutable view.
+     ********************************************************************************/
+    template <typename U, typename = std::enable_if_t<std::is_same_v<const U, T> &&
+                                                      !std::is_same_v<U, T>>>
+    MatrixView(const MatrixView<U>& view)
+        : MatrixView(view.Data(), view.NumRows(), view.NumColumns(), view.Stride()) {}
+
+    /********************************************************************************
+     * @brief Provides pointer to the first element of the matrix.
+     ********************************************************************************/
+    T* Data(void) const { return data_; }
+
+    /********************************************************************************
+     * @brief Provides the number of rows of the matrix.
+     ********************************************************************************/
+    std::size_t NumRows(void) const { return num_rows_; }
+
+    /********************************************************************************
+     * @brief Provides the number of columns of the matrix.
+     ********************************************************************************/
+    std::size_t NumColumns(void) const { return num_columns_; }
+
+    /********************************************************************************
+     * @brief Provides the distance in elements between two adjacent rows.
+     ********************************************************************************/
+    std::size_t Stride(void) const { return stride_; }
+
+    /********************************************************************************
+     * @brief Provides pointer to the first element of specified row.
+     *
+     * @param row Index of the row.
+     ********************************************************************************/
+    T* Row(const std::size_t row) const { return data_ + row * stride_; }
+
+    /********************************************************************************
+     * @brief Provides a view of the specified rows.
+     *
+     * @param first    Index of the first row.
+     * @param num_rows The number of rows in the view.
+     ********************************************************************************/
+    MatrixView Rows(const std::size_t first, const std::size_t num_rows) const {
+        return {Row(first), num_rows, num_columns_, stride_};
+    }
+
+  private:
+    T* data_{nullptr};
+    std::size_t num_rows_{};
+    std::size_t num_columns_{};
+    std::size_t stride_{};
+};
+
+/********************************************************************************
+ * @brief Dense row-major matrix with cache line aligned rows.
+ *
+ * @tparam T The element type.
+ ********************************************************************************/
+template <typename T>
+class Matrix {
+  public:
+
+    /********************************************************************************
+     * @brief Creates empty matrix.
+     ********************************************************************************/
+    Matrix(void) = default;
+
+    /********************************************************************************
+     * @brief Creates new zero-initialized matrix of specified size.
+     *
+     * @param num_rows    The number of rows of the matrix.
+     * @param num_columns The number of columns of the matrix.
+     ********************************************************************************/
+    Matrix(const std::size_t num_rows, const std::size_t num_columns) {
+        Resize(num_rows, num_columns);
+    }
+
+    /********************************************************************************
+     * @brief Resizes the matrix. Memory is only reallocated if the new size
+     *        exceeds the current capacity. The content is not preserved if the
+     *        number of columns changes.
+     *
+     * @param num_rows    The new number of rows of the matrix.
+     * @param num_columns The new number of columns of the matrix.
+     ********************************************************************************/
+    void Resize(const std::size_t num_rows, const std::size_t num_columns) {
+        num_rows_ = num_rows;
+        num_columns_ = num_columns;
+        stride_ = utils::memory::PaddedSize<T>(num_columns);
+        data_.resize(num_rows * stride_);
+    }
+
+    /********************************************************************************
+     * @brief Sets all elements of the matrix to zero.
+     ********************************************************************************/
+    void Clear(void) { std::fill(data_.begin(), data_.end(), T{}); }
+
+    T* Data(void) { return data_.data(); }
+    const T* Data(void) const { return data_.data(); }
+    std::size_t NumRows(void) const { return num_rows_; }
+    std::size_t NumColumns(void) const { return num_columns_; }
+    std::size_t Stride(void) const { return stride_; }
+    T* Row(const std::size_t row) { return data_.data() + row * stride_; }
+    const T* Row(const std::size_t row) const { return data_.data() + row * stride_; }
+
+    /********************************************************************************
+     * @brief Provides a mutable view of the matrix.
+     ********************************************************************************/
+    MatrixView<T> View(void) { return {Data(), num_rows_, num_columns_, stride_}; }
+
+    /********************************************************************************
+     * @brief Provides a read-only view of the matrix.
+     ********************************************************************************/
+    MatrixView<const T> View(void) const { return {Data(), num_rows_, num_columns_, stride_}; }
+
+  private:
+    utils::memory::AlignedVector<T> data_{};
+    std::size_t num_rows_{};
+    std::size_t num_columns_{};
+    std::size_t stride_{};
+};
+
+} /* namespace machine_learning */
+} /* namespace yrgo */
@@ -0,0 +1,210 @@
+/********************************************************************************
+ * @brief Contains the binary model file format used for saving trained neural
+ *        networks, and a read-only network running inference directly on the
+ *        memory-mapped weights of such a file.
+ *
+ * @note The file layout is as follows (native byte order):
+ *       - One FileHeader.
+ *       - One LayerHeader per layer, ordered from input to output.
+ *       - The weights and bias values of each layer, each blob starting at a
+ *         cache line boundary. The weights are stored row-major with the same
+ *         padded stride as in memory, so the mapped blobs can be used as is.
+ ********************************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <dense_layer.hpp>
+#include <matrix.hpp>
+#include <neural_network.hpp>
+#include <scalar.hpp>
+
+namespace yrgo {
+namespace machine_learning {
+namespace model_file {
+
+/********************************************************************************
+ * @brief Identifies model files, stored in the beginning of every file.
+ ********************************************************************************/
+constexpr char kMagic[8]{'Y', 'R', 'G', 'O', 'N', 'N', '\0', '\0'};
+
+/********************************************************************************
+ * @brief The version of the file format. Incremented upon every change of the
+ *        layout, files of other versions are rejected.
+ ********************************************************************************/
+constexpr std::uint32_t kVersion{1};
+
+/********************************************************************************
+ * @brief Enumeration of the scalar types the weights can be stored with.
+ ********************************************************************************/
+enum class ScalarType : std::uint32_t { kDouble, kFloat, kBFloat16 };
+
+/********************************************************************************
+ * @brief Provides the file format identifier of scalar type T.
+ ********************************************************************************/
+template <typename T>
+constexpr ScalarType ScalarTypeOf(void) {
+    if constexpr (std::is_same_v<T, double>) {
+        return ScalarType::kDouble;
+    } else if constexpr (std::is_same_v<T, float>) {
+        return ScalarType::kFloat;
+    } else {
+        static_assert(std::is_same_v<T, BFloat16>, "Unsupported scalar type!");
+        return ScalarType::kBFloat16;
+    }
+}
+
+/********************************************************************************
+ * @brief Header stored in the beginning of every model file.
+ ********************************************************************************/
+struct FileHeader {
+    char magic[8]{};            /* Always kMagic. */
+    std::uint32_t version{};    /* Version of the file format. */
+    ScalarType scalar_type{};   /* Scalar type of the weights. */
+    std::uint64_t num_layers{}; /* The number of dense layers. */
+    std::uint64_t file_size{};  /* The total size of the file in bytes. */
+};
+
+/********************************************************************************
+ * @brief Header describing one dense layer. Offsets are counted in bytes from
+ *        the beginning of the file.
+ ********************************************************************************/
+struct LayerHeader {
+    std::uint64_t num_nodes{};            /* The number of nodes in the layer. */
+    std::uint64_t num_weights_per_node{}; /* The number of weights per node. */
+    std::uint64_t weight_stride{};        /* Distance in elements between two rows. */
+    std::uint64_t weight_offset{};        /* Offset of the weights. */
+    std::uint64_t bias_offset{};          /* Offset of the bias values. */
+    ActFunc act_func{};                   /* Activation function of the layer. */
+    std::uint32_t reserved{};             /* Reserved, always 0. */
+};
+
+/********************************************************************************
+ * @brief Saves specified neural network to a model file.
+ *
+ * @tparam T The scalar type of the network.
+ *
+ * @param network Reference to the network to save.
+ * @param path    The path of the file to create (overwritten if it exists).
+ *
+ * @return True if the file was written, else false.
+ ********************************************************************************/
+template <typename T>
+bool Save(const BasicNeuralNetwork<T>& network, const std::string& path);
+
+} /* namespace model_file */
+
+/********************************************************************************
+ * @brief Read-only neural network backed by a memory-mapped model file. The
+ *        weights are used directly from the mapped pages without copying, so
+ *        opening a model only costs the page faults of the weights in use.
+ *
+ * @tparam T The scalar type of the weights, which must match the file.
+ ********************************************************************************/
+template <typename T>
+class BasicMappedNeuralNetwork {
+  public:
+
+    /********************************************************************************
+     * @brief The type used for input values and output values.
+     ********************************************************************************/
+    using Compute = ComputeType<T>;
+
+    /********************************************************************************
+     * @brief Default constructor deleted.
+     ********************************************************************************/
+    BasicMappedNeuralNetwork(void) = delete;
+
+    /********************************************************************************
+     * @brief Maps specified model file into memory.
+     *
+     * @param path The path of the model file.
+     *
+     * @throw std::runtime_error if the file cannot be mapped or isn't a valid
+     *        model file with weights of scalar type T.
+     ********************************************************************************/
+    explicit BasicMappedNeuralNetwork(const std::string& path);
+
+    BasicMappedNeuralNetwork(const BasicMappedNeuralNetwork&) = delete;
+    BasicMappedNeuralNetwork& operator=(const BasicMappedNeuralNetwork&) = delete;
+
+    /********************************************************************************
+     * @brief Unmaps the model file.
+     ********************************************************************************/
+    ~BasicMappedNeuralNetwork(void);
+
+    /********************************************************************************
+     * @brief Provides the number of inputs in the network.
+     ********************************************************************************/
+    std::size_t NumInputs(void) const { return layers_.front().weights.NumColumns(); }
+
+    /********************************************************************************
+     * @brief Provides the number of outputs in the network.
+     ********************************************************************************/
+    std::size_t NumOutputs(void) const { return layers_.back().weights.NumRows(); }
+
+    /********************************************************************************
+     * @brief Provides the number of dense layers in the network.
+     ********************************************************************************/
+    std::size_t NumLayers(void) const { return layers_.size(); }
+
+    /********************************************************************************
+     * @brief Copies the mapped layers into ordinary dense layers, for instance
+     *        to create a trainable network of a saved model.
+     *
+     * @return Vector holding the layers, ordered from input to output.
+     ********************************************************************************/
+    std::vector<BasicDenseLayer<T>> CopyLayers(void) const;
+
+    /********************************************************************************
+     * @brief Performs prediction with specified input values.
+     *
+     * @param input Reference to vector holding input values.
+     *
+     * @return Reference to vector holding the predicted output values.
+     ********************************************************************************/
+    const std::vector<Compute>& Predict(const std::vector<Compute>& input);
+
+    /********************************************************************************
+     * @brief Performs predictions with a batch of input sets.
+     *
+     * @param input  View of the input sets, one row per set and one column per input.
+     * @param output View of the buffer to write the predicted output values to, one
+     *               row per set and one column per output.
+     *
+     * @return True if the predictions were performed, false if the output buffer
+     *         doesn't have room for all predictions.
+     ********************************************************************************/
+    bool PredictBatch(const MatrixView<const Compute>& input, const MatrixView<Compute>& output);
+
+  private:
+    struct Layer {
+        MatrixView<const T> weights{};   /* Mapped weights, one row per node. */
+        std::span<const Compute> bias{}; /* Mapped bias values. */
+        ActFunc act_func{};              /* Activation function of the layer. */
+    };
+
+    void Feedforward(const Layer& layer, const MatrixView<const Compute>& input,
+                     const MatrixView<Compute>& output) const;
+
+    void* data_{nullptr};                         /* Start of the mapped file. */
+    std::size_t size_{};                          /* Size of the mapped file. */
+    std::vector<Layer> layers_{};                 /* Views of the mapped layers. */
+    std::vector<std::vector<Compute>> output_{};  /* Output values of each layer. */
+    std::vector<Matrix<Compute>> batch_output_{}; /* Batch output values of each layer. */
+};
+
+/********************************************************************************
+ * @brief Memory-mapped neural network with double precision (the default).
+ ********************************************************************************/
+using MappedNeuralNetwork = BasicMappedNeuralNetwork<double>;
+
+extern template class BasicMappedNeuralNetwork<double>;
+extern template class BasicMappedNeuralNetwork<float>;
+extern template class BasicMappedNeuralNetwork<BFloat16>;
+
+} /* namespace machine_learning */
+} /* namespace yrgo */
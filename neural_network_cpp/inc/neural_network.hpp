@@ -5,22 +5,96 @@
 
 #include <iomanip>  
 #include <iostream> 
+#include <span>
+#include <stdexcept>
+#include <thread>
 #include <type_traits>
 #include <vector>   
 
+#include <dataset.hpp>
 #include <dense_layer.hpp>
+#include <matrix.hpp>
+#include <scalar.hpp>
+#include <training.hpp>
 #include <utils.hpp>
 
 namespace yrgo {
 namespace machine_learning {
 
-class NeuralNetwork {
+template <typename T>
+class BasicNeuralNetwork;
+
+/********************************************************************************
+ * @brief The maximum number of input sets to feed through the network at once
+ *        during batch prediction, which limits the size of the layer scratch.
+ ********************************************************************************/
+constexpr std::size_t kMaxPredictBatchSize{256};
+
+/********************************************************************************
+ * @brief Holds the activation buffers used when performing predictions with a
+ *        neural network. The network itself is not modified during prediction,
+ *        so a trained network can be shared between any number of threads as
+ *        long as each thread owns its own inference context.
+ *
+ * @tparam T The scalar type of the network the context is used with.
+ ********************************************************************************/
+template <typename T>
+class BasicInferenceContext {
+  public:
+
+    /********************************************************************************
+     * @brief The type used for the activations.
+     ********************************************************************************/
+    using Compute = ComputeType<T>;
+
+    /********************************************************************************
+     * @brief Creates empty inference context. The buffers are allocated upon the
+     *        first prediction.
+     ********************************************************************************/
+    BasicInferenceContext(void) = default;
+
+    /********************************************************************************
+     * @brief Creates inference context with buffers preallocated for specified network.
+     * 
+     * @param network Reference to the network the context will be used with.
+     ********************************************************************************/
+    explicit BasicInferenceContext(const BasicNeuralNetwork<T>& network);
+
+  private:
+    friend class BasicNeuralNetwork<T>;
+
+    void Prepare(const BasicNeuralNetwork<T>& network);
+    void PrepareBatch(const BasicNeuralNetwork<T>& network, const std::size_t num_sets);
+
+    std::vector<std::vector<Compute>> output_{};  /* Output values of each layer. */
+    std::vector<Matrix<Compute>> batch_output_{}; /* Batch output values of each layer. */
+};
+
+/********************************************************************************
+ * @brief Neural network consisting of dense layers whose weights are stored with
+ *        scalar type T. Input values, output values and training data use the
+ *        compute type of T (float for BFloat16, else T itself).
+ *
+ * @tparam T The scalar type of the weights (Compute, float or BFloat16).
+ ********************************************************************************/
+template <typename T>
+class BasicNeuralNetwork {
 public:
 
+    /********************************************************************************
+     * @brief The type used for input values, output values and training data.
+     ********************************************************************************/
+    using Compute = ComputeType<T>;
+
+    /********************************************************************************
+     * @brief The type of the dense layers of the network.
+     ********************************************************************************/
+    using Layer = BasicDenseLayer<T>;
+
     /********************************************************************************
      * @brief Default constructor deleted.
      ********************************************************************************/
-    NeuralNetwork(void) = delete;
+    BasicNeuralNetwork(void) = delete;
 
     /********************************************************************************
      * @brief Creates new neural network.
@@ -30,33 +104,147 @@ public:
      * @param num_output       The number of outputs (nodes in the output layer).
      * @param act_func_hidden  Activation function of the hidden layer (default = ReLU).
      * @param act_func_output  Activation function of the output layer (default = ReLU).
+     * 
+     * @throw std::invalid_argument if softmax is selected for the hidden layer.
+     ********************************************************************************/
+    BasicNeuralNetwork(const std::size_t num_inputs, 
+                       const std::size_t num_hidden_nodes, 
+                       const std::size_t num_outputs,
+                       const ActFunc act_func_hidden = ActFunc::kRelu, 
+                       const ActFunc act_func_output = ActFunc::kRelu);
+
+    /********************************************************************************
+     * @brief Creates new neural network with an arbitrary number of hidden layers.
+     * 
+     * @param num_inputs       The number of inputs (nodes in the input layer).
+     * @param num_hidden_nodes Reference to vector holding the number of nodes in 
+     *                         each hidden layer, ordered from input to output.
+     * @param num_output       The number of outputs (nodes in the output layer).
+     * @param act_func_hidden  Activation function of the hidden layers (default = ReLU).
+     * @param act_func_output  Activation function of the output layer (default = ReLU).
+     * 
+     * @throw std::invalid_argument if softmax is selected for the hidden layers.
+     ********************************************************************************/
+    BasicNeuralNetwork(const std::size_t num_inputs, 
+                       const std::vector<std::size_t>& num_hidden_nodes, 
+                       const std::size_t num_outputs,
+                       const ActFunc act_func_hidden = ActFunc::kRelu, 
+                       const ActFunc act_func_output = ActFunc::kRelu);
+
+    /********************************************************************************
+     * @brief Creates new neural network from specified layers. The last layer is
+     *        used as output layer, all other layers are used as hidden layers.
+     * 
+     * @param layers Vector holding the layers, ordered from input to output. The
+     *               number of weights per node in each layer must match the number
+     *               of nodes in the previous layer.
+     * 
+     * @throw std::invalid_argument if no layers are passed, if a hidden layer uses
+     *        softmax or if the number of weights per node doesn't match the number
+     *        of nodes in the previous layer.
+     ********************************************************************************/
+    explicit BasicNeuralNetwork(std::vector<Layer> layers);
+
+    /********************************************************************************
+     * @brief Creates copy of specified neural network. The buffers of all layers
+     *        are copied at once by copying the arena holding them. The training
+     *        and inference scratch buffers are not copied.
+     * 
+     * @param source Reference to the network to copy.
      ********************************************************************************/
-    NeuralNetwork(const std::size_t num_inputs, 
-                  const std::size_t num_hidden_nodes, 
-                  const std::size_t num_outputs,
-                  const ActFunc act_func_hidden = ActFunc::kRelu, 
-                  const ActFunc act_func_output = ActFunc::kRelu);
+    BasicNeuralNetwork(const BasicNeuralNetwork& source);
+
+    /********************************************************************************
+     * @brief Replaces the network with a copy of specified neural network.
+     * 
+     * @param source Reference to the network to copy.
+     * 
+     * @return Reference to the network.
+     ********************************************************************************/
+    BasicNeuralNetwork& operator=(const BasicNeuralNetwork& source);
+
+    BasicNeuralNetwork(BasicNeuralNetwork&&) = default;
+    BasicNeuralNetwork& operator=(BasicNeuralNetwork&&) = default;
 
     /********************************************************************************
      * @brief Provides the number of inputs in the network.
      * 
      * @return The number of inputs, i.e. the number of nodes in the input layer.
      ********************************************************************************/
-    std::size_t NumInputs(void) const { return hidden_layer_.NumWeightsPerNode(); }
+    std::size_t NumInputs(void) const { return layers_.front().NumWeightsPerNode(); }
 
     /********************************************************************************
-     * @brief Provides the number of nodes in the hidden layer of the network.
+     * @brief Provides the number of nodes in the first hidden layer of the network.
      * 
-     * @return The number of nodes in the hidden layer.
+     * @return The number of nodes in the first hidden layer (0 if the network has
+     *         no hidden layers).
      ********************************************************************************/
-    std::size_t NumHiddenNodes(void) const { return hidden_layer_.NumNodes(); }
+    std::size_t NumHiddenNodes(void) const { 
+        return layers_.size() > 1 ? layers_.front().NumNodes() : 0; 
+    }
 
     /********************************************************************************
      * @brief Provides the number of outputs in the network.
      * 
      * @return The number of outputs, i.e. the number of nodes in the output layer.
      ********************************************************************************/
-    std::size_t NumOutputs(void) const { return output_layer_.NumNodes(); }
+    std::size_t NumOutputs(void) const { return layers_.back().NumNodes(); }
+
+    /********************************************************************************
+     * @brief Provides the number of dense layers (hidden layers and output layer).
+     * 
+     * @return The number of dense layers in the network.
+     ********************************************************************************/
+    std::size_t NumLayers(void) const { return layers_.size(); }
+
+    /********************************************************************************
+     * @brief Provides the dense layers of the network.
+     * 
+     * @return Reference to vector holding the layers, ordered from input to output.
+     ********************************************************************************/
+    const std::vector<Layer>& Layers(void) const { return layers_; }
+
+    /********************************************************************************
+     * @brief Provides the arena holding the weights, bias values, output values,
+     *        errors and optimizer state of all layers. A copy of the arena is a 
+     *        snapshot of the network, which can be restored with Restore.
+     * 
+     * @return Reference to the arena of the network.
+     ********************************************************************************/
+    const Arena& ModelArena(void) const { return arena_; }
+
+    /********************************************************************************
+     * @brief Restores the parameters and optimizer state of all layers from a 
+     *        snapshot taken with ModelArena.
+     * 
+     * @param snapshot Reference to a copy of the arena of this network.
+     * 
+     * @return True if the snapshot was restored, false if it doesn't match the 
+     *         layout of the network.
+     ********************************************************************************/
+    bool Restore(const Arena& snapshot) { return arena_.CopyFrom(snapshot); }
+
+    /********************************************************************************
+     * @brief Selects the accuracy tier used for calculating the activations of all
+     *        layers, see BasicDenseLayer::SetActivationAccuracy.
+     * 
+     * @param accuracy The accuracy tier to use.
+     ********************************************************************************/
+    void SetActivationAccuracy(const fast_math::Accuracy accuracy) {
+        for (auto& layer : layers_) { layer.SetActivationAccuracy(accuracy); }
+    }
+
+    /********************************************************************************
+     * @brief Selects the optimizer used for adjusting the parameters of all layers
+     *        during training. The state of the previous optimizer is discarded.
+     * 
+     * @param optimizer The optimizer and its hyperparameters.
+     ********************************************************************************/
+    void SetOptimizer(const OptimizerConfig& optimizer) {
+        for (auto& layer : layers_) { layer.SetOptimizer(optimizer); }
+        BindArena();
+        num_updates_ = 0;
+    }
 
     /********************************************************************************
      * @brief Provides the number of stored training sets.
@@ -66,15 +254,67 @@ public:
     std::size_t NumTrainingSets(void) const { return train_order_.size(); }
 
     /********************************************************************************
-     * @brief Adds training sets to the network.
+     * @brief Adds training sets to the network. The sets are copied into one 
+     *        contiguous row-major block, padded with zeros or truncated to the 
+     *        number of inputs and outputs of the network. Replaces any previous
+     *        training sets.
      * 
      * @param train_input Reference to vector storing input sets.
      * @param train_output Reference to vector storing output sets.
      * 
      * @return True if at least one training set has been added.
      ********************************************************************************/
-    bool AddTrainingData(const std::vector<std::vector<double>>& train_input,
-                         const std::vector<std::vector<double>>& train_output);
+    bool AddTrainingData(const std::vector<std::vector<Compute>>& train_input,
+                         const std::vector<std::vector<Compute>>& train_output);
+
+    /********************************************************************************
+     * @brief Adds training sets to the network by taking ownership of specified
+     *        matrices, one row per set. Nothing is copied. Replaces any previous 
+     *        training sets.
+     * 
+     * @param train_input  Matrix holding the input sets, one column per input.
+     * @param train_output Matrix holding the output sets, one column per output.
+     * 
+     * @return True if at least one training set has been added, false if the
+     *         number of columns doesn't match the network (nothing is added).
+     ********************************************************************************/
+    bool AddTrainingData(Matrix<Compute>&& train_input, Matrix<Compute>&& train_output);
+
+    /********************************************************************************
+     * @brief Adds training sets to the network without copying them. The network
+     *        only refers to the data, which must stay valid and unchanged for as
+     *        long as the network is trained with it. Replaces any previous training
+     *        sets.
+     * 
+     * @param train_input  View of the input sets, one row per set and one column 
+     *                     per input.
+     * @param train_output View of the output sets, one row per set and one column
+     *                     per output.
+     * 
+     * @return True if at least one training set has been added, false if the
+     *         number of columns doesn't match the network (nothing is added).
+     ********************************************************************************/
+    bool AddTrainingData(const MatrixView<const Compute>& train_input, 
+                         const MatrixView<const Compute>& train_output);
+
+    /********************************************************************************
+     * @brief Provides the number of stored validation sets.
+     * 
+     * @return The number of stored validation sets, if any.
+     ********************************************************************************/
+    std::size_t NumValidationSets(void) const { return validation_input_.NumRows(); }
+
+    /********************************************************************************
+     * @brief Sets the held-out validation sets, used for measuring the loss after
+     *        each epoch when training with options. Replaces any previous sets.
+     * 
+     * @param validation_input  Reference to vector storing input sets.
+     * @param validation_output Reference to vector storing output sets.
+     * 
+     * @return True if at least one validation set has been added.
+     ********************************************************************************/
+    bool SetValidationData(const std::vector<std::vector<Compute>>& validation_input,
+                           const std::vector<std::vector<Compute>>& validation_output);
     
     /********************************************************************************
      * @brief Trains the neural network.
@@ -82,10 +322,72 @@ public:
      * @param num_epochs    The number of epochs to train.
      * @param learning_rate The learning rate, sets the adjustment rate of the
      *                      network parameters upon error (default = 0.01, i.e. 1 %).
+     * @param batch_size    The number of training sets whose gradients are averaged
+     *                      before the parameters are adjusted (default = 1, i.e.
+     *                      the parameters are adjusted after every training set).
+     * 
+     * @return True if training was performed, else false.
+     ********************************************************************************/
+    bool Train(const std::size_t num_epochs, const Compute learning_rate = 0.01,
+               const std::size_t batch_size = 1);
+
+    /********************************************************************************
+     * @brief Trains the neural network with a learning-rate schedule. If validation
+     *        sets are stored, the validation loss is measured after each epoch and
+     *        training stops once it hasn't improved for the number of epochs given
+     *        by the patience (if any). The training loss of each epoch is summed
+     *        during backpropagation, i.e. while the parameters are adjusted.
+     * 
+     * @param options The training options.
+     * 
+     * @return Report holding the number of epochs run, the training and validation
+     *         loss of each epoch and the wall time. No epochs are run if there are
+     *         no training sets or if the options are invalid.
+     ********************************************************************************/
+    TrainingReport Train(const TrainingOptions& options);
+
+    /********************************************************************************
+     * @brief Trains the neural network on sets streamed from specified reader, so
+     *        that the dataset doesn't need to fit in memory. Each epoch rewinds the
+     *        reader and passes the sets through a shuffle buffer holding 
+     *        options.shuffle_buffer_size sets: every incoming set replaces a randomly
+     *        selected buffered set, which is trained on. The stored training sets
+     *        are not used. Streaming training is always single-threaded.
+     * 
+     * @param reader  Reference to the reader providing the training sets. Wrap the
+     *                reader in a PrefetchReader to overlap I/O with the training.
+     * @param options The training options, see Train(const TrainingOptions&).
+     * 
+     * @return Report of the training, see Train(const TrainingOptions&). No epochs
+     *         are run if the number of inputs or outputs of the reader doesn't match
+     *         the network or if the options are invalid.
+     ********************************************************************************/
+    TrainingReport Train(DatasetReader<Compute>& reader, const TrainingOptions& options);
+
+    /********************************************************************************
+     * @brief Trains the neural network on multiple threads. Each thread computes 
+     *        gradients for its share of the training sets with private activation
+     *        and error buffers, after which the gradients are applied to the 
+     *        shared network parameters.
+     * 
+     * @param num_epochs    The number of epochs to train.
+     * @param learning_rate The learning rate, sets the adjustment rate of the
+     *                      network parameters upon error.
+     * @param batch_size    The number of training sets per parameter update. In
+     *                      synchronous mode each batch is split between the threads, 
+     *                      in Hogwild mode each thread uses batches of this size.
+     * @param num_threads   The number of threads to train on (default = the number
+     *                      of hardware threads).
+     * @param mode          Selects how the parameters are synchronized between the
+     *                      threads (default = synchronous).
      * 
      * @return True if training was performed, else false.
      ********************************************************************************/
-    bool Train(const std::size_t num_epochs, const double learning_rate = 0.01);
+    bool TrainParallel(const std::size_t num_epochs, 
+                       const Compute learning_rate,
+                       const std::size_t batch_size,
+                       const std::size_t num_threads = std::thread::hardware_concurrency(),
+                       const ParallelMode mode = ParallelMode::kSynchronous);
 
     /********************************************************************************
      * @brief Performs prediction with specified input values.
@@ -94,7 +396,50 @@ public:
      * 
      * @return Reference to vector holding the predicted output values.
      ********************************************************************************/
-    const std::vector<double>& Predict(const std::vector<double>& input);
+    const std::vector<Compute>& Predict(const std::vector<Compute>& input);
+
+    /********************************************************************************
+     * @brief Performs predictions with a batch of input sets in one pass over the
+     *        network parameters.
+     * 
+     * @param input  View of the input sets, one row per set and one column per input.
+     * @param output View of the buffer to write the predicted output values to, one
+     *               row per set and one column per output.
+     * 
+     * @return True if the predictions were performed, false if the output buffer
+     *         doesn't have room for all predictions.
+     ********************************************************************************/
+    bool PredictBatch(const MatrixView<const Compute>& input, const MatrixView<Compute>& output);
+
+    /********************************************************************************
+     * @brief Performs prediction with specified input values without modifying
+     *        the network. Safe to call concurrently from multiple threads as long
+     *        as each thread uses its own inference context.
+     * 
+     * @param input   Reference to vector holding input values.
+     * @param context Reference to the inference context holding the activations.
+     * 
+     * @return Reference to vector in the context holding the predicted output values.
+     ********************************************************************************/
+    const std::vector<Compute>& Predict(const std::vector<Compute>& input, 
+                                       BasicInferenceContext<T>& context) const;
+
+    /********************************************************************************
+     * @brief Performs predictions with a batch of input sets without modifying the
+     *        network. Safe to call concurrently from multiple threads as long as 
+     *        each thread uses its own inference context.
+     * 
+     * @param input   View of the input sets, one row per set and one column per input.
+     * @param output  View of the buffer to write the predicted output values to, one
+     *                row per set and one column per output.
+     * @param context Reference to the inference context holding the activations.
+     * 
+     * @return True if the predictions were performed, false if the output buffer
+     *         doesn't have room for all predictions.
+     ********************************************************************************/
+    bool PredictBatch(const MatrixView<const Compute>& input, 
+                      const MatrixView<Compute>& output,
+                      BasicInferenceContext<T>& context) const;
 
     /********************************************************************************
      * @brief Performs predictions with all input sets and prints the output.
@@ -103,25 +448,115 @@ public:
      * @param num_decimals The number of decimals to print (default = 0).
      * @param ostream      Reference to output stream (default = terminal print).
      ********************************************************************************/
-    void PrintPredictions(const std::vector<std::vector<double>>& input_sets,
+    void PrintPredictions(const std::vector<std::vector<Compute>>& input_sets,
                           const std::size_t num_decimals = 0,
                           std::ostream& ostream = std::cout);
 
+    /********************************************************************************
+     * @brief Prints the time spent in each phase of training and the number of
+     *        floating-point operations of each layer since the last training 
+     *        started. Only measured if the instrumentation is enabled at compile 
+     *        time (see instrumentation.hpp), in which case the profile is also 
+     *        printed to std::clog at the end of every training.
+     * 
+     * @param ostream Reference to output stream (default = std::clog).
+     ********************************************************************************/
+    void PrintProfile(std::ostream& ostream = std::clog) const;
+
 private:
 
-    void CheckNumTrainingSets();
-    void InitTrainOrderVector();
+    /********************************************************************************
+     * @brief Holds the batch, activation, error and gradient buffers of one 
+     *        training thread.
+     ********************************************************************************/
+    struct TrainingContext {
+        Matrix<Compute> input{};                            /* Input values of the batch. */
+        Matrix<Compute> reference{};                        /* Reference values of the batch. */
+        std::vector<Matrix<Compute>> output{};              /* Output values of each layer. */
+        std::vector<Matrix<Compute>> error{};               /* Errors of each layer. */
+        Arena gradients{};                                  /* Holds the gradients of all layers. */
+        std::vector<MatrixView<Compute>> weight_gradient{}; /* Weight gradients of each layer. */
+        std::vector<std::span<Compute>> bias_gradient{};    /* Bias gradients of each layer. */
+        double loss{};                                      /* Sum of the losses of the epoch. */
+    };
+
+    /********************************************************************************
+     * @brief Holds the buffers used when training on streamed sets.
+     ********************************************************************************/
+    struct StreamBuffers {
+        Matrix<Compute> input{};        /* Input values of the shuffle buffer. */
+        Matrix<Compute> output{};       /* Output values of the shuffle buffer. */
+        Matrix<Compute> chunk_input{};  /* Input values of the sets read. */
+        Matrix<Compute> chunk_output{}; /* Output values of the sets read. */
+        std::size_t size{};             /* The number of sets in the shuffle buffer. */
+        std::size_t num_batched{};      /* The number of sets in the training batch. */
+    };
+
+    void BindArena(void);
+    void BeginProfile(void);
+    void EndProfile(void) const;
+    MatrixView<const Compute> TrainingInput(void) const;
+    MatrixView<const Compute> TrainingOutput(void) const;
+    double ValidationLoss(void);
+    void InitTrainOrderVector(const std::size_t num_sets);
     void RandomizeTrainingOrder();
-    void Feedforward(const std::vector<double>& input);
-    void Backpropagate(const std::vector<double>& reference);
-    void Optimize(const std::vector<double>& input, const double learning_rate);
-
-    DenseLayer hidden_layer_ = DenseLayer(3, 2, ActFunc::kRelu);
-    DenseLayer output_layer_ = DenseLayer(1, 3, ActFunc::kTanh);
-    std::vector<std::vector<double>> train_input_{};
-    std::vector<std::vector<double>> train_output_{};
+    void Feedforward(const std::span<const Compute> input);
+    double Backpropagate(const std::span<const Compute> reference);
+    void Optimize(const std::span<const Compute> input, const Compute learning_rate);
+    template <typename EpochsFunction>
+    TrainingReport RunEpochs(const TrainingOptions& options, EpochsFunction&& train_epochs);
+    double TrainEpoch(const Compute learning_rate, const std::size_t batch_size);
+    double TrainStreamEpoch(DatasetReader<Compute>& reader, StreamBuffers& buffers,
+                            const Compute learning_rate, const std::size_t batch_size);
+    double TrainStreamSet(StreamBuffers& buffers, const std::size_t slot, 
+                          const Compute learning_rate, const std::size_t batch_size);
+    double TrainBatch(const std::size_t first, const std::size_t batch_size, 
+                      const Compute learning_rate);
+    template <typename LearningRate, typename EndEpoch>
+    void TrainParallelEpochs(const std::size_t num_epochs, const LearningRate& learning_rate,
+                             const std::size_t batch_size, const std::size_t num_threads,
+                             const ParallelMode mode, const EndEpoch& end_epoch);
+    void PrepareTrainingContext(TrainingContext& context, const std::size_t batch_size) const;
+    double ComputeGradients(TrainingContext& context, const std::size_t first, 
+                            const std::size_t num_sets) const;
+    double ComputeBatchGradients(TrainingContext& context, const std::size_t num_sets) const;
+    void ApplyGradients(const TrainingContext& context, const optimizer::UpdateStep& step, 
+                        const std::size_t thread, const std::size_t num_threads);
+    void ReduceGradients(std::vector<TrainingContext>& contexts, 
+                         const optimizer::UpdateStep& step,
+                         const std::size_t thread);
+
+    Arena arena_{};
+    std::vector<Layer> layers_{};
+    Matrix<Compute> train_input_{};
+    Matrix<Compute> train_output_{};
+    MatrixView<const Compute> external_input_{};
+    MatrixView<const Compute> external_output_{};
     std::vector<std::size_t> train_order_{};
+    Matrix<Compute> validation_input_{};
+    Matrix<Compute> validation_output_{};
+    Matrix<Compute> validation_prediction_{};
+    TrainingContext train_context_{};
+    BasicInferenceContext<T> context_{};
+    std::size_t num_updates_{};
 };
 
+/********************************************************************************
+ * @brief Neural network with double precision (the default).
+ ********************************************************************************/
+using NeuralNetwork = BasicNeuralNetwork<double>;
+
+/********************************************************************************
+ * @brief Inference context for neural networks with double precision.
+ ********************************************************************************/
+using InferenceContext = BasicInferenceContext<double>;
+
+extern template class BasicInferenceContext<double>;
+extern template class BasicInferenceContext<float>;
+extern template class BasicInferenceContext<BFloat16>;
+extern template class BasicNeuralNetwork<double>;
+extern template class BasicNeuralNetwork<float>;
+extern template class BasicNeuralNetwork<BFloat16>;
+
 } /* namespace machine_learning */
 } /* namespace yrgo */
\ No newline at end of file
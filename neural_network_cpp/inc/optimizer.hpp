@@ -0,0 +1,87 @@
+/********************************************************************************
+ * @brief Contains the optimizers used for adjusting the parameters of dense
+ *        layers. The state of an optimizer (velocities, moments) is stored by
+ *        the layers in buffers with the same layout as the parameters, and each
+ *        optimizer updates parameters and state in one fused, vectorized pass.
+ *
+ * @note Following the conventions of the dense layers, the gradients passed to
+ *       the optimizers point in the direction of decreasing loss, i.e. the
+ *       parameters are adjusted by adding (a function of) the gradients.
+ ********************************************************************************/
+#pragma once
+
+#include <cstddef>
+
+#include <scalar.hpp>
+
+namespace yrgo {
+namespace machine_learning {
+
+/********************************************************************************
+ * @brief Enumeration for selecting optimizer.
+ *
+ * @param kSgd      Plain stochastic gradient descent (no state).
+ * @param kMomentum Gradient descent with momentum (one state buffer).
+ * @param kNesterov Gradient descent with Nesterov momentum (one state buffer).
+ * @param kRmsProp  RMSProp, scaling by the root mean square of recent gradients
+ *                  (one state buffer).
+ * @param kAdam     Adam with bias correction (two state buffers).
+ * @param kAdamW    Adam with weight decay decoupled from the gradients (two state
+ *                  buffers).
+ ********************************************************************************/
+enum class OptimizerType { kSgd, kMomentum, kNesterov, kRmsProp, kAdam, kAdamW };
+
+/********************************************************************************
+ * @brief Holds the selected optimizer and its hyperparameters.
+ ********************************************************************************/
+struct OptimizerConfig {
+    OptimizerType type{OptimizerType::kSgd}; /* The optimizer to use. */
+    double momentum{0.9};                    /* Momentum, or decay of the first moment (Adam). */
+    double decay{0.999};                     /* Decay of the mean squared gradients. */
+    double epsilon{1e-8};                    /* Added to the root mean square (no division by 0). */
+    double weight_decay{};                   /* L2 penalty (decoupled for AdamW). */
+};
+
+namespace optimizer {
+
+/********************************************************************************
+ * @brief Describes one update of the parameters.
+ ********************************************************************************/
+struct UpdateStep {
+    double learning_rate{};   /* The learning rate. */
+    double gradient_scale{1}; /* Factor to scale the gradients with, e.g. 1 / batch size. */
+    std::size_t count{1};     /* Number of the update, starting at 1 (for Adam bias correction). */
+};
+
+/********************************************************************************
+ * @brief Provides the number of state buffers of specified optimizer, each with
+ *        one value per parameter.
+ *
+ * @param type The optimizer.
+ *
+ * @return The number of state buffers (0 - 2).
+ ********************************************************************************/
+std::size_t NumStateBuffers(const OptimizerType type);
+
+/********************************************************************************
+ * @brief Updates specified parameters and the corresponding optimizer state.
+ *
+ * @tparam T The scalar type of the parameters (double, float or BFloat16).
+ *
+ * @param config       The optimizer and its hyperparameters.
+ * @param step         Description of the update.
+ * @param gradient     Pointer to the gradients, one per parameter.
+ * @param parameters   Pointer to the parameters to update.
+ * @param state        Pointer to the state of the first parameter in the first state
+ *                     buffer (may be nullptr if the optimizer has no state).
+ * @param state_stride The distance in elements between the state buffers.
+ * @param size         The number of parameters to update.
+ ********************************************************************************/
+template <typename T>
+void Update(const OptimizerConfig& config, const UpdateStep& step,
+            const ComputeType<T>* gradient, T* parameters, ComputeType<T>* state,
+            const std::size_t state_stride, const std::size_t size);
+
+} /* namespace optimizer */
+} /* namespace machine_learning */
+} /* namespace yrgo */
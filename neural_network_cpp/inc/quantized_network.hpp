@@ -0,0 +1,210 @@
+/********************************************************************************
+ * @brief Contains an int8 post-training quantized version of neural networks,
+ *        used for fast inference with trained networks.
+ ********************************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <span>
+#include <vector>
+
+#include <dense_layer.hpp>
+#include <matrix.hpp>
+#include <neural_network.hpp>
+#include <utils.hpp>
+
+namespace yrgo {
+namespace machine_learning {
+
+/********************************************************************************
+ * @brief Dense layer with weights quantized to 8-bit integers. Each row of
+ *        weights has its own scale, while the input values are quantized with
+ *        one scale per layer, calibrated from a sample of input sets. The dot
+ *        products are accumulated with 32-bit integers, after which the bias
+ *        and the activation function are applied in single precision.
+ ********************************************************************************/
+class QuantizedDenseLayer {
+  public:
+
+    /********************************************************************************
+     * @brief Default constructor deleted.
+     ********************************************************************************/
+    QuantizedDenseLayer(void) = delete;
+
+    /********************************************************************************
+     * @brief Creates quantized copy of specified dense layer.
+     *
+     * @tparam T The scalar type of the dense layer.
+     *
+     * @param layer     Reference to the trained dense layer.
+     * @param max_input The largest absolute input value expected by the layer,
+     *                  which is mapped to the largest 8-bit value.
+     ********************************************************************************/
+    template <typename T>
+    QuantizedDenseLayer(const BasicDenseLayer<T>& layer, const double max_input);
+
+    /********************************************************************************
+     * @brief Provides the number of nodes in the layer.
+     ********************************************************************************/
+    std::size_t NumNodes(void) const { return bias_.size(); }
+
+    /********************************************************************************
+     * @brief Provides the number of weights per node in the layer.
+     ********************************************************************************/
+    std::size_t NumWeightsPerNode(void) const { return num_weights_per_node_; }
+
+    /********************************************************************************
+     * @brief Provides the size of the quantized parameters.
+     *
+     * @return The number of bytes used for weights, scales and bias values.
+     ********************************************************************************/
+    std::size_t SizeInBytes(void) const;
+
+    /********************************************************************************
+     * @brief Calculates the output of the layer.
+     *
+     * @param input  View of the input values (one per weight).
+     * @param output View of the buffer to write the output values to (one per node).
+     * @param buffer Reference to buffer holding the quantized input values.
+     ********************************************************************************/
+    void Feedforward(const std::span<const float> input, const std::span<float> output,
+                     std::vector<std::int8_t>& buffer) const;
+
+    /********************************************************************************
+     * @brief Calculates the output of the layer for a batch of input sets. The 
+     *        input sets are quantized once, after which each row of weights is 
+     *        multiplied with all quantized sets while it's cached.
+     *
+     * @param input  View of the input sets, one row per set.
+     * @param output View of the buffer to write the output values to, one row per set.
+     * @param buffer Reference to matrix holding the quantized input sets.
+     ********************************************************************************/
+    void FeedforwardBatch(const MatrixView<const float>& input, const MatrixView<float>& output,
+                          Matrix<std::int8_t>& buffer) const;
+
+  private:
+    utils::memory::AlignedVector<std::int8_t> weights_{}; /* Quantized weights, one row per node. */
+    std::vector<float> output_scale_{};                   /* Weight scale times input scale. */
+    std::vector<float> bias_{};                           /* Bias values. */
+    std::size_t num_weights_per_node_{};                  /* Number of weights per node. */
+    std::size_t weight_stride_{};                         /* Padded length of each row. */
+    float input_scale_{1.0f};                             /* Input value per quantization step. */
+    enum ActFunc act_func_{ActFunc::kRelu};               /* Selected activation function. */
+};
+
+/********************************************************************************
+ * @brief Holds the result of comparing a quantized network with the original.
+ ********************************************************************************/
+struct QuantizationReport {
+    std::size_t num_sets{};        /* The number of compared input sets. */
+    double max_error{};            /* The largest absolute difference of any output. */
+    double mean_error{};           /* The mean absolute difference of all outputs. */
+    std::size_t original_size{};   /* The size of the original parameters in bytes. */
+    std::size_t quantized_size{};  /* The size of the quantized parameters in bytes. */
+
+    /********************************************************************************
+     * @brief Prints the report.
+     *
+     * @param ostream Reference to output stream (default = terminal print).
+     ********************************************************************************/
+    void Print(std::ostream& ostream = std::cout) const;
+};
+
+/********************************************************************************
+ * @brief Int8 quantized copy of a trained neural network, used for inference
+ *        only. The weights take a quarter (float) or an eighth (double) of the
+ *        original memory and are multiplied with 8-bit integer kernels.
+ ********************************************************************************/
+class QuantizedNeuralNetwork {
+  public:
+
+    /********************************************************************************
+     * @brief Default constructor deleted.
+     ********************************************************************************/
+    QuantizedNeuralNetwork(void) = delete;
+
+    /********************************************************************************
+     * @brief Creates quantized copy of specified network. The input range of each
+     *        layer is calibrated by feeding the calibration sets through the
+     *        original network.
+     *
+     * @tparam T The scalar type of the network.
+     *
+     * @param network     Reference to the trained network.
+     * @param calibration View of representative input sets, one row per set.
+     *
+     * @throw std::invalid_argument if no calibration sets are passed.
+     ********************************************************************************/
+    template <typename T>
+    QuantizedNeuralNetwork(const BasicNeuralNetwork<T>& network,
+                           const MatrixView<const ComputeType<T>>& calibration);
+
+    /********************************************************************************
+     * @brief Provides the number of inputs in the network.
+     ********************************************************************************/
+    std::size_t NumInputs(void) const { return layers_.front().NumWeightsPerNode(); }
+
+    /********************************************************************************
+     * @brief Provides the number of outputs in the network.
+     ********************************************************************************/
+    std::size_t NumOutputs(void) const { return layers_.back().NumNodes(); }
+
+    /********************************************************************************
+     * @brief Provides the quantized layers of the network.
+     ********************************************************************************/
+    const std::vector<QuantizedDenseLayer>& Layers(void) const { return layers_; }
+
+    /********************************************************************************
+     * @brief Provides the size of the quantized parameters.
+     *
+     * @return The number of bytes used for weights, scales and bias values.
+     ********************************************************************************/
+    std::size_t SizeInBytes(void) const;
+
+    /********************************************************************************
+     * @brief Performs prediction with specified input values.
+     *
+     * @param input Reference to vector holding input values.
+     *
+     * @return Reference to vector holding the predicted output values.
+     ********************************************************************************/
+    const std::vector<float>& Predict(const std::vector<float>& input);
+
+    /********************************************************************************
+     * @brief Performs predictions with a batch of input sets.
+     *
+     * @param input  View of the input sets, one row per set and one column per input.
+     * @param output View of the buffer to write the predicted output values to, one
+     *               row per set and one column per output.
+     *
+     * @return True if the predictions were performed, false if the output buffer
+     *         doesn't have room for all predictions.
+     ********************************************************************************/
+    bool PredictBatch(const MatrixView<const float>& input, const MatrixView<float>& output);
+
+    /********************************************************************************
+     * @brief Compares the predictions of the quantized network with the predictions
+     *        of the original network.
+     *
+     * @tparam T The scalar type of the original network.
+     *
+     * @param network Reference to the original network.
+     * @param input   View of the input sets to compare with, one row per set.
+     *
+     * @return A report holding the prediction errors and the model sizes.
+     ********************************************************************************/
+    template <typename T>
+    QuantizationReport Compare(const BasicNeuralNetwork<T>& network,
+                               const MatrixView<const ComputeType<T>>& input);
+
+  private:
+    std::vector<QuantizedDenseLayer> layers_{};
+    std::vector<std::vector<float>> output_{};
+    std::vector<std::int8_t> buffer_{};
+    std::vector<Matrix<float>> batch_output_{};
+    Matrix<std::int8_t> batch_buffer_{};
+};
+
+} /* namespace machine_learning */
+} /* namespace yrgo */
@@ -0,0 +1,106 @@
+/********************************************************************************
+ * @brief Contains the scalar types the dense layers and neural networks can be
+ *        instantiated with, including a software emulated bfloat16 type.
+ ********************************************************************************/
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace yrgo {
+namespace machine_learning {
+
+/********************************************************************************
+ * @brief Software emulated bfloat16 (brain floating point) number, i.e. the
+ *        upper 16 bits of an IEEE 754 single precision number. Used as storage
+ *        type only, all arithmetic is performed in single precision.
+ ********************************************************************************/
+class BFloat16 {
+  public:
+
+    /********************************************************************************
+     * @brief Creates new bfloat16 number with the value 0.
+     ********************************************************************************/
+    constexpr BFloat16(void) = default;
+
+    /********************************************************************************
+     * @brief Creates new bfloat16 number by rounding specified value to the
+     *        nearest representable number (ties to even).
+     *
+     * @param value The value to convert.
+     ********************************************************************************/
+    BFloat16(const float value) : bits_{FromFloat(value)} {}
+
+    /********************************************************************************
+     * @brief Provides the value of the number in single precision.
+     *
+     * @return The value as a float (exact conversion).
+     ********************************************************************************/
+    operator float(void) const { return ToFloat(bits_); }
+
+    /********************************************************************************
+     * @brief Adds specified value to the number, rounding the result.
+     *
+     * @param value The value to add.
+     *
+     * @return Reference to the number.
+     ********************************************************************************/
+    BFloat16& operator+=(const float value) {
+        bits_ = FromFloat(ToFloat(bits_) + value);
+        return *this;
+    }
+
+    /********************************************************************************
+     * @brief Provides the raw bits of the number.
+     ********************************************************************************/
+    std::uint16_t Bits(void) const { return bits_; }
+
+  private:
+    static std::uint16_t FromFloat(const float value) {
+        std::uint32_t bits{};
+        std::memcpy(&bits, &value, sizeof(bits));
+        if ((bits & 0x7FFFFFFFU) > 0x7F800000U) { 
+            return static_cast<std::uint16_t>((bits >> 16) | 0x40U); /* Keep NaN quiet. */
+        }
+        bits += 0x7FFFU + ((bits >> 16) & 1U);
+        return static_cast<std::uint16_t>(bits >> 16);
+    }
+
+    static float ToFloat(const std::uint16_t bits) {
+        const std::uint32_t value_bits{static_cast<std::uint32_t>(bits) << 16};
+        float value{};
+        std::memcpy(&value, &value_bits, sizeof(value));
+        return value;
+    }
+
+    std::uint16_t bits_{};
+};
+
+/********************************************************************************
+ * @brief Provides the type used for arithmetic on values of the scalar type T.
+ *        Activations, errors, gradients and bias values are stored with this
+ *        type, while the weights are stored with type T.
+ *
+ * @tparam T The scalar (storage) type.
+ ********************************************************************************/
+template <typename T>
+struct ScalarTraits {
+    static_assert(std::is_floating_point<T>::value,
+        "Dense layers can only be instantiated with floating-point types!");
+    using Compute = T;
+};
+
+template <>
+struct ScalarTraits<BFloat16> {
+    using Compute = float;
+};
+
+/********************************************************************************
+ * @brief Shorthand for the arithmetic type of scalar type T.
+ ********************************************************************************/
+template <typename T>
+using ComputeType = typename ScalarTraits<T>::Compute;
+
+} /* namespace machine_learning */
+} /* namespace yrgo */
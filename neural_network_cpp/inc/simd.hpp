@@ -0,0 +1,206 @@
+/********************************************************************************
+ * @brief Contains helpers for writing elementwise kernels once with the GCC
+ *        vector extensions and running them with the widest vectors of the
+ *        active SIMD level (see linalg::ActiveSimdLevel).
+ *
+ * @note A kernel is a type with a member template Apply<V>(index), which
+ *       processes the elements starting at index as one V. V is either a
+ *       Vector<T, N> or T itself, the latter for the remaining elements. The
+ *       member must be declared [[gnu::always_inline]], so that it's compiled
+ *       for the instruction set of the loop it's inlined into.
+ ********************************************************************************/
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SIMD_X86_KERNELS
+#endif
+
+#include <linalg.hpp>
+
+namespace yrgo {
+namespace machine_learning {
+namespace simd {
+
+/********************************************************************************
+ * @brief Vector of N elements of type T.
+ ********************************************************************************/
+template <typename T, std::size_t N>
+using Vector [[gnu::vector_size(N * sizeof(T))]] = T;
+
+// GCC warns that the helpers below pass wide vectors with an ABI that depends on
+// the instruction set. The warning doesn't apply as long as no out-of-line call
+// is made, i.e. every function taking or returning a vector must be declared
+// [[gnu::always_inline]]: a regular call compiled for the baseline instruction
+// set corrupts the vectors, which shows in Debug (-O0) builds. The same holds for
+// kernels written with vector types in a source file. GCC reports the warnings
+// of the instantiated kernels at the end of the file, so such a file ignores
+// the warning from the kernels onwards rather than within a push/pop region.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+/********************************************************************************
+ * @brief Loads a V (vector or scalar) from specified unaligned address.
+ ********************************************************************************/
+template <typename V, typename T>
+[[gnu::always_inline]] inline V Load(const T* data) {
+    if constexpr (std::is_same_v<V, T>) {
+        return *data;
+    } else {
+        V value;
+        std::memcpy(&value, data, sizeof(value));
+        return value;
+    }
+}
+
+/********************************************************************************
+ * @brief Stores a V (vector or scalar) at specified unaligned address.
+ ********************************************************************************/
+template <typename T, typename V>
+[[gnu::always_inline]] inline void Store(T* data, const V& value) {
+    if constexpr (std::is_same_v<V, T>) {
+        *data = value;
+    } else {
+        std::memcpy(data, &value, sizeof(value));
+    }
+}
+
+/********************************************************************************
+ * @brief Reinterprets the bits of a V (vector or scalar) as a To of the same size.
+ *        Used instead of std::bit_cast, which isn't always inlined.
+ ********************************************************************************/
+template <typename To, typename V>
+[[gnu::always_inline]] inline To BitCast(const V& value) { return __builtin_bit_cast(To, value); }
+
+/********************************************************************************
+ * @brief Provides a V with all elements set to specified value.
+ ********************************************************************************/
+template <typename V>
+[[gnu::always_inline]] inline V Broadcast(const auto value) { return V{} + value; }
+
+/********************************************************************************
+ * @brief Provides the square root of each element of x (x >= 0). Unlike
+ *        std::sqrt in a loop, this doesn't prevent vectorization due to errno.
+ *
+ * @note The AVX intrinsics can't be inlined into this function, which is compiled
+ *       for the baseline instruction set. The wide vectors are only used in
+ *       functions compiled for AVX2 or AVX-512 (see Run), so the instructions
+ *       are emitted with inline assembly instead.
+ ********************************************************************************/
+template <typename V>
+[[gnu::always_inline]] inline V Sqrt(const V& x) {
+    if constexpr (std::is_floating_point_v<V>) {
+        return std::sqrt(x);
+    } else {
+        using T = std::remove_cvref_t<decltype(x[0])>;
+        V result;
+#ifdef SIMD_X86_KERNELS
+        constexpr bool kIsFloat{std::is_same_v<T, float>};
+        if constexpr (sizeof(V) == 16) {
+            if constexpr (kIsFloat) { return _mm_sqrt_ps(x); } else { return _mm_sqrt_pd(x); }
+        } else if constexpr (sizeof(V) == 32 && kIsFloat) {
+            asm("vsqrtps %1, %0" : "=x"(result) : "x"(x));
+            return result;
+        } else if constexpr (sizeof(V) == 32) {
+            asm("vsqrtpd %1, %0" : "=x"(result) : "x"(x));
+            return result;
+        } else if constexpr (sizeof(V) == 64 && kIsFloat) {
+            asm("vsqrtps %1, %0" : "=v"(result) : "v"(x));
+            return result;
+        } else if constexpr (sizeof(V) == 64) {
+            asm("vsqrtpd %1, %0" : "=v"(result) : "v"(x));
+            return result;
+        }
+#endif
+        for (std::size_t i{}; i < sizeof(V) / sizeof(T); ++i) { result[i] = std::sqrt(x[i]); }
+        return result;
+    }
+}
+
+/********************************************************************************
+ * @brief Provides a * b + c. Wide vectors always use the FMA instructions, while
+ *        GCC only contracts a * b + c where it sees fit, so the result is rounded
+ *        the same way in every function this is inlined into.
+ *
+ * @note The FMA intrinsics can't be inlined into this function either, see Sqrt.
+ *       Operand b may be taken from memory.
+ ********************************************************************************/
+template <typename V>
+[[gnu::always_inline]] inline V MultiplyAdd(const V& a, const V& b, const V& c) {
+#ifdef SIMD_X86_KERNELS
+    if constexpr (!std::is_floating_point_v<V> && sizeof(V) >= 32) {
+        V result{c};
+        constexpr bool kIsFloat{std::is_same_v<std::remove_cvref_t<decltype(a[0])>, float>};
+        if constexpr (sizeof(V) == 32 && kIsFloat) {
+            asm("vfmadd231ps %2, %1, %0" : "+x"(result) : "x"(a), "xm"(b));
+        } else if constexpr (sizeof(V) == 32) {
+            asm("vfmadd231pd %2, %1, %0" : "+x"(result) : "x"(a), "xm"(b));
+        } else if constexpr (kIsFloat) {
+            asm("vfmadd231ps %2, %1, %0" : "+v"(result) : "v"(a), "vm"(b));
+        } else {
+            asm("vfmadd231pd %2, %1, %0" : "+v"(result) : "v"(a), "vm"(b));
+        }
+        return result;
+    }
+#endif
+    return a * b + c;
+}
+
+#pragma GCC diagnostic pop
+
+/********************************************************************************
+ * @brief Runs specified kernel over size elements of type T with N elements
+ *        per vector, followed by one element at a time for the remainder.
+ ********************************************************************************/
+template <typename T, std::size_t N, typename Kernel>
+[[gnu::always_inline]] inline void RunVectors(const std::size_t size, const Kernel& kernel) {
+    std::size_t i{};
+    for (; i + N <= size; i += N) { kernel.template Apply<Vector<T, N>>(i); }
+    for (; i < size; ++i) { kernel.template Apply<T>(i); }
+}
+
+#ifdef SIMD_X86_KERNELS
+
+// --------------------------------------------------------------------------------
+template <typename T, typename Kernel>
+__attribute__((target("avx2,fma")))
+void RunAvx2(const std::size_t size, const Kernel& kernel) {
+    RunVectors<T, 32 / sizeof(T)>(size, kernel);
+}
+
+// --------------------------------------------------------------------------------
+template <typename T, typename Kernel>
+__attribute__((target("avx512f")))
+void RunAvx512(const std::size_t size, const Kernel& kernel) {
+    RunVectors<T, 64 / sizeof(T)>(size, kernel);
+}
+
+#endif /* SIMD_X86_KERNELS */
+
+/********************************************************************************
+ * @brief Runs specified kernel over size elements of type T (float or double)
+ *        with the widest vectors of the active SIMD level.
+ ********************************************************************************/
+template <typename T, typename Kernel>
+void Run(const std::size_t size, const Kernel& kernel) {
+#ifdef SIMD_X86_KERNELS
+    switch (linalg::ActiveSimdLevel()) {
+        case linalg::SimdLevel::kAvx512:
+            return RunAvx512<T>(size, kernel);
+        case linalg::SimdLevel::kAvx2:
+            return RunAvx2<T>(size, kernel);
+        default:
+            break;
+    }
+#endif
+    RunVectors<T, 16 / sizeof(T)>(size, kernel);
+}
+
+} /* namespace simd */
+} /* namespace machine_learning */
+} /* namespace yrgo */
@@ -0,0 +1,238 @@
+/********************************************************************************
+ * @brief Contains neural networks with a topology fixed at compile time, used
+ *        for low-latency inference with small trained networks.
+ ********************************************************************************/
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <activation.hpp>
+#include <dense_layer.hpp>
+#include <neural_network.hpp>
+
+namespace yrgo {
+namespace machine_learning {
+
+/********************************************************************************
+ * @brief Dense layer with the number of inputs and nodes and the activation
+ *        function fixed at compile time. The parameters are stored in arrays
+ *        and the weighted sums are expanded at compile time, so the layer has
+ *        no loops, branches or heap memory.
+ *
+ * @tparam T         The scalar type (float or double).
+ * @tparam NumInputs The number of inputs, i.e. the number of weights per node.
+ * @tparam NumNodes  The number of nodes.
+ * @tparam act_func  The activation function.
+ ********************************************************************************/
+template <typename T, std::size_t NumInputs, std::size_t NumNodes, ActFunc act_func>
+class StaticDenseLayer {
+    static_assert(std::is_floating_point_v<T>, "Static layers require float or double!");
+    static_assert(NumInputs > 0 && NumNodes > 0, "Static layers cannot be empty!");
+
+  public:
+    using Input = std::array<T, NumInputs>;  /* Input values of the layer. */
+    using Output = std::array<T, NumNodes>;  /* Output values of the layer. */
+
+    /********************************************************************************
+     * @brief Creates layer with all weights and bias values set to zero.
+     ********************************************************************************/
+    StaticDenseLayer(void) = default;
+
+    /********************************************************************************
+     * @brief Creates copy of specified dense layer.
+     *
+     * @tparam U The scalar type of the dense layer.
+     *
+     * @param layer Reference to the trained dense layer.
+     *
+     * @throw std::invalid_argument if the layer doesn't match the fixed topology
+     *        or activation function.
+     ********************************************************************************/
+    template <typename U>
+    explicit StaticDenseLayer(const BasicDenseLayer<U>& layer) {
+        if (layer.NumWeightsPerNode() != NumInputs || layer.NumNodes() != NumNodes) {
+            throw std::invalid_argument("Mismatching layer size, expected " +
+                                        std::to_string(NumNodes) + " nodes with " +
+                                        std::to_string(NumInputs) + " weights each!");
+        }
+        if (layer.ActivationFunction() != act_func) {
+            throw std::invalid_argument("Mismatching activation function!");
+        }
+        for (std::size_t i{}; i < NumNodes; ++i) {
+            const auto weights{layer.Weights(i)};
+            for (std::size_t j{}; j < NumInputs; ++j) {
+                weights_[i][j] = static_cast<T>(static_cast<ComputeType<U>>(weights[j]));
+            }
+            bias_[i] = static_cast<T>(layer.Bias()[i]);
+        }
+    }
+
+    /********************************************************************************
+     * @brief Provides the weights of the layer, one row per node.
+     ********************************************************************************/
+    const std::array<Input, NumNodes>& Weights(void) const { return weights_; }
+
+    /********************************************************************************
+     * @brief Provides the bias values of the layer, one per node.
+     ********************************************************************************/
+    const Output& Bias(void) const { return bias_; }
+
+    /********************************************************************************
+     * @brief Calculates the output of the layer.
+     *
+     * @param input Reference to the input values.
+     *
+     * @return The output values, one per node.
+     ********************************************************************************/
+    Output Feedforward(const Input& input) const {
+        return Feedforward(input, std::make_index_sequence<NumNodes>{});
+    }
+
+  private:
+    using Policy = activation::Policy<act_func>;
+
+    template <std::size_t... Node>
+    Output Feedforward(const Input& input, std::index_sequence<Node...>) const {
+        if constexpr (Policy::kElementwise) {
+            return {Policy::Output(Sum<Node>(input, std::make_index_sequence<NumInputs>{}))...};
+        } else {
+            Output output{Sum<Node>(input, std::make_index_sequence<NumInputs>{})...};
+            Policy::Apply(output.data(), NumNodes, fast_math::Accuracy::kExact);
+            return output;
+        }
+    }
+
+    template <std::size_t Node, std::size_t... Weight>
+    T Sum(const Input& input, std::index_sequence<Weight...>) const {
+        return (bias_[Node] + ... + (weights_[Node][Weight] * input[Weight]));
+    }
+
+    std::array<Input, NumNodes> weights_{}; /* Weights, one row per node. */
+    Output bias_{};                         /* Bias values, one per node. */
+};
+
+/********************************************************************************
+ * @brief Neural network with the topology and activation functions fixed at
+ *        compile time. Prediction is expanded into straight-line code over
+ *        arrays, without loops or heap memory, which makes it much faster than
+ *        the dynamic network for small models. The code size grows with the
+ *        number of weights, so it's intended for small models only. The
+ *        network is created from a network trained with BasicNeuralNetwork.
+ *
+ * @tparam T               The scalar type (float or double).
+ * @tparam act_func_hidden The activation function of the hidden layers.
+ * @tparam act_func_output The activation function of the output layer.
+ * @tparam NumNodes        The number of inputs followed by the number of nodes in
+ *                         each layer, e.g. 2, 3, 1 for two inputs, three hidden
+ *                         nodes and one output.
+ ********************************************************************************/
+template <typename T, ActFunc act_func_hidden, ActFunc act_func_output,
+          std::size_t... NumNodes>
+class BasicStaticNeuralNetwork {
+    static_assert(sizeof...(NumNodes) >= 2, "Static networks require inputs and outputs!");
+
+    static constexpr std::array<std::size_t, sizeof...(NumNodes)> kNumNodes{NumNodes...};
+    static constexpr std::size_t kNumLayers{sizeof...(NumNodes) - 1};
+
+    template <std::size_t Index>
+    using LayerType = StaticDenseLayer<T, kNumNodes[Index], kNumNodes[Index + 1],
+                                       Index + 1 < kNumLayers ? act_func_hidden
+                                                              : act_func_output>;
+
+    template <std::size_t... Index>
+    static std::tuple<LayerType<Index>...> LayerTuple(std::index_sequence<Index...>);
+
+  public:
+    using Input = std::array<T, kNumNodes.front()>; /* Input values of the network. */
+    using Output = std::array<T, kNumNodes.back()>; /* Output values of the network. */
+
+    /********************************************************************************
+     * @brief Creates network with all weights and bias values set to zero.
+     ********************************************************************************/
+    BasicStaticNeuralNetwork(void) = default;
+
+    /********************************************************************************
+     * @brief Creates copy of specified trained network.
+     *
+     * @tparam U The scalar type of the network.
+     *
+     * @param network Reference to the trained network.
+     *
+     * @throw std::invalid_argument if the network doesn't match the fixed topology
+     *        or activation functions.
+     ********************************************************************************/
+    template <typename U>
+    explicit BasicStaticNeuralNetwork(const BasicNeuralNetwork<U>& network) {
+        if (network.NumLayers() != kNumLayers) {
+            throw std::invalid_argument("Mismatching number of layers, expected " +
+                                        std::to_string(kNumLayers) + "!");
+        }
+        CopyLayers(network, std::make_index_sequence<kNumLayers>{});
+    }
+
+    /********************************************************************************
+     * @brief Provides the number of inputs in the network.
+     ********************************************************************************/
+    static constexpr std::size_t NumInputs(void) { return kNumNodes.front(); }
+
+    /********************************************************************************
+     * @brief Provides the number of outputs in the network.
+     ********************************************************************************/
+    static constexpr std::size_t NumOutputs(void) { return kNumNodes.back(); }
+
+    /********************************************************************************
+     * @brief Provides the number of layers in the network.
+     ********************************************************************************/
+    static constexpr std::size_t NumLayers(void) { return kNumLayers; }
+
+    /********************************************************************************
+     * @brief Provides specified layer of the network.
+     *
+     * @tparam Index The index of the layer, starting with the first hidden layer.
+     ********************************************************************************/
+    template <std::size_t Index>
+    const LayerType<Index>& Layer(void) const { return std::get<Index>(layers_); }
+
+    /********************************************************************************
+     * @brief Performs prediction with specified input values.
+     *
+     * @param input Reference to the input values.
+     *
+     * @return The predicted output values.
+     ********************************************************************************/
+    Output Predict(const Input& input) const { return Feedforward<0>(input); }
+
+  private:
+    template <typename U, std::size_t... Index>
+    void CopyLayers(const BasicNeuralNetwork<U>& network, std::index_sequence<Index...>) {
+        ((std::get<Index>(layers_) = LayerType<Index>{network.Layers()[Index]}), ...);
+    }
+
+    template <std::size_t Index>
+    auto Feedforward(const typename LayerType<Index>::Input& input) const {
+        const auto output{std::get<Index>(layers_).Feedforward(input)};
+        if constexpr (Index + 1 < kNumLayers) {
+            return Feedforward<Index + 1>(output);
+        } else {
+            return output;
+        }
+    }
+
+    decltype(LayerTuple(std::make_index_sequence<kNumLayers>{})) layers_{}; /* The layers. */
+};
+
+/********************************************************************************
+ * @brief Static neural network with double precision (the default).
+ ********************************************************************************/
+template <ActFunc act_func_hidden, ActFunc act_func_output, std::size_t... NumNodes>
+using StaticNeuralNetwork =
+    BasicStaticNeuralNetwork<double, act_func_hidden, act_func_output, NumNodes...>;
+
+} /* namespace machine_learning */
+} /* namespace yrgo */
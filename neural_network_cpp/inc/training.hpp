@@ -0,0 +1,231 @@
+/********************************************************************************
+ * @brief Contains the options and results of training neural networks, i.e.
+ *        learning-rate schedules, early stopping and training reports.
+ ********************************************************************************/
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <numbers>
+#include <vector>
+
+#include <activation.hpp>
+
+namespace yrgo {
+namespace machine_learning {
+
+/********************************************************************************
+ * @brief Enumeration for selecting how multi-threaded training synchronizes
+ *        the network parameters.
+ *
+ * @param kSynchronous Every batch is split between the threads, whose gradients
+ *                     are summed before one update is applied (same result as
+ *                     single-threaded training with the same batch size).
+ * @param kHogwild     Every thread trains on its own part of the training sets
+ *                     and updates the shared parameters without any locking.
+ *                     Updates from different threads may overwrite each other.
+ ********************************************************************************/
+enum class ParallelMode { kSynchronous, kHogwild };
+
+/********************************************************************************
+ * @brief Enumeration for selecting how the learning rate changes between epochs.
+ *
+ * @param kConstant The same learning rate is used for every epoch.
+ * @param kStep     The learning rate is multiplied by a factor at a fixed interval.
+ * @param kCosine   The learning rate follows half a cosine period from the initial
+ *                  learning rate towards a minimum, reached after the last epoch.
+ ********************************************************************************/
+enum class ScheduleType { kConstant, kStep, kCosine };
+
+/********************************************************************************
+ * @brief Holds the selected learning-rate schedule and its parameters. Warmup
+ *        can be combined with every schedule type.
+ ********************************************************************************/
+struct LearningRateSchedule {
+    ScheduleType type{ScheduleType::kConstant}; /* The schedule to use. */
+    std::size_t step_size{10};                  /* Epochs between each decay (step). */
+    double gamma{0.5};                          /* Factor of each decay (step). */
+    double min_learning_rate{};                 /* Learning rate after the last epoch (cosine). */
+    std::size_t warmup_epochs{};                /* Epochs of linear increase from 0. */
+};
+
+/********************************************************************************
+ * @brief Holds the metrics of one training epoch.
+ ********************************************************************************/
+struct EpochMetrics {
+    std::size_t epoch{};                       /* The epoch, starting at 1. */
+    double learning_rate{};                    /* The learning rate used during the epoch. */
+    double training_loss{};                    /* Mean loss of the training sets. */
+    double validation_loss{};                  /* Mean loss of the validation sets (NaN if none). */
+    std::chrono::duration<double> wall_time{}; /* Time since the training started. */
+};
+
+/********************************************************************************
+ * @brief Function called with the metrics of each training epoch.
+ ********************************************************************************/
+using EpochCallback = std::function<void(const EpochMetrics&)>;
+
+/********************************************************************************
+ * @brief Holds the options for training a neural network.
+ ********************************************************************************/
+struct TrainingOptions {
+    std::size_t num_epochs{1};                     /* The maximum number of epochs to train. */
+    double learning_rate{0.01};                    /* The initial learning rate. */
+    std::size_t batch_size{1};                     /* Training sets per parameter update. */
+    LearningRateSchedule schedule{};               /* The learning-rate schedule. */
+    std::size_t patience{};                        /* Epochs without improvement (0 = no limit). */
+    double min_improvement{};                      /* Least decrease counted as improvement. */
+    bool restore_best{true};                       /* Restore parameters of the best epoch. */
+    std::size_t num_threads{1};                    /* The number of threads to train on. */
+    ParallelMode mode{ParallelMode::kSynchronous}; /* Synchronization between the threads. */
+    EpochCallback on_epoch{};                      /* Called after each epoch (optional). */
+    std::size_t shuffle_buffer_size{4096};         /* Sets shuffled at once when streaming. */
+};
+
+/********************************************************************************
+ * @brief Holds the result of training a neural network.
+ ********************************************************************************/
+struct TrainingReport {
+    std::size_t num_epochs{};                  /* The number of epochs run. */
+    std::size_t best_epoch{};                  /* Epoch with the lowest validation loss. */
+    bool stopped_early{};                      /* Indicates if training stopped early. */
+    std::vector<double> training_loss{};       /* Training loss of each epoch. */
+    std::vector<double> validation_loss{};     /* Validation loss after each epoch. */
+    std::chrono::duration<double> wall_time{}; /* Total duration of the training. */
+};
+
+namespace training {
+
+/********************************************************************************
+ * @brief Provides the learning rate of specified epoch.
+ *
+ * @param schedule      The learning-rate schedule.
+ * @param learning_rate The initial learning rate.
+ * @param epoch         The epoch, starting at 0.
+ * @param num_epochs    The total number of epochs.
+ *
+ * @return The learning rate to use during the epoch.
+ ********************************************************************************/
+inline double LearningRate(const LearningRateSchedule& schedule, const double learning_rate,
+                           const std::size_t epoch, const std::size_t num_epochs) {
+    if (epoch < schedule.warmup_epochs) {
+        return learning_rate * static_cast<double>(epoch + 1) /
+            static_cast<double>(schedule.warmup_epochs + 1);
+    }
+    const auto decay_epoch{epoch - schedule.warmup_epochs};
+    switch (schedule.type) {
+        case ScheduleType::kStep: {
+            const auto num_steps{decay_epoch / std::max<std::size_t>(schedule.step_size, 1)};
+            return learning_rate * std::pow(schedule.gamma, static_cast<double>(num_steps));
+        }
+        case ScheduleType::kCosine: {
+            const auto num_decay_epochs{num_epochs - std::min(num_epochs, schedule.warmup_epochs)};
+            const auto progress{std::min(static_cast<double>(decay_epoch) / 
+                static_cast<double>(std::max<std::size_t>(num_decay_epochs, 1)), 1.0)};
+            return schedule.min_learning_rate + (learning_rate - schedule.min_learning_rate) *
+                0.5 * (1.0 + std::cos(std::numbers::pi * progress));
+        }
+        default:
+            return learning_rate;
+    }
+}
+
+/********************************************************************************
+ * @brief Indicates whether output layers with specified activation function are
+ *        trained with the cross-entropy loss, which is the case for softmax. 
+ *        Other output layers are trained with the mean squared error.
+ *
+ * @param act_func Activation function of the output layer.
+ *
+ * @return True if the cross-entropy is used, else false.
+ ********************************************************************************/
+constexpr bool UsesCrossEntropy(const ActFunc act_func) {
+    return act_func == ActFunc::kSoftmax;
+}
+
+/********************************************************************************
+ * @brief Provides the derivative to multiply the error (reference - output) of
+ *        an output node with. With softmax and the cross-entropy, the gradient of
+ *        the loss with respect to the weighted sum is reference - output, so the
+ *        derivative is 1.
+ *
+ * @tparam Act The activation policy of the output layer.
+ * @tparam T   The type of the output value.
+ *
+ * @param act    The activation policy.
+ * @param output The output value.
+ *
+ * @return The derivative.
+ ********************************************************************************/
+template <typename Act, typename T>
+T OutputDelta(const Act& act, const T output) {
+    if constexpr (UsesCrossEntropy(Act::kActFunc)) {
+        (void)act;
+        (void)output;
+        return T{1};
+    } else {
+        return act.Delta(output);
+    }
+}
+
+/********************************************************************************
+ * @brief Provides the contribution of one output value to the loss: the
+ *        cross-entropy for softmax outputs, else the squared error.
+ *
+ * @tparam T The type of the values.
+ *
+ * @param act_func  Activation function of the output layer.
+ * @param output    The predicted value.
+ * @param reference The reference value.
+ *
+ * @return The contribution to the loss, see LossScale.
+ ********************************************************************************/
+template <typename T>
+double LossTerm(const ActFunc act_func, const T output, const T reference) {
+    constexpr double kMinOutput{1e-12};
+    const auto y{static_cast<double>(output)}, r{static_cast<double>(reference)};
+    if (act_func == ActFunc::kSoftmax) { return -r * std::log(std::max(y, kMinOutput)); }
+    const double error{r - y};
+    return error * error;
+}
+
+/********************************************************************************
+ * @brief Provides the factor to multiply the sum of the loss terms of one
+ *        prediction with, i.e. 1 for the cross-entropy and 1 / size for the mean
+ *        squared error, which is averaged over the outputs.
+ *
+ * @param act_func Activation function of the output layer.
+ * @param size     The number of output values.
+ *
+ * @return The factor.
+ ********************************************************************************/
+inline double LossScale(const ActFunc act_func, const std::size_t size) {
+    return act_func == ActFunc::kSoftmax || size == 0 ? 1.0 : 1.0 / static_cast<double>(size);
+}
+
+/********************************************************************************
+ * @brief Provides the loss of one prediction: the cross-entropy for softmax
+ *        outputs, else the mean squared error.
+ *
+ * @tparam T The type of the values.
+ *
+ * @param act_func  Activation function of the output layer.
+ * @param output    Pointer to the predicted values.
+ * @param reference Pointer to the reference values.
+ * @param size      The number of values.
+ *
+ * @return The loss.
+ ********************************************************************************/
+template <typename T>
+double Loss(const ActFunc act_func, const T* output, const T* reference, const std::size_t size) {
+    double loss{};
+    for (std::size_t i{}; i < size; ++i) { loss += LossTerm(act_func, output[i], reference[i]); }
+    return loss * LossScale(act_func, size);
+}
+
+} /* namespace training */
+} /* namespace machine_learning */
+} /* namespace yrgo */
@@ -6,31 +6,154 @@
 
 #include <vector>
 #include <type_traits>
+#include <atomic>
+#include <bit>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <ctime>
 #include <cmath>
+#include <new>
+#include <random>
+#include <utility>
 
 namespace yrgo {
 namespace utils {
-namespace {
 namespace random {
 
 /********************************************************************************
- * @brief Initializes the random number generator. This function should be called
- *        before using generating any random numbers to ensure that each run of
- *        the program yields different numbers.
+ * @brief Pseudo-random number generator xoshiro256++ by Blackman and Vigna. 
+ *        Much faster than std::rand, with a period of 2^256 - 1 and no global
+ *        state. Satisfies the UniformRandomBitGenerator requirements, so it can
+ *        be used with the standard distributions and algorithms.
  ********************************************************************************/
-inline void Init(void) {
-    static bool rand_initialized{false};
-    if (!rand_initialized) {
-        std::srand(std::time(nullptr));
-        rand_initialized = true;
+class Xoshiro256 {
+  public:
+    using result_type = std::uint64_t;
+
+    /********************************************************************************
+     * @brief Creates new generator seeded with specified value.
+     * 
+     * @param seed The seed, any value (including 0) is permitted.
+     ********************************************************************************/
+    explicit Xoshiro256(const std::uint64_t seed = 0) { Seed(seed); }
+
+    /********************************************************************************
+     * @brief Reseeds the generator. The state is expanded from the seed with 
+     *        SplitMix64, so that similar seeds give unrelated sequences.
+     * 
+     * @param seed The seed, any value (including 0) is permitted.
+     ********************************************************************************/
+    void Seed(std::uint64_t seed) {
+        for (auto& word : state_) {
+            seed += 0x9E3779B97F4A7C15ULL;
+            auto z{seed};
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    /********************************************************************************
+     * @brief Generates the next 64 random bits.
+     ********************************************************************************/
+    std::uint64_t operator()(void) {
+        const auto result{RotateLeft(state_[0] + state_[3], 23) + state_[0]};
+        const auto t{state_[1] << 17};
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= t;
+        state_[3] = RotateLeft(state_[3], 45);
+        return result;
+    }
+
+    static constexpr std::uint64_t min(void) { return 0; }
+    static constexpr std::uint64_t max(void) { return UINT64_MAX; }
+
+  private:
+    static std::uint64_t RotateLeft(const std::uint64_t x, const int k) {
+        return (x << k) | (x >> (64 - k));
     }
+
+    std::uint64_t state_[4]{}; /* The state of the generator. */
+};
+
+/********************************************************************************
+ * @brief Provides the base seed of the generators, from which the generator of
+ *        each thread is seeded upon its first use.
+ ********************************************************************************/
+inline std::atomic<std::uint64_t>& BaseSeed(void) {
+    static std::atomic<std::uint64_t> seed{std::random_device{}() ^ 
+        static_cast<std::uint64_t>(std::time(nullptr)) << 32};
+    return seed;
+}
+
+/********************************************************************************
+ * @brief Provides the random number generator of the calling thread. Every
+ *        thread owns its own generator, so threads never contend for it.
+ ********************************************************************************/
+inline Xoshiro256& Generator(void) {
+    static std::atomic<std::uint64_t> num_threads{};
+    thread_local Xoshiro256 generator{BaseSeed() + 
+                                      0x632BE59BD9B4E019ULL * num_threads.fetch_add(1)};
+    return generator;
+}
+
+/********************************************************************************
+ * @brief Seeds the random number generator of the calling thread, which makes 
+ *        the following random numbers of the thread reproducible. Threads whose
+ *        generators haven't been used yet are seeded from the same value, each 
+ *        with its own stream.
+ * 
+ * @param seed The seed to use.
+ ********************************************************************************/
+inline void Seed(const std::uint64_t seed) {
+    BaseSeed() = seed;
+    Generator().Seed(seed);
+}
+
+/********************************************************************************
+ * @brief Initializes the random number generator of the calling thread, seeded 
+ *        from the time and a hardware entropy source unless Seed has been 
+ *        called. Calling this function is optional, since the generator is 
+ *        initialized upon its first use anyway.
+ ********************************************************************************/
+inline void Init(void) { static_cast<void>(Generator()); }
+
+/********************************************************************************
+ * @brief Multiplies two 64-bit numbers into a 128-bit product. The native 
+ *        128-bit type is used where available (64-bit targets), otherwise the
+ *        product is assembled from the 32-bit halves of the factors.
+ * 
+ * @param x   The first factor.
+ * @param y   The second factor.
+ * @param low Reference to variable storing the low 64 bits of the product.
+ * 
+ * @return The high 64 bits of the product.
+ ********************************************************************************/
+inline std::uint64_t MultiplyHigh(const std::uint64_t x, const std::uint64_t y, 
+                                  std::uint64_t& low) {
+#ifdef __SIZEOF_INT128__
+    const auto product{static_cast<unsigned __int128>(x) * y};
+    low = static_cast<std::uint64_t>(product);
+    return static_cast<std::uint64_t>(product >> 64);
+#else
+    const std::uint64_t x_low{x & 0xFFFFFFFF}, x_high{x >> 32};
+    const std::uint64_t y_low{y & 0xFFFFFFFF}, y_high{y >> 32};
+    const auto low_low{x_low * y_low};
+    const auto high_low{x_high * y_low};
+    const auto low_high{x_low * y_high};
+    const auto middle{(low_low >> 32) + (high_low & 0xFFFFFFFF) + low_high};
+    low = (middle << 32) | (low_low & 0xFFFFFFFF);
+    return x_high * y_high + (high_low >> 32) + (middle >> 32);
+#endif
 }
 
 /********************************************************************************
  * @brief Generates a random number in the range of specified min and max values.
+ *        Integers are drawn without the bias of the modulo method.
  * 
  * @tparam T The type of the random number to generate.
  * 
@@ -43,10 +166,149 @@ template <typename T>
 T GetNumber(const T min = 0, const T max = 100) {
     static_assert(std::is_arithmetic<T>::value, 
         "Non-arithmetic type selected for new random number!");
+    auto& generator{Generator()};
     if constexpr (std::is_integral<T>::value) {
-        return static_cast<T>((std::rand() % (max + 1 - min)) + min);
+        // Lemire's multiply-shift method, rejecting the few values that would
+        // make some numbers more likely than others.
+        const auto range{static_cast<std::uint64_t>(max) - static_cast<std::uint64_t>(min) + 1};
+        if (range == 0) { return static_cast<T>(generator()); }
+        std::uint64_t low{};
+        auto high{MultiplyHigh(generator(), range, low)};
+        if (low < range) {
+            const auto threshold{(0 - range) % range};
+            while (low < threshold) { high = MultiplyHigh(generator(), range, low); }
+        }
+        return static_cast<T>(static_cast<std::uint64_t>(min) + high);
+    } else {
+        // The top 53 bits give a uniformly distributed double in [0, 1).
+        const auto unit{static_cast<double>(generator() >> 11) * 0x1.0p-53};
+        return static_cast<T>(unit * (max - min) + min);
+    }
+}
+
+/********************************************************************************
+ * @brief Fills specified buffer with uniformly distributed random numbers drawn
+ *        from specified generator, one 64-bit draw at a time.
+ ********************************************************************************/
+template <typename T>
+void FillScalar(T* data, const std::size_t size, const T min, const T max, 
+                Xoshiro256& state) {
+    // The generator is copied, so that it's kept in registers.
+    auto generator{state};
+    const auto scale{max - min};
+    if constexpr (sizeof(T) == sizeof(float)) {
+        // Each 64-bit draw gives two floats, whose 23-bit mantissas are set to
+        // random bits with the exponent of 1, i.e. numbers in [1, 2).
+        std::size_t i{};
+        for (; i + 1 < size; i += 2) {
+            const auto bits{generator()};
+            const auto low{(static_cast<std::uint32_t>(bits) >> 9) | 0x3F800000U};
+            const auto high{(static_cast<std::uint32_t>(bits >> 32) >> 9) | 0x3F800000U};
+            data[i] = (std::bit_cast<float>(low) - 1.0f) * scale + min;
+            data[i + 1] = (std::bit_cast<float>(high) - 1.0f) * scale + min;
+        }
+        if (i < size) {
+            const auto bits{(static_cast<std::uint32_t>(generator()) >> 9) | 0x3F800000U};
+            data[i] = (std::bit_cast<float>(bits) - 1.0f) * scale + min;
+        }
+    } else {
+        for (std::size_t i{}; i < size; ++i) {
+            const auto bits{(generator() >> 12) | 0x3FF0000000000000ULL};
+            data[i] = static_cast<T>((std::bit_cast<double>(bits) - 1.0) * scale + min);
+        }
+    }
+    state = generator;
+}
+
+/********************************************************************************
+ * @brief Fills specified buffer like FillScalar, but with kNumLanes interleaved
+ *        xoshiro256++ generators seeded from specified generator. The states of
+ *        the generators are held in vectors, so all lanes are advanced and 
+ *        converted to numbers with the same instructions.
+ *
+ * @note The function is always inlined, so that it's compiled for the instruction
+ *       set of its caller.
+ ********************************************************************************/
+template <typename T>
+[[gnu::always_inline]] inline void FillLanes(T* data, const std::size_t size, const T min, 
+                                             const T max, Xoshiro256& generator) {
+    constexpr std::size_t kNumLanes{4};
+    using Lanes [[gnu::vector_size(kNumLanes * sizeof(std::uint64_t))]] = std::uint64_t;
+    using Numbers [[gnu::vector_size(sizeof(Lanes))]] = T;
+    constexpr auto kNumNumbers{sizeof(Lanes) / sizeof(T)};
+    Lanes state[4]{};
+    for (auto& word : state) {
+        for (std::size_t lane{}; lane < kNumLanes; ++lane) { word[lane] = generator(); }
+    }
+    const auto scale{max - min};
+    std::size_t i{};
+    for (; i + kNumNumbers <= size; i += kNumNumbers) {
+        const Lanes sum{state[0] + state[3]};
+        const Lanes bits{((sum << 23) | (sum >> 41)) + state[0]};
+        const Lanes t{state[1] << 17};
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = (state[3] << 45) | (state[3] >> 19);
+
+        Numbers numbers{};
+        if constexpr (sizeof(T) == sizeof(float)) {
+            using Words [[gnu::vector_size(sizeof(Lanes))]] = std::uint32_t;
+            const auto mantissas{(__builtin_bit_cast(Words, bits) >> 9) | 0x3F800000U};
+            numbers = __builtin_bit_cast(Numbers, mantissas);
+        } else {
+            numbers = __builtin_bit_cast(Numbers, (bits >> 12) | 0x3FF0000000000000ULL);
+        }
+        numbers = (numbers - T{1}) * scale + min;
+        std::memcpy(data + i, &numbers, sizeof(numbers));
+    }
+    FillScalar(data + i, size - i, min, max, generator);
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+
+// --------------------------------------------------------------------------------
+template <typename T>
+__attribute__((target("avx2")))
+void FillLanesAvx2(T* data, const std::size_t size, const T min, const T max, 
+                   Xoshiro256& generator) {
+    FillLanes(data, size, min, max, generator);
+}
+
+#endif
+
+/********************************************************************************
+ * @brief Fills specified buffer with uniformly distributed random numbers. The
+ *        generator is kept in registers and each random number is formed from 
+ *        the random bits without any division, so large buffers are filled 
+ *        many times faster than with repeated calls to GetNumber. Buffers of
+ *        at least 64 numbers are filled with interleaved generators in SIMD 
+ *        registers (AVX2 if supported by the CPU).
+ * 
+ * @tparam T The type of the random numbers (floating point).
+ * 
+ * @param data Pointer to the buffer to fill.
+ * @param size The number of random numbers to generate.
+ * @param min  The minimum permitted random number.
+ * @param max  The maximum permitted random number.
+ ********************************************************************************/
+template <typename T>
+void Fill(T* data, const std::size_t size, const T min, const T max) {
+    static_assert(std::is_floating_point<T>::value, 
+        "Non-floating-point type selected for bulk random numbers!");
+    // Seeding the lanes takes 16 draws, which doesn't pay off for small buffers.
+    constexpr std::size_t kMinLaneSize{64};
+    auto& generator{Generator()};
+    if (size < kMinLaneSize) {
+        FillScalar(data, size, min, max, generator);
+#if defined(__x86_64__) || defined(__i386__)
+    } else if (__builtin_cpu_supports("avx2")) {
+        FillLanesAvx2(data, size, min, max, generator);
+#endif
     } else {
-        return (std::rand() / static_cast<T>(RAND_MAX)) * (max - min) + min;
+        FillLanes(data, size, min, max, generator);
     }
 }
 
@@ -68,8 +330,12 @@ void InitVector(std::vector<T>& vector,
     static_assert(std::is_arithmetic<T>::value, 
         "Cannot assign random numbers for non-arithmetic types!");
     vector.resize(size);
-    for (auto& i : vector) {
-        i = GetNumber<T>(min, max);
+    if constexpr (std::is_floating_point<T>::value) {
+        Fill(vector.data(), vector.size(), min, max);
+    } else {
+        for (auto& i : vector) {
+            i = GetNumber<T>(min, max);
+        }
     }
 }
 
@@ -94,14 +360,13 @@ void InitVector(std::vector<std::vector<T>>& vector,
         "Cannot assign random numbers for non-arithmetic types!");
     vector.resize(num_columns, std::vector<T>(num_rows));
     for (auto& i : vector) {
-        for (auto& j : i) {
-            j = GetNumber<T>(min, max);
-        }
+        InitVector<T>(i, i.size(), min, max);
     }
 }
 
 /********************************************************************************
- * @brief Shuffle the content of one-dimensional vector.
+ * @brief Shuffle the content of one-dimensional vector with the Fisher-Yates
+ *        algorithm, so that every permutation is equally likely.
  * 
  * @tparam T The vector type.
  * 
@@ -109,16 +374,15 @@ void InitVector(std::vector<std::vector<T>>& vector,
  ********************************************************************************/
 template <typename T>
 void ShuffleVector(std::vector<T>& vector) {
-    for (size_t i{}; i < vector.size(); ++i) {
-        const auto r{static_cast<std::size_t>(std::rand() % vector.size())};
-        const auto temp{vector[i]};
-        vector[i] = vector[r];
-        vector[r] = temp;
+    for (std::size_t i{vector.size()}; i > 1; --i) {
+        const auto j{GetNumber<std::size_t>(0, i - 1)};
+        std::swap(vector[i - 1], vector[j]);
     }
 }
 
 /********************************************************************************
- * @brief Shuffle the content of two-dimensional vector.
+ * @brief Shuffle the content of two-dimensional vector, see ShuffleVector. The
+ *        rows are swapped without being copied.
  * 
  * @tparam T The vector type.
  * 
@@ -126,15 +390,81 @@ void ShuffleVector(std::vector<T>& vector) {
  ********************************************************************************/
 template <typename T>
 void ShuffleVector(std::vector<std::vector<T>>& vector) {
-    for (size_t i{}; i < vector.size(); ++i) {
-        const auto r{static_cast<std::size_t>(std::rand() % vector.size())};
-        const auto temp{vector[i]};
-        vector[i] = vector[r];
-        vector[r] = temp;
-    }
+    ShuffleVector<std::vector<T>>(vector);
 }
 } /* namespace random */
 
+namespace memory {
+
+/********************************************************************************
+ * @brief Default alignment in bytes for numeric buffers (one cache line).
+ ********************************************************************************/
+constexpr std::size_t kCacheLineSize{64};
+
+/********************************************************************************
+ * @brief Allocator providing memory aligned to specified boundary, which makes
+ *        it possible to store numeric buffers at cache line boundaries.
+ * 
+ * @tparam T The type of the elements to allocate.
+ * @tparam Alignment The alignment in bytes (default = one cache line).
+ ********************************************************************************/
+template <typename T, std::size_t Alignment = kCacheLineSize>
+struct AlignedAllocator {
+    static_assert(Alignment >= alignof(T) && (Alignment & (Alignment - 1)) == 0,
+        "Alignment must be a power of two no smaller than the alignment of T!");
+    using value_type = T;
+
+    template <typename U>
+    struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+    AlignedAllocator(void) noexcept = default;
+
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+    T* allocate(const std::size_t size) {
+        return static_cast<T*>(::operator new(size * sizeof(T), std::align_val_t{Alignment}));
+    }
+
+    void deallocate(T* data, const std::size_t) noexcept {
+        ::operator delete(data, std::align_val_t{Alignment});
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept { return false; }
+};
+
+/********************************************************************************
+ * @brief Vector whose data is aligned to specified boundary.
+ * 
+ * @tparam T The type of the elements.
+ * @tparam Alignment The alignment in bytes (default = one cache line).
+ ********************************************************************************/
+template <typename T, std::size_t Alignment = kCacheLineSize>
+using AlignedVector = std::vector<T, AlignedAllocator<T, Alignment>>;
+
+/********************************************************************************
+ * @brief Rounds specified number of elements up so that a row of that many 
+ *        elements fills a whole number of aligned blocks.
+ * 
+ * @tparam T The type of the elements.
+ * @tparam Alignment The alignment in bytes (default = one cache line).
+ * 
+ * @param num_elements The number of elements to round up.
+ * 
+ * @return The padded number of elements.
+ ********************************************************************************/
+template <typename T, std::size_t Alignment = kCacheLineSize>
+constexpr std::size_t PaddedSize(const std::size_t num_elements) {
+    constexpr auto block{Alignment / sizeof(T) > 0 ? Alignment / sizeof(T) : 1};
+    return (num_elements + block - 1) / block * block;
+}
+
+} /* namespace memory */
+
 namespace math {
 
 /********************************************************************************
@@ -271,6 +601,5 @@ constexpr double Relu(const double x) { return x > 0 ? x : 0; }
 constexpr double ReluDelta(const double x) { return x > 0 ? 1 : 0; }
 
 } /* namespace math */
-} /* namespace */
 } /* namespace utils */
 } /* namespace yrgo */
\ No newline at end of file
@@ -0,0 +1,288 @@
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include <dataset.hpp>
+
+namespace yrgo {
+namespace machine_learning {
+
+namespace {
+
+// --------------------------------------------------------------------------------
+[[noreturn]] void ThrowInvalidLine(const std::string& path, const std::size_t line_number) {
+    throw std::runtime_error("Invalid CSV file " + path + ": malformed line " +
+                             std::to_string(line_number) + "!");
+}
+
+// --------------------------------------------------------------------------------
+bool IsBlank(const char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+/********************************************************************************
+ * @brief Parses specified number of delimited values from a line.
+ *
+ * @return True if exactly the specified number of values were parsed.
+ ********************************************************************************/
+template <typename T>
+bool ParseLine(const std::string& line, const char delimiter, T* values,
+               const std::size_t num_values) {
+    const char* position{line.data()};
+    const char* const end{line.data() + line.size()};
+    for (std::size_t i{}; i < num_values; ++i) {
+        while (position < end && IsBlank(*position)) { ++position; }
+        const auto [last, error]{std::from_chars(position, end, values[i])};
+        if (error != std::errc{}) { return false; }
+        position = last;
+        while (position < end && IsBlank(*position)) { ++position; }
+        if (i + 1 < num_values) {
+            if (position == end || *position != delimiter) { return false; }
+            ++position;
+        }
+    }
+    return position == end;
+}
+
+// --------------------------------------------------------------------------------
+std::size_t ValueSize(const BinaryFormat format) {
+    return format == BinaryFormat::kFloat64 ? sizeof(double) : sizeof(float);
+}
+
+// --------------------------------------------------------------------------------
+template <typename Stored, typename T>
+void ConvertRow(const char* bytes, T* input, const std::size_t num_inputs, T* output,
+                const std::size_t num_outputs) {
+    // The raw bytes may be unaligned for Stored, so each value is copied out.
+    for (std::size_t i{}; i < num_inputs + num_outputs; ++i) {
+        Stored value;
+        std::memcpy(&value, bytes + i * sizeof(Stored), sizeof(Stored));
+        if (i < num_inputs) {
+            input[i] = static_cast<T>(value);
+        } else {
+            output[i - num_inputs] = static_cast<T>(value);
+        }
+    }
+}
+
+} /* namespace */
+
+// --------------------------------------------------------------------------------
+template <typename T>
+CsvReader<T>::CsvReader(const std::string& path, const std::size_t num_inputs,
+                        const std::size_t num_outputs, const bool has_header,
+                        const char delimiter)
+    : file_{path}
+    , path_{path}
+    , num_inputs_{num_inputs}
+    , num_outputs_{num_outputs}
+    , has_header_{has_header}
+    , delimiter_{delimiter} {
+    if (!file_) { throw std::runtime_error("Failed to open CSV file " + path + "!"); }
+    values_.resize(num_inputs + num_outputs);
+    Rewind();
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+std::size_t CsvReader<T>::Read(const MatrixView<T>& input, const MatrixView<T>& output) {
+    const auto max_sets{std::min(input.NumRows(), output.NumRows())};
+    std::size_t num_sets{};
+    while (num_sets < max_sets && std::getline(file_, line_)) {
+        ++line_number_;
+        if (std::all_of(line_.begin(), line_.end(), IsBlank)) { continue; }
+        if (!ParseLine(line_, delimiter_, values_.data(), values_.size())) {
+            ThrowInvalidLine(path_, line_number_);
+        }
+        std::copy_n(values_.begin(), num_inputs_, input.Row(num_sets));
+        std::copy_n(values_.begin() + num_inputs_, num_outputs_, output.Row(num_sets));
+        ++num_sets;
+    }
+    return num_sets;
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+void CsvReader<T>::Rewind(void) {
+    file_.clear();
+    file_.seekg(0);
+    line_number_ = 0;
+    if (has_header_ && std::getline(file_, line_)) { ++line_number_; }
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+BinaryReader<T>::BinaryReader(const std::string& path, const std::size_t num_inputs,
+                              const std::size_t num_outputs, const BinaryFormat format)
+    : file_{path, std::ios::binary | std::ios::ate}
+    , num_inputs_{num_inputs}
+    , num_outputs_{num_outputs}
+    , format_{format} {
+    if (!file_) { throw std::runtime_error("Failed to open binary file " + path + "!"); }
+    const auto file_size{static_cast<std::size_t>(file_.tellg())};
+    const auto set_size{(num_inputs + num_outputs) * ValueSize(format)};
+    if (set_size == 0 || file_size % set_size != 0) {
+        throw std::runtime_error("Invalid binary file " + path + ": size isn't a multiple of " +
+                                 std::to_string(set_size) + " bytes!");
+    }
+    num_sets_ = file_size / set_size;
+    Rewind();
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+std::size_t BinaryReader<T>::Read(const MatrixView<T>& input, const MatrixView<T>& output) {
+    const auto set_size{(num_inputs_ + num_outputs_) * ValueSize(format_)};
+    const auto num_sets{std::min({input.NumRows(), output.NumRows(), num_sets_ - next_set_})};
+    buffer_.resize(num_sets * set_size);
+    if (!file_.read(buffer_.data(), static_cast<std::streamsize>(buffer_.size()))) {
+        throw std::runtime_error("Failed to read binary file!");
+    }
+    for (std::size_t i{}; i < num_sets; ++i) {
+        const char* bytes{buffer_.data() + i * set_size};
+        if (format_ == BinaryFormat::kFloat64) {
+            ConvertRow<double>(bytes, input.Row(i), num_inputs_, output.Row(i), num_outputs_);
+        } else {
+            ConvertRow<float>(bytes, input.Row(i), num_inputs_, output.Row(i), num_outputs_);
+        }
+    }
+    next_set_ += num_sets;
+    return num_sets;
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+void BinaryReader<T>::Rewind(void) {
+    file_.clear();
+    file_.seekg(0);
+    next_set_ = 0;
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+PrefetchReader<T>::PrefetchReader(DatasetReader<T>& source, const std::size_t chunk_size)
+    : source_{source} {
+    for (auto& chunk : chunks_) {
+        chunk.input.Resize(std::max<std::size_t>(chunk_size, 1), source.NumInputs());
+        chunk.output.Resize(std::max<std::size_t>(chunk_size, 1), source.NumOutputs());
+    }
+    thread_ = std::thread{&PrefetchReader::Run, this};
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+PrefetchReader<T>::~PrefetchReader(void) {
+    // Exceptions of the pending read are of no interest anymore.
+    try {
+        Wait();
+    } catch (...) {}
+    {
+        const std::lock_guard lock{mutex_};
+        stopped_ = true;
+    }
+    condition_.notify_all();
+    thread_.join();
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+std::size_t PrefetchReader<T>::Read(const MatrixView<T>& input, const MatrixView<T>& output) {
+    const auto max_sets{std::min(input.NumRows(), output.NumRows())};
+    std::size_t num_sets{};
+    while (num_sets < max_sets) {
+        auto& chunk{chunks_[current_]};
+        if (chunk.position == chunk.size) {
+            if (!pending_) { Fetch(); }
+            const auto size{Wait()};
+            if (size == 0) { break; }
+
+            // Consume the prefetched chunk while the next one is read into the
+            // chunk just consumed.
+            current_ = 1 - current_;
+            chunks_[current_].size = size;
+            chunks_[current_].position = 0;
+            Fetch();
+            continue;
+        }
+        const auto num_copied{std::min(max_sets - num_sets, chunk.size - chunk.position)};
+        for (std::size_t i{}; i < num_copied; ++i) {
+            std::copy_n(chunk.input.Row(chunk.position + i), NumInputs(),
+                        input.Row(num_sets + i));
+            std::copy_n(chunk.output.Row(chunk.position + i), NumOutputs(),
+                        output.Row(num_sets + i));
+        }
+        chunk.position += num_copied;
+        num_sets += num_copied;
+    }
+    return num_sets;
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+void PrefetchReader<T>::Rewind(void) {
+    Wait();
+    source_.Rewind();
+    for (auto& chunk : chunks_) {
+        chunk.size = 0;
+        chunk.position = 0;
+    }
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+void PrefetchReader<T>::Fetch(void) {
+    {
+        const std::lock_guard lock{mutex_};
+        requested_ = true;
+    }
+    pending_ = true;
+    condition_.notify_all();
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+std::size_t PrefetchReader<T>::Wait(void) {
+    if (!pending_) { return 0; }
+    pending_ = false;
+    std::unique_lock lock{mutex_};
+    condition_.wait(lock, [this]() { return !requested_; });
+    if (error_) { std::rethrow_exception(std::exchange(error_, nullptr)); }
+    return fetched_size_;
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+void PrefetchReader<T>::Run(void) {
+    std::unique_lock lock{mutex_};
+    while (true) {
+        condition_.wait(lock, [this]() { return requested_ || stopped_; });
+        if (stopped_) { return; }
+
+        // The chunk not being consumed is read into, which the consuming thread 
+        // doesn't touch until the prefetch has been waited for.
+        auto& next{chunks_[1 - current_]};
+        lock.unlock();
+        std::size_t size{};
+        std::exception_ptr error{};
+        try {
+            size = source_.Read(next.input.View(), next.output.View());
+        } catch (...) {
+            error = std::current_exception();
+        }
+        lock.lock();
+        fetched_size_ = size;
+        error_ = error;
+        requested_ = false;
+        condition_.notify_all();
+    }
+}
+
+template class CsvReader<double>;
+template class CsvReader<float>;
+template class BinaryReader<double>;
+template class BinaryReader<float>;
+template class PrefetchReader<double>;
+template class PrefetchReader<float>;
+
+} /* namespace machine_learning */
+} /* namespace yrgo */
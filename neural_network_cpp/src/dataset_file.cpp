@@ -0,0 +1,172 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <dataset_file.hpp>
+
+namespace yrgo {
+namespace machine_learning {
+
+namespace {
+
+// --------------------------------------------------------------------------------
+std::uint64_t AlignOffset(const std::uint64_t offset) {
+    constexpr auto kAlignment{utils::memory::kCacheLineSize};
+    return (offset + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+void WriteBlock(std::ofstream& file, const MatrixView<const T>& block,
+                const std::uint64_t stride, const std::uint64_t offset) {
+    const auto position{static_cast<std::uint64_t>(file.tellp())};
+    const std::vector<char> padding(offset - position, 0);
+    file.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+
+    // Each row is padded to the stride so that the mapped rows are aligned.
+    std::vector<T> row(stride, T{});
+    for (std::size_t i{}; i < block.NumRows(); ++i) {
+        std::copy_n(block.Row(i), block.NumColumns(), row.begin());
+        file.write(reinterpret_cast<const char*>(row.data()),
+                   static_cast<std::streamsize>(row.size() * sizeof(T)));
+    }
+}
+
+// --------------------------------------------------------------------------------
+bool IsInFile(const std::uint64_t offset, const std::uint64_t num_rows,
+              const std::uint64_t row_size, const std::uint64_t file_size) {
+    return row_size > 0 && offset <= file_size && num_rows <= (file_size - offset) / row_size;
+}
+
+// --------------------------------------------------------------------------------
+[[noreturn]] void ThrowInvalidFile(const std::string& path, const std::string& reason) {
+    throw std::runtime_error("Invalid dataset file " + path + ": " + reason + "!");
+}
+
+} /* namespace */
+
+namespace dataset_file {
+
+// --------------------------------------------------------------------------------
+template <typename T>
+bool Save(const MatrixView<const T>& input, const MatrixView<const T>& output,
+          const std::string& path) {
+    const auto has_output{output.NumColumns() > 0};
+    if (has_output && output.NumRows() != input.NumRows()) { return false; }
+    FileHeader header{};
+    std::copy(std::begin(kMagic), std::end(kMagic), header.magic);
+    header.version = kVersion;
+    header.value_type = ValueTypeOf<T>();
+    header.num_sets = input.NumRows();
+    header.num_inputs = input.NumColumns();
+    header.num_outputs = has_output ? output.NumColumns() : 0;
+    header.input_stride = utils::memory::PaddedSize<T>(header.num_inputs);
+    header.output_stride = utils::memory::PaddedSize<T>(header.num_outputs);
+    header.input_offset = AlignOffset(sizeof(FileHeader));
+    header.file_size = header.input_offset + header.num_sets * header.input_stride * sizeof(T);
+    if (has_output) {
+        header.output_offset = AlignOffset(header.file_size);
+        header.file_size = header.output_offset +
+            header.num_sets * header.output_stride * sizeof(T);
+    }
+
+    std::ofstream file{path, std::ios::binary | std::ios::trunc};
+    if (!file) { return false; }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    WriteBlock(file, input, header.input_stride, header.input_offset);
+    if (has_output) { WriteBlock(file, output, header.output_stride, header.output_offset); }
+    return static_cast<bool>(file.flush());
+}
+
+} /* namespace dataset_file */
+
+// --------------------------------------------------------------------------------
+template <typename T>
+MappedDataset<T>::MappedDataset(const std::string& path) {
+    using namespace dataset_file;
+    const auto fd{open(path.c_str(), O_RDONLY)};
+    if (fd < 0) { throw std::runtime_error("Failed to open dataset file " + path + "!"); }
+    struct stat status{};
+    if (fstat(fd, &status) != 0 || status.st_size < static_cast<off_t>(sizeof(FileHeader))) {
+        close(fd);
+        ThrowInvalidFile(path, "file too small");
+    }
+    size_ = static_cast<std::size_t>(status.st_size);
+    data_ = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data_ == MAP_FAILED) {
+        data_ = nullptr;
+        throw std::runtime_error("Failed to map dataset file " + path + "!");
+    }
+
+    // Release the mapping if the validation below fails, since the destructor
+    // isn't run for objects whose constructor throws.
+    try {
+        const auto* bytes{static_cast<const char*>(data_)};
+        FileHeader header{};
+        std::memcpy(&header, bytes, sizeof(header));
+        if (!std::equal(std::begin(kMagic), std::end(kMagic), header.magic)) {
+            ThrowInvalidFile(path, "unknown format");
+        }
+        if (header.version != kVersion) { ThrowInvalidFile(path, "unsupported version"); }
+        if (header.value_type != ValueTypeOf<T>()) {
+            ThrowInvalidFile(path, "mismatching value type");
+        }
+        const auto has_output{header.num_outputs > 0};
+        if (header.file_size != size_ || header.num_inputs == 0 ||
+            header.input_stride < header.num_inputs || header.input_stride > size_ ||
+            header.output_stride < header.num_outputs || header.output_stride > size_ ||
+            header.input_offset % alignof(T) != 0 || header.output_offset % alignof(T) != 0 ||
+            !IsInFile(header.input_offset, header.num_sets, header.input_stride * sizeof(T),
+                      size_) ||
+            (has_output && !IsInFile(header.output_offset, header.num_sets,
+                                     header.output_stride * sizeof(T), size_))) {
+            ThrowInvalidFile(path, "corrupt header");
+        }
+        input_ = {reinterpret_cast<const T*>(bytes + header.input_offset), header.num_sets,
+                  header.num_inputs, header.input_stride};
+        if (has_output) {
+            output_ = {reinterpret_cast<const T*>(bytes + header.output_offset),
+                       header.num_sets, header.num_outputs, header.output_stride};
+        }
+    } catch (...) {
+        munmap(data_, size_);
+        throw;
+    }
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+MappedDataset<T>::~MappedDataset(void) {
+    if (data_ != nullptr) { munmap(data_, size_); }
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+std::size_t MappedDataset<T>::Read(const MatrixView<T>& input, const MatrixView<T>& output) {
+    const auto num_sets{std::min({input.NumRows(), output.NumRows(), NumSets() - next_set_})};
+    for (std::size_t i{}; i < num_sets; ++i) {
+        std::copy_n(input_.Row(next_set_ + i), NumInputs(), input.Row(i));
+        std::copy_n(output_.Row(next_set_ + i), NumOutputs(), output.Row(i));
+    }
+    next_set_ += num_sets;
+    return num_sets;
+}
+
+template bool dataset_file::Save(const MatrixView<const double>&,
+                                 const MatrixView<const double>&, const std::string&);
+template bool dataset_file::Save(const MatrixView<const float>&,
+                                 const MatrixView<const float>&, const std::string&);
+
+template class MappedDataset<double>;
+template class MappedDataset<float>;
+
+} /* namespace machine_learning */
+} /* namespace yrgo */
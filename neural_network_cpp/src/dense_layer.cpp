@@ -1,75 +1,404 @@
+#include <algorithm>
+
 #include "dense_layer.hpp"
+#include "linalg.hpp"
 
 namespace yrgo {
 namespace machine_learning {
 
-namespace {
+// --------------------------------------------------------------------------------
+template <typename T>
+BasicDenseLayer<T>::BasicDenseLayer(const std::size_t num_nodes,
+                                    const std::size_t num_weights_per_node,
+                                    const enum ActFunc act_func) 
+    : num_weights_per_node_{num_weights_per_node}
+    , weight_stride_{utils::memory::PaddedSize<T>(num_weights_per_node)}
+    , act_func_{act_func} {
+    utils::random::Init();
+    buffers_ = Buffers{num_nodes, num_nodes * weight_stride_, 0};
+    utils::random::Fill<Compute>(buffers_.bias.data(), num_nodes, 0, 1);
+    std::vector<Compute> row(num_weights_per_node);
+    for (std::size_t i{}; i < num_nodes; ++i) {
+        utils::random::Fill<Compute>(row.data(), row.size(), 0, 1);
+        std::transform(row.begin(), row.end(), Weights(i).begin(), 
+                       [](const Compute weight) { return static_cast<T>(weight); });
+    }
+}
 
 // --------------------------------------------------------------------------------
-double GetActFuncOutput(const double sum, const enum ActFunc act_func) {
-    return act_func == ActFunc::kRelu ?
-        utils::math::Relu(sum) : utils::math::Tanh(sum);
+template <typename T>
+BasicDenseLayer<T>::BasicDenseLayer(const BasicDenseLayer& source, const Arena& source_arena, 
+                                    Arena& arena)
+    : buffers_{}
+    , num_weights_per_node_{source.num_weights_per_node_}
+    , weight_stride_{source.weight_stride_}
+    , act_func_{source.act_func_}
+    , accuracy_{source.accuracy_}
+    , batch_output_{source.batch_output_}
+    , batch_error_{source.batch_error_}
+    , weight_gradient_{source.weight_gradient_}
+    , bias_gradient_{source.bias_gradient_}
+    , optimizer_{source.optimizer_}
+    , num_updates_{source.num_updates_}
+    , flops_{source.flops_} {
+    buffers_.Rebase(source.buffers_, source_arena, arena);
 }
 
 // --------------------------------------------------------------------------------
-double GetActFuncDelta(const double output, const enum ActFunc act_func) {
-    return act_func == ActFunc::kRelu ?
-        utils::math::ReluDelta(output) : utils::math::TanhDelta(output);
+template <typename T>
+void BasicDenseLayer<T>::SetOptimizer(const OptimizerConfig& optimizer) {
+    // The buffers are reallocated if the size of the state changes, which moves
+    // them out of the arena of the network (if any) until the network rebinds them.
+    const auto num_buffers{optimizer::NumStateBuffers(optimizer.type)};
+    optimizer_ = optimizer;
+    num_updates_ = 0;
+    if (buffers_.NumStateBuffers() != num_buffers) {
+        Buffers buffers{NumNodes(), buffers_.weights.size(), num_buffers};
+        buffers.CopyFrom(buffers_);
+        buffers_ = std::move(buffers);
+    }
+    std::fill(buffers_.weight_state.begin(), buffers_.weight_state.end(), Compute{});
+    std::fill(buffers_.bias_state.begin(), buffers_.bias_state.end(), Compute{});
 }
 
-} /* namespace */
+// --------------------------------------------------------------------------------
+template <typename T>
+void BasicDenseLayer<T>::Feedforward(const std::span<const Compute> inputs) {
+    Feedforward(inputs, std::span<Compute>{buffers_.output});
+}
 
 // --------------------------------------------------------------------------------
-DenseLayer::DenseLayer(const std::size_t num_nodes,
-                       const std::size_t num_weights_per_node,
-                       const enum ActFunc act_func) 
-    : act_func_{act_func} {
-    utils::random::Init();
-    output_.resize(num_nodes, 0);
-    utils::random::InitVector<double>(bias_, num_nodes, 0, 1);
-    error_.resize(num_nodes, 0);
-    utils::random::InitVector<double>(weights_, num_nodes, num_weights_per_node, 0, 1);
+template <typename T>
+void BasicDenseLayer<T>::Feedforward(const std::span<const Compute> inputs, 
+                                     const std::span<Compute> output) const {
+    const instrumentation::ScopedTimer timer{instrumentation::Phase::kFeedforward};
+    const auto num_inputs{std::min(NumWeightsPerNode(), inputs.size())};
+    const auto num_nodes{std::min(NumNodes(), output.size())};
+    flops_.Add(2 * num_nodes * num_inputs);
+    const Compute* x{inputs.data()};
+    for (std::size_t i{}; i < num_nodes; ++i) {
+        const T* w{buffers_.weights.data() + i * weight_stride_};
+        output[i] = buffers_.bias[i] + linalg::Dot(w, x, num_inputs);
+    }
+    activation::Dispatch(act_func_, [&](const auto act) {
+        act.Apply(output.data(), num_nodes, accuracy_);
+    });
 }
 
 // --------------------------------------------------------------------------------
-void DenseLayer::Feedforward(const std::vector<double>& inputs) {
-    for (std::size_t i{}; i < NumNodes(); ++i) {
-        double sum{ bias_[i] };
-        for (std::size_t j{}; j < NumWeightsPerNode() && j < inputs.size(); ++j) {
-            sum += inputs[j] * weights_[i][j];
+template <typename T>
+double BasicDenseLayer<T>::Backpropagate(const std::span<const Compute> reference) {
+    const instrumentation::ScopedTimer timer{instrumentation::Phase::kBackpropagate};
+    const auto num_nodes{std::min(NumNodes(), reference.size())};
+    flops_.Add(3 * num_nodes);
+    double loss{};
+    activation::Dispatch(act_func_, [&](const auto act) {
+        for (std::size_t i{}; i < num_nodes; ++i) {
+            const auto output{buffers_.output[i]};
+            buffers_.error[i] = (reference[i] - output) * training::OutputDelta(act, output);
+            loss += training::LossTerm(act.kActFunc, output, reference[i]);
         }
-        output_[i] = GetActFuncOutput(sum, act_func_);
-    }
+    });
+    return loss * training::LossScale(act_func_, num_nodes);
 }
 
 // --------------------------------------------------------------------------------
-void DenseLayer::Backpropagate(const std::vector<double>& reference) {
-    for (std::size_t i{}; i < NumNodes() && i < reference.size(); ++i) {
-        const double error = reference[i] - output_[i];
-        error_[i] = error * GetActFuncDelta(output_[i], act_func_);
+template <typename T>
+void BasicDenseLayer<T>::Backpropagate(const BasicDenseLayer& next_layer) {
+    // Accumulate the transposed product row by row so that the weights of the
+    // next layer are streamed contiguously instead of walked column-wise.
+    const instrumentation::ScopedTimer timer{instrumentation::Phase::kBackpropagate};
+    const auto num_nodes{std::min(NumNodes(), next_layer.NumWeightsPerNode())};
+    flops_.Add(2 * next_layer.NumNodes() * num_nodes);
+    Compute* error{buffers_.error.data()};
+    std::fill(buffers_.error.begin(), buffers_.error.end(), Compute{});
+    for (std::size_t j{}; j < next_layer.NumNodes(); ++j) {
+        const T* w{next_layer.buffers_.weights.data() + j * next_layer.weight_stride_};
+        linalg::Axpy(next_layer.buffers_.error[j], w, error, num_nodes);
     }
+    activation::Dispatch(act_func_, [&](const auto act) {
+        for (std::size_t i{}; i < NumNodes(); ++i) {
+            buffers_.error[i] *= act.Delta(buffers_.output[i]);
+        }
+    });
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+void BasicDenseLayer<T>::Optimize(const std::span<const Compute> inputs, 
+                                  const Compute learning_rate) {
+    Optimize(inputs, optimizer::UpdateStep{learning_rate, 1, ++num_updates_});
 }
 
 // --------------------------------------------------------------------------------
-void DenseLayer::Backpropagate(const DenseLayer& next_layer) {
+template <typename T>
+void BasicDenseLayer<T>::Optimize(const std::span<const Compute> inputs, 
+                                  const optimizer::UpdateStep& step) {
+    // The weight gradients of node i are error[i] * inputs, so the inputs are
+    // passed as gradients scaled by the error instead of forming a gradient row.
+    const instrumentation::ScopedTimer timer{instrumentation::Phase::kOptimize};
+    const auto num_inputs{std::min(NumWeightsPerNode(), inputs.size())};
+    flops_.Add(2 * NumNodes() * (num_inputs + 1));
+    const optimizer::UpdateStep bias_step{step.learning_rate, 1, step.count};
     for (std::size_t i{}; i < NumNodes(); ++i) {
-        double error{};
-        for (std::size_t j{}; j < next_layer.NumNodes(); ++j) {
-            error += next_layer.error_[j] * next_layer.weights_[j][i];
-        }
-        error_[i] = error * GetActFuncDelta(output_[i], act_func_);
+        const optimizer::UpdateStep node_step{step.learning_rate, buffers_.error[i], step.count};
+        optimizer::Update(optimizer_, node_step, inputs.data(), 
+                          buffers_.weights.data() + i * weight_stride_, WeightState(i), 
+                          buffers_.weights.size(), num_inputs);
     }
+    optimizer::Update(optimizer_, bias_step, buffers_.error.data(), buffers_.bias.data(), 
+                      BiasState(0), NumNodes(), NumNodes());
 }
 
 // --------------------------------------------------------------------------------
-void DenseLayer::Optimize(const std::vector<double>& inputs, const double learning_rate) {
-    for (std::size_t i{}; i < NumNodes(); ++i) {
-        bias_[i] += error_[i] * learning_rate;
-        for (std::size_t j{}; j < NumWeightsPerNode() && j < inputs.size(); ++j) {
-            weights_[i][j] += error_[i] * learning_rate * inputs[j];
+template <typename T>
+void BasicDenseLayer<T>::FeedforwardBatch(const MatrixView<const Compute>& inputs) {
+    batch_output_.Resize(inputs.NumRows(), NumNodes());
+    FeedforwardBatch(inputs, batch_output_.View());
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+void BasicDenseLayer<T>::FeedforwardBatch(const MatrixView<const Compute>& inputs,
+                                          const MatrixView<Compute>& output) const {
+    const instrumentation::ScopedTimer timer{instrumentation::Phase::kFeedforward};
+    const auto num_nodes{std::min(NumNodes(), output.NumColumns())};
+    const auto num_sets{std::min(inputs.NumRows(), output.NumRows())};
+    flops_.Add(2 * num_sets * num_nodes * std::min(num_weights_per_node_, inputs.NumColumns()));
+    const MatrixView<const T> weights{buffers_.weights.data(), num_nodes, 
+                                      num_weights_per_node_, weight_stride_};
+    linalg::MultiplyTransposed<T, Compute>(inputs.Rows(0, num_sets), weights, output);
+    activation::Dispatch(act_func_, [&](const auto act) {
+        for (std::size_t i{}; i < num_sets; ++i) {
+            Compute* row{output.Row(i)};
+            for (std::size_t j{}; j < num_nodes; ++j) { row[j] += buffers_.bias[j]; }
+            act.Apply(row, num_nodes, accuracy_);
         }
+    });
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+double BasicDenseLayer<T>::BackpropagateBatch(const MatrixView<const Compute>& reference) {
+    batch_error_.Resize(batch_output_.NumRows(), NumNodes());
+    return BackpropagateBatch(batch_output_.View(), reference, batch_error_.View());
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+void BasicDenseLayer<T>::BackpropagateBatch(const BasicDenseLayer& next_layer) {
+    batch_error_.Resize(batch_output_.NumRows(), NumNodes());
+    BackpropagateBatch(batch_output_.View(), next_layer, next_layer.batch_error_.View(), 
+                       batch_error_.View());
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+void BasicDenseLayer<T>::OptimizeBatch(const MatrixView<const Compute>& inputs, 
+                                       const Compute learning_rate) {
+    const auto num_samples{std::min(inputs.NumRows(), batch_error_.NumRows())};
+    if (num_samples == 0) { return; }
+    weight_gradient_.Resize(NumNodes(), num_weights_per_node_);
+    weight_gradient_.Clear();
+    bias_gradient_.assign(NumNodes(), 0);
+    AccumulateGradients(inputs.Rows(0, num_samples), batch_error_.View().Rows(0, num_samples),
+                        weight_gradient_.View(), bias_gradient_);
+    ApplyGradients(weight_gradient_.View(), bias_gradient_, 
+                   {learning_rate, 1.0 / num_samples, ++num_updates_});
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+double BasicDenseLayer<T>::BackpropagateBatch(const MatrixView<const Compute>& output,
+                                              const MatrixView<const Compute>& reference,
+                                              const MatrixView<Compute>& error) const {
+    const instrumentation::ScopedTimer timer{instrumentation::Phase::kBackpropagate};
+    const auto num_nodes{std::min({NumNodes(), output.NumColumns(), error.NumColumns()})};
+    const auto num_compared{std::min(num_nodes, reference.NumColumns())};
+    flops_.Add(3 * std::min(output.NumRows(), reference.NumRows()) * num_compared);
+    double loss{};
+    activation::Dispatch(act_func_, [&](const auto act) {
+        for (std::size_t i{}; i < output.NumRows() && i < error.NumRows(); ++i) {
+            const Compute* y{output.Row(i)};
+            Compute* e{error.Row(i)};
+            std::fill(e, e + num_nodes, Compute{});
+            if (i >= reference.NumRows()) { continue; }
+            const Compute* r{reference.Row(i)};
+            for (std::size_t j{}; j < num_compared; ++j) {
+                e[j] = (r[j] - y[j]) * training::OutputDelta(act, y[j]);
+                loss += training::LossTerm(act.kActFunc, y[j], r[j]);
+            }
+        }
+    });
+    return loss * training::LossScale(act_func_, num_compared);
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+void BasicDenseLayer<T>::BackpropagateBatch(const MatrixView<const Compute>& output,
+                                            const BasicDenseLayer& next_layer,
+                                            const MatrixView<const Compute>& next_error,
+                                            const MatrixView<Compute>& error) const {
+    const instrumentation::ScopedTimer timer{instrumentation::Phase::kBackpropagate};
+    const auto num_sets{std::min({output.NumRows(), next_error.NumRows(), error.NumRows()})};
+    const auto num_nodes{std::min(NumNodes(), error.NumColumns())};
+    flops_.Add(2 * num_sets * next_layer.NumNodes() * num_nodes);
+    linalg::Multiply<T, Compute>(next_error.Rows(0, num_sets), next_layer.WeightView(), 
+                                 error.Rows(0, num_sets));
+    activation::Dispatch(act_func_, [&](const auto act) {
+        for (std::size_t i{}; i < num_sets; ++i) {
+            const Compute* y{output.Row(i)};
+            Compute* e{error.Row(i)};
+            for (std::size_t j{}; j < num_nodes; ++j) {
+                e[j] *= act.Delta(y[j]);
+            }
+        }
+    });
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+void BasicDenseLayer<T>::AccumulateGradients(const MatrixView<const Compute>& inputs,
+                                             const MatrixView<const Compute>& error,
+                                             const MatrixView<Compute>& weight_gradient,
+                                             const std::span<Compute> bias_gradient) const {
+    const instrumentation::ScopedTimer timer{instrumentation::Phase::kGradients};
+    const auto num_sets{std::min(inputs.NumRows(), error.NumRows())};
+    const auto num_nodes{std::min({NumNodes(), error.NumColumns(), bias_gradient.size()})};
+    const auto num_inputs{std::min(num_weights_per_node_, inputs.NumColumns())};
+    flops_.Add(num_sets * num_nodes * (2 * num_inputs + 1));
+    linalg::AddTransposedProduct<Compute>(error.Rows(0, num_sets), inputs.Rows(0, num_sets), 
+                                          weight_gradient);
+    for (std::size_t i{}; i < num_sets; ++i) {
+        linalg::Axpy(Compute{1}, error.Row(i), bias_gradient.data(), num_nodes);
+    }
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+void BasicDenseLayer<T>::ApplyGradients(const MatrixView<const Compute>& weight_gradient,
+                                        const std::span<const Compute> bias_gradient,
+                                        const optimizer::UpdateStep& step,
+                                        const std::size_t first_node,
+                                        const std::size_t num_nodes) {
+    const auto last_node{std::min({NumNodes(), first_node + std::min(num_nodes, NumNodes()), 
+                                   weight_gradient.NumRows(), bias_gradient.size()})};
+    const auto num_inputs{std::min(NumWeightsPerNode(), weight_gradient.NumColumns())};
+    if (first_node >= last_node) { return; }
+    const instrumentation::ScopedTimer timer{instrumentation::Phase::kOptimize};
+    flops_.Add(2 * (last_node - first_node) * (num_inputs + 1));
+    for (std::size_t i{first_node}; i < last_node; ++i) {
+        optimizer::Update(optimizer_, step, weight_gradient.Row(i), 
+                          buffers_.weights.data() + i * weight_stride_, WeightState(i), 
+                          buffers_.weights.size(), num_inputs);
+    }
+    optimizer::Update(optimizer_, step, bias_gradient.data() + first_node, 
+                      buffers_.bias.data() + first_node, BiasState(first_node), NumNodes(), 
+                      last_node - first_node);
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+BasicDenseLayer<T>::Buffers::Buffers(const std::size_t num_nodes, const std::size_t num_weights,
+                                     const std::size_t num_state_buffers)
+    : arena{Size(num_nodes, num_weights, num_state_buffers)} {
+    Allocate(arena, num_nodes, num_weights, num_state_buffers);
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+BasicDenseLayer<T>::Buffers::Buffers(const Buffers& source, Arena& storage) {
+    Allocate(storage, source.output.size(), source.weights.size(), source.NumStateBuffers());
+    CopyFrom(source);
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+BasicDenseLayer<T>::Buffers::Buffers(const Buffers& source) : arena{source.Size()} {
+    Allocate(arena, source.output.size(), source.weights.size(), source.NumStateBuffers());
+    CopyFrom(source);
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+typename BasicDenseLayer<T>::Buffers& BasicDenseLayer<T>::Buffers::operator=(
+    const Buffers& source) {
+    // Buffers of the same size keep their storage, so a layer of a network stays
+    // in the arena of the network when another layer is assigned to it.
+    if (this == &source) { return *this; }
+    if (source.Size() == Size() && source.weights.size() == weights.size() &&
+        source.output.size() == output.size()) {
+        CopyFrom(source);
+    } else {
+        *this = Buffers{source};
     }
+    return *this;
 }
 
+// --------------------------------------------------------------------------------
+template <typename T>
+std::size_t BasicDenseLayer<T>::Buffers::Size(const std::size_t num_nodes, 
+                                              const std::size_t num_weights, 
+                                              const std::size_t num_state_buffers) {
+    return Arena::SizeOf<T>(num_weights) + 3 * Arena::SizeOf<Compute>(num_nodes) + 
+           Arena::SizeOf<Compute>(num_state_buffers * num_weights) + 
+           Arena::SizeOf<Compute>(num_state_buffers * num_nodes);
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+std::size_t BasicDenseLayer<T>::Buffers::Size(void) const {
+    return Size(output.size(), weights.size(), NumStateBuffers());
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+std::size_t BasicDenseLayer<T>::Buffers::NumStateBuffers(void) const {
+    return bias.empty() ? 0 : bias_state.size() / bias.size();
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+void BasicDenseLayer<T>::Buffers::Allocate(Arena& storage, const std::size_t num_nodes, 
+                                           const std::size_t num_weights, 
+                                           const std::size_t num_state_buffers) {
+    weights = storage.Allocate<T>(num_weights);
+    bias = storage.Allocate<Compute>(num_nodes);
+    output = storage.Allocate<Compute>(num_nodes);
+    error = storage.Allocate<Compute>(num_nodes);
+    weight_state = storage.Allocate<Compute>(num_state_buffers * num_weights);
+    bias_state = storage.Allocate<Compute>(num_state_buffers * num_nodes);
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+void BasicDenseLayer<T>::Buffers::CopyFrom(const Buffers& source) {
+    auto copy{[](const auto& from, const auto& to) {
+        std::copy_n(from.begin(), std::min(from.size(), to.size()), to.begin());
+    }};
+    copy(source.weights, weights);
+    copy(source.bias, bias);
+    copy(source.output, output);
+    copy(source.error, error);
+    copy(source.weight_state, weight_state);
+    copy(source.bias_state, bias_state);
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+void BasicDenseLayer<T>::Buffers::Rebase(const Buffers& buffers, const Arena& source, 
+                                         Arena& storage) {
+    weights = storage.Rebase(buffers.weights, source);
+    bias = storage.Rebase(buffers.bias, source);
+    output = storage.Rebase(buffers.output, source);
+    error = storage.Rebase(buffers.error, source);
+    weight_state = storage.Rebase(buffers.weight_state, source);
+    bias_state = storage.Rebase(buffers.bias_state, source);
+}
+
+template class BasicDenseLayer<double>;
+template class BasicDenseLayer<float>;
+template class BasicDenseLayer<BFloat16>;
+
 } /* namespace machine_learning */
 } /* namespace yrgo */
@@ -0,0 +1,250 @@
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+
+#include <fast_math.hpp>
+#include <simd.hpp>
+
+namespace yrgo {
+namespace machine_learning {
+namespace fast_math {
+
+namespace {
+
+/********************************************************************************
+ * @brief Holds the constants used for calculating e^x with scalar type T.
+ ********************************************************************************/
+template <typename T>
+struct ExpConstants;
+
+template <>
+struct ExpConstants<float> {
+    using Bits = std::uint32_t;
+    static constexpr float kMin{-87.0f};
+    static constexpr float kMax{88.0f};
+    static constexpr float kShifter{12582912.0f}; /* 1.5 * 2^23, rounds to integers. */
+    static constexpr float kLn2High{0.693359375f};
+    static constexpr float kLn2Low{-2.12194440e-4f};
+    static constexpr Bits kExponentBias{127};
+    static constexpr Bits kMantissaBits{23};
+};
+
+template <>
+struct ExpConstants<double> {
+    using Bits = std::uint64_t;
+    static constexpr double kMin{-708.0};
+    static constexpr double kMax{709.0};
+    static constexpr double kShifter{6755399441055744.0}; /* 1.5 * 2^52, rounds to integers. */
+    static constexpr double kLn2High{6.93147180369123816490e-01};
+    static constexpr double kLn2Low{1.90821492927058770002e-10};
+    static constexpr Bits kExponentBias{1023};
+    static constexpr Bits kMantissaBits{52};
+};
+
+// --------------------------------------------------------------------------------
+template <typename T>
+constexpr int ExpDegree(const Accuracy accuracy) {
+    if (accuracy == Accuracy::kLow) { return 4; }
+    return std::is_same_v<T, float> ? 7 : 11;
+}
+
+// --------------------------------------------------------------------------------
+constexpr int Log1pDegree(const Accuracy accuracy) {
+    return accuracy == Accuracy::kLow ? 2 : 6;
+}
+
+// See simd.hpp.
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+// --------------------------------------------------------------------------------
+template <typename V>
+[[gnu::always_inline]] inline V Clamp(const V& x, const V& min, const V& max) {
+    const V lower{x < min ? min : x};
+    return lower > max ? max : lower;
+}
+
+// --------------------------------------------------------------------------------
+template <typename T, Accuracy A, typename V>
+[[gnu::always_inline]] inline V Exp(const V& value) {
+    // e^x = 2^n * e^r with n = round(x / ln(2)) and |r| <= ln(2) / 2. The Taylor
+    // polynomial of e^r is evaluated with Horner's method, after which 2^n is
+    // added to the exponent field of the result.
+    using C = ExpConstants<T>;
+    using Bits = std::conditional_t<std::is_same_v<V, T>, typename C::Bits,
+                                    simd::Vector<typename C::Bits, sizeof(V) / sizeof(T)>>;
+    const V x{Clamp(value, simd::Broadcast<V>(C::kMin), simd::Broadcast<V>(C::kMax))};
+    const V shifted{x * static_cast<T>(1.44269504088896340736) + C::kShifter};
+    const V n{shifted - C::kShifter};
+    const V r{x - n * C::kLn2High - n * C::kLn2Low};
+    V polynomial{simd::Broadcast<V>(T{1})};
+    for (int k{ExpDegree<T>(A)}; k > 0; --k) {
+        polynomial = polynomial * r * (T{1} / static_cast<T>(k)) + T{1};
+    }
+    const Bits scale{(simd::BitCast<Bits>(shifted) + C::kExponentBias) << C::kMantissaBits};
+    return polynomial * simd::BitCast<V>(scale);
+}
+
+// --------------------------------------------------------------------------------
+template <typename T, Accuracy A, typename V>
+[[gnu::always_inline]] inline V Log1p(const V& u) {
+    // log(1 + u) = 2 * atanh(s) with s = u / (2 + u), i.e. 0 <= s <= 1/3 for
+    // 0 <= u <= 1, which is summed as 2s * (1 + s^2/3 + s^4/5 + ...).
+    const V s{u / (u + T{2})};
+    const V t{s * s};
+    V polynomial{simd::Broadcast<V>(T{1} / static_cast<T>(2 * Log1pDegree(A) + 1))};
+    for (int k{Log1pDegree(A) - 1}; k >= 0; --k) {
+        polynomial = polynomial * t + T{1} / static_cast<T>(2 * k + 1);
+    }
+    return T{2} * s * polynomial;
+}
+
+// --------------------------------------------------------------------------------
+template <typename T, Accuracy A, typename V>
+[[gnu::always_inline]] inline V Sigmoid(const V& x) {
+    return T{1} / (T{1} + Exp<T, A>(-x));
+}
+
+/********************************************************************************
+ * @brief Kernels of the activation functions, callable with scalars and vectors.
+ ********************************************************************************/
+template <typename T, Accuracy A>
+struct ExpKernel {
+    template <typename V>
+    [[gnu::always_inline]] V operator()(const V& x) const { return Exp<T, A>(x); }
+};
+
+template <typename T, Accuracy A>
+struct TanhKernel {
+    template <typename V>
+    [[gnu::always_inline]] V operator()(const V& x) const {
+        const V e{Exp<T, A>(T{2} * x)};
+        return (e - T{1}) / (e + T{1});
+    }
+};
+
+template <typename T, Accuracy A>
+struct SigmoidKernel {
+    template <typename V>
+    [[gnu::always_inline]] V operator()(const V& x) const { return Sigmoid<T, A>(x); }
+};
+
+template <typename T, Accuracy A>
+struct GeluKernel {
+    template <typename V>
+    [[gnu::always_inline]] V operator()(const V& x) const {
+        // 0.5 * (1 + tanh(z)) = sigmoid(2z), which stays finite for any x.
+        constexpr T kScale{static_cast<T>(2 * 0.79788456080286535588)};
+        return x * Sigmoid<T, A>(kScale * (x + static_cast<T>(0.044715) * x * x * x));
+    }
+};
+
+template <typename T, Accuracy A>
+struct SoftplusKernel {
+    template <typename V>
+    [[gnu::always_inline]] V operator()(const V& x) const {
+        // log(1 + e^x) = max(x, 0) + log(1 + e^-|x|), which never overflows.
+        const V zero{};
+        const V abs{x < zero ? -x : x};
+        return (x > zero ? x : zero) + Log1p<T, A>(Exp<T, A>(-abs));
+    }
+};
+
+template <typename T, Accuracy A>
+struct EluKernel {
+    template <typename V>
+    [[gnu::always_inline]] V operator()(const V& x) const {
+        return x > V{} ? x : Exp<T, A>(x) - T{1};
+    }
+};
+
+/********************************************************************************
+ * @brief Applies a function kernel to each element of an array in place.
+ ********************************************************************************/
+template <typename T, typename Function>
+struct ArrayKernel {
+    T* values;         /* The values to update. */
+    Function function; /* The function to apply. */
+
+    template <typename V>
+    [[gnu::always_inline]] void Apply(const std::size_t index) const {
+        simd::Store(values + index, function(simd::Load<V>(values + index)));
+    }
+};
+
+// --------------------------------------------------------------------------------
+template <template <typename, Accuracy> typename Kernel, typename T, typename Function>
+void Apply(T* values, const std::size_t size, const Accuracy accuracy, Function exact) {
+    switch (accuracy) {
+        case Accuracy::kHigh:
+            return simd::Run<T>(size, ArrayKernel{values, Kernel<T, Accuracy::kHigh>{}});
+        case Accuracy::kLow:
+            return simd::Run<T>(size, ArrayKernel{values, Kernel<T, Accuracy::kLow>{}});
+        default:
+            for (std::size_t i{}; i < size; ++i) { values[i] = exact(values[i]); }
+    }
+}
+
+} /* namespace */
+
+// --------------------------------------------------------------------------------
+template <typename T>
+void Exp(T* values, const std::size_t size, const Accuracy accuracy) {
+    Apply<ExpKernel>(values, size, accuracy, [](const T x) { return std::exp(x); });
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+void Tanh(T* values, const std::size_t size, const Accuracy accuracy) {
+    Apply<TanhKernel>(values, size, accuracy, [](const T x) { return std::tanh(x); });
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+void Sigmoid(T* values, const std::size_t size, const Accuracy accuracy) {
+    Apply<SigmoidKernel>(values, size, accuracy, [](const T x) {
+        return T{1} / (T{1} + std::exp(-x));
+    });
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+void Gelu(T* values, const std::size_t size, const Accuracy accuracy) {
+    Apply<GeluKernel>(values, size, accuracy, [](const T x) {
+        constexpr T kScale{static_cast<T>(0.79788456080286535588)};
+        return static_cast<T>(0.5) * x *
+            (T{1} + std::tanh(kScale * (x + static_cast<T>(0.044715) * x * x * x)));
+    });
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+void Softplus(T* values, const std::size_t size, const Accuracy accuracy) {
+    Apply<SoftplusKernel>(values, size, accuracy, [](const T x) {
+        return std::max(x, T{}) + std::log1p(std::exp(-std::abs(x)));
+    });
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+void Elu(T* values, const std::size_t size, const Accuracy accuracy) {
+    Apply<EluKernel>(values, size, accuracy, [](const T x) {
+        return x > 0 ? x : std::expm1(x);
+    });
+}
+
+template void Exp(float*, const std::size_t, const Accuracy);
+template void Exp(double*, const std::size_t, const Accuracy);
+template void Tanh(float*, const std::size_t, const Accuracy);
+template void Tanh(double*, const std::size_t, const Accuracy);
+template void Sigmoid(float*, const std::size_t, const Accuracy);
+template void Sigmoid(double*, const std::size_t, const Accuracy);
+template void Gelu(float*, const std::size_t, const Accuracy);
+template void Gelu(double*, const std::size_t, const Accuracy);
+template void Softplus(float*, const std::size_t, const Accuracy);
+template void Softplus(double*, const std::size_t, const Accuracy);
+template void Elu(float*, const std::size_t, const Accuracy);
+template void Elu(double*, const std::size_t, const Accuracy);
+
+} /* namespace fast_math */
+} /* namespace machine_learning */
+} /* namespace yrgo */
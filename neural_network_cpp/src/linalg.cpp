@@ -0,0 +1,854 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define LINALG_X86_KERNELS
+#endif
+
+#include "linalg.hpp"
+#include "simd.hpp"
+
+namespace yrgo {
+namespace machine_learning {
+namespace linalg {
+
+namespace {
+
+/********************************************************************************
+ * @brief The number of bytes of a matrix block to keep in cache while it is
+ *        reused for every row of the other operand (about half of L2).
+ ********************************************************************************/
+constexpr std::size_t kBlockSize{128 * 1024};
+
+// --------------------------------------------------------------------------------
+template <typename T>
+std::size_t NumRowsPerBlock(const std::size_t row_length) {
+    return std::max<std::size_t>(1, kBlockSize / (std::max<std::size_t>(1, row_length) * sizeof(T)));
+}
+
+// --------------------------------------------------------------------------------
+template <typename T, typename U>
+U DotScalar(const T* x, const U* y, const std::size_t size) {
+    U sum{};
+    for (std::size_t i{}; i < size; ++i) {
+        sum += static_cast<U>(x[i]) * y[i];
+    }
+    return sum;
+}
+
+// --------------------------------------------------------------------------------
+std::int32_t DotInt8Scalar(const std::int8_t* x, const std::int8_t* y, const std::size_t size) {
+    std::int32_t sum{};
+    for (std::size_t i{}; i < size; ++i) {
+        sum += static_cast<std::int32_t>(x[i]) * y[i];
+    }
+    return sum;
+}
+
+// --------------------------------------------------------------------------------
+template <typename T, typename U>
+void AxpyScalar(const ComputeType<U> alpha, const T* x, U* y, const std::size_t size) {
+    for (std::size_t i{}; i < size; ++i) {
+        y[i] += alpha * static_cast<ComputeType<U>>(x[i]);
+    }
+}
+
+#ifdef LINALG_X86_KERNELS
+
+// --------------------------------------------------------------------------------
+__attribute__((target("avx2,fma")))
+double HorizontalSum(const __m256d sum) {
+    const __m128d half{_mm_add_pd(_mm256_castpd256_pd128(sum), _mm256_extractf128_pd(sum, 1))};
+    return _mm_cvtsd_f64(_mm_add_sd(half, _mm_unpackhi_pd(half, half)));
+}
+
+// --------------------------------------------------------------------------------
+__attribute__((target("avx2,fma")))
+float HorizontalSum(const __m256 sum) {
+    __m128 quarter{_mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1))};
+    quarter = _mm_add_ps(quarter, _mm_movehl_ps(quarter, quarter));
+    return _mm_cvtss_f32(_mm_add_ss(quarter, _mm_movehdup_ps(quarter)));
+}
+
+// --------------------------------------------------------------------------------
+__attribute__((target("avx2,fma")))
+__m256 LoadBFloat16(const BFloat16* x) {
+    // A bfloat16 number is the upper half of the corresponding float.
+    const __m128i bits{_mm_loadu_si128(reinterpret_cast<const __m128i*>(x))};
+    return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(bits), 16));
+}
+
+// --------------------------------------------------------------------------------
+__attribute__((target("avx2,fma")))
+double DotAvx2(const double* x, const double* y, const std::size_t size) {
+    // Four independent accumulators hide the latency of the FMA instructions.
+    __m256d sum0{_mm256_setzero_pd()}, sum1{_mm256_setzero_pd()};
+    __m256d sum2{_mm256_setzero_pd()}, sum3{_mm256_setzero_pd()};
+    std::size_t i{};
+    for (; i + 16 <= size; i += 16) {
+        sum0 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i), sum0);
+        sum1 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 4), _mm256_loadu_pd(y + i + 4), sum1);
+        sum2 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 8), _mm256_loadu_pd(y + i + 8), sum2);
+        sum3 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 12), _mm256_loadu_pd(y + i + 12), sum3);
+    }
+    for (; i + 4 <= size; i += 4) {
+        sum0 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i), sum0);
+    }
+    double result{HorizontalSum(_mm256_add_pd(_mm256_add_pd(sum0, sum1),
+                                              _mm256_add_pd(sum2, sum3)))};
+    for (; i < size; ++i) {
+        result += x[i] * y[i];
+    }
+    return result;
+}
+
+// --------------------------------------------------------------------------------
+__attribute__((target("avx2,fma")))
+float DotAvx2(const float* x, const float* y, const std::size_t size) {
+    __m256 sum0{_mm256_setzero_ps()}, sum1{_mm256_setzero_ps()};
+    __m256 sum2{_mm256_setzero_ps()}, sum3{_mm256_setzero_ps()};
+    std::size_t i{};
+    for (; i + 32 <= size; i += 32) {
+        sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i), sum0);
+        sum1 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i + 8), _mm256_loadu_ps(y + i + 8), sum1);
+        sum2 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i + 16), _mm256_loadu_ps(y + i + 16), sum2);
+        sum3 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i + 24), _mm256_loadu_ps(y + i + 24), sum3);
+    }
+    for (; i + 8 <= size; i += 8) {
+        sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i), sum0);
+    }
+    float result{HorizontalSum(_mm256_add_ps(_mm256_add_ps(sum0, sum1),
+                                             _mm256_add_ps(sum2, sum3)))};
+    for (; i < size; ++i) {
+        result += x[i] * y[i];
+    }
+    return result;
+}
+
+// --------------------------------------------------------------------------------
+__attribute__((target("avx2,fma")))
+float DotAvx2(const BFloat16* x, const float* y, const std::size_t size) {
+    __m256 sum0{_mm256_setzero_ps()}, sum1{_mm256_setzero_ps()};
+    std::size_t i{};
+    for (; i + 16 <= size; i += 16) {
+        sum0 = _mm256_fmadd_ps(LoadBFloat16(x + i), _mm256_loadu_ps(y + i), sum0);
+        sum1 = _mm256_fmadd_ps(LoadBFloat16(x + i + 8), _mm256_loadu_ps(y + i + 8), sum1);
+    }
+    for (; i + 8 <= size; i += 8) {
+        sum0 = _mm256_fmadd_ps(LoadBFloat16(x + i), _mm256_loadu_ps(y + i), sum0);
+    }
+    float result{HorizontalSum(_mm256_add_ps(sum0, sum1))};
+    for (; i < size; ++i) {
+        result += static_cast<float>(x[i]) * y[i];
+    }
+    return result;
+}
+
+// --------------------------------------------------------------------------------
+__attribute__((target("avx2,fma")))
+void AxpyAvx2(const double alpha, const double* x, double* y, const std::size_t size) {
+    const __m256d a{_mm256_set1_pd(alpha)};
+    std::size_t i{};
+    for (; i + 8 <= size; i += 8) {
+        _mm256_storeu_pd(y + i, _mm256_fmadd_pd(a, _mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i)));
+        _mm256_storeu_pd(y + i + 4, _mm256_fmadd_pd(a, _mm256_loadu_pd(x + i + 4),
+                                                    _mm256_loadu_pd(y + i + 4)));
+    }
+    for (; i + 4 <= size; i += 4) {
+        _mm256_storeu_pd(y + i, _mm256_fmadd_pd(a, _mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i)));
+    }
+    for (; i < size; ++i) {
+        y[i] += alpha * x[i];
+    }
+}
+
+// --------------------------------------------------------------------------------
+__attribute__((target("avx2,fma")))
+void AxpyAvx2(const float alpha, const float* x, float* y, const std::size_t size) {
+    const __m256 a{_mm256_set1_ps(alpha)};
+    std::size_t i{};
+    for (; i + 16 <= size; i += 16) {
+        _mm256_storeu_ps(y + i, _mm256_fmadd_ps(a, _mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i)));
+        _mm256_storeu_ps(y + i + 8, _mm256_fmadd_ps(a, _mm256_loadu_ps(x + i + 8),
+                                                    _mm256_loadu_ps(y + i + 8)));
+    }
+    for (; i + 8 <= size; i += 8) {
+        _mm256_storeu_ps(y + i, _mm256_fmadd_ps(a, _mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i)));
+    }
+    for (; i < size; ++i) {
+        y[i] += alpha * x[i];
+    }
+}
+
+// --------------------------------------------------------------------------------
+__attribute__((target("avx2,fma")))
+void AxpyAvx2(const float alpha, const BFloat16* x, float* y, const std::size_t size) {
+    const __m256 a{_mm256_set1_ps(alpha)};
+    std::size_t i{};
+    for (; i + 8 <= size; i += 8) {
+        _mm256_storeu_ps(y + i, _mm256_fmadd_ps(a, LoadBFloat16(x + i), _mm256_loadu_ps(y + i)));
+    }
+    for (; i < size; ++i) {
+        y[i] += alpha * static_cast<float>(x[i]);
+    }
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+__attribute__((target("avx512f")))
+T SumLanes(const T* lanes, const std::size_t num_lanes) {
+    // The lanes are summed through memory, since the extract intrinsics used by
+    // _mm512_reduce_add_pd/ps trigger -Wuninitialized in GCC 12.
+    T sum{};
+    for (std::size_t i{}; i < num_lanes; ++i) { sum += lanes[i]; }
+    return sum;
+}
+
+// --------------------------------------------------------------------------------
+__attribute__((target("avx512f")))
+__m512 LoadBFloat16x16(const BFloat16* x) {
+    // The zero-masked conversions are used since the unmasked ones trigger 
+    // -Wmaybe-uninitialized in GCC 12.
+    constexpr __mmask16 kAll{0xFFFF};
+    const __m256i bits{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(x))};
+    return _mm512_castsi512_ps(_mm512_maskz_slli_epi32(kAll, _mm512_maskz_cvtepu16_epi32(kAll, bits), 16));
+}
+
+// --------------------------------------------------------------------------------
+__attribute__((target("avx512f")))
+double DotAvx512(const double* x, const double* y, const std::size_t size) {
+    __m512d sum0{_mm512_setzero_pd()}, sum1{_mm512_setzero_pd()};
+    std::size_t i{};
+    for (; i + 16 <= size; i += 16) {
+        sum0 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i), sum0);
+        sum1 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i + 8), _mm512_loadu_pd(y + i + 8), sum1);
+    }
+    // The remaining elements are handled with masked loads (zero elsewhere).
+    for (; i < size; i += 8) {
+        const auto mask{static_cast<__mmask8>(size - i >= 8 ? 0xFF : (1U << (size - i)) - 1)};
+        sum0 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(mask, x + i),
+                               _mm512_maskz_loadu_pd(mask, y + i), sum0);
+    }
+    alignas(64) double lanes[8];
+    _mm512_store_pd(lanes, _mm512_add_pd(sum0, sum1));
+    return SumLanes(lanes, 8);
+}
+
+// --------------------------------------------------------------------------------
+__attribute__((target("avx512f")))
+float DotAvx512(const float* x, const float* y, const std::size_t size) {
+    __m512 sum0{_mm512_setzero_ps()}, sum1{_mm512_setzero_ps()};
+    std::size_t i{};
+    for (; i + 32 <= size; i += 32) {
+        sum0 = _mm512_fmadd_ps(_mm512_loadu_ps(x + i), _mm512_loadu_ps(y + i), sum0);
+        sum1 = _mm512_fmadd_ps(_mm512_loadu_ps(x + i + 16), _mm512_loadu_ps(y + i + 16), sum1);
+    }
+    for (; i < size; i += 16) {
+        const auto mask{static_cast<__mmask16>(size - i >= 16 ? 0xFFFF : (1U << (size - i)) - 1)};
+        sum0 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, x + i),
+                               _mm512_maskz_loadu_ps(mask, y + i), sum0);
+    }
+    alignas(64) float lanes[16];
+    _mm512_store_ps(lanes, _mm512_add_ps(sum0, sum1));
+    return SumLanes(lanes, 16);
+}
+
+// --------------------------------------------------------------------------------
+__attribute__((target("avx512f")))
+float DotAvx512(const BFloat16* x, const float* y, const std::size_t size) {
+    __m512 sum{_mm512_setzero_ps()};
+    std::size_t i{};
+    for (; i + 16 <= size; i += 16) {
+        sum = _mm512_fmadd_ps(LoadBFloat16x16(x + i), _mm512_loadu_ps(y + i), sum);
+    }
+    alignas(64) float lanes[16];
+    _mm512_store_ps(lanes, sum);
+    float result{SumLanes(lanes, 16)};
+    for (; i < size; ++i) {
+        result += static_cast<float>(x[i]) * y[i];
+    }
+    return result;
+}
+
+// --------------------------------------------------------------------------------
+__attribute__((target("avx512f")))
+void AxpyAvx512(const double alpha, const double* x, double* y, const std::size_t size) {
+    const __m512d a{_mm512_set1_pd(alpha)};
+    std::size_t i{};
+    for (; i + 8 <= size; i += 8) {
+        _mm512_storeu_pd(y + i, _mm512_fmadd_pd(a, _mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i)));
+    }
+    if (i < size) {
+        const auto mask{static_cast<__mmask8>((1U << (size - i)) - 1)};
+        _mm512_mask_storeu_pd(y + i, mask, _mm512_fmadd_pd(a, _mm512_maskz_loadu_pd(mask, x + i),
+                                                          _mm512_maskz_loadu_pd(mask, y + i)));
+    }
+}
+
+// --------------------------------------------------------------------------------
+__attribute__((target("avx512f")))
+void AxpyAvx512(const float alpha, const float* x, float* y, const std::size_t size) {
+    const __m512 a{_mm512_set1_ps(alpha)};
+    std::size_t i{};
+    for (; i + 16 <= size; i += 16) {
+        _mm512_storeu_ps(y + i, _mm512_fmadd_ps(a, _mm512_loadu_ps(x + i), _mm512_loadu_ps(y + i)));
+    }
+    if (i < size) {
+        const auto mask{static_cast<__mmask16>((1U << (size - i)) - 1)};
+        _mm512_mask_storeu_ps(y + i, mask, _mm512_fmadd_ps(a, _mm512_maskz_loadu_ps(mask, x + i),
+                                                          _mm512_maskz_loadu_ps(mask, y + i)));
+    }
+}
+
+// --------------------------------------------------------------------------------
+__attribute__((target("avx512f")))
+void AxpyAvx512(const float alpha, const BFloat16* x, float* y, const std::size_t size) {
+    const __m512 a{_mm512_set1_ps(alpha)};
+    std::size_t i{};
+    for (; i + 16 <= size; i += 16) {
+        _mm512_storeu_ps(y + i, _mm512_fmadd_ps(a, LoadBFloat16x16(x + i), _mm512_loadu_ps(y + i)));
+    }
+    for (; i < size; ++i) {
+        y[i] += alpha * static_cast<float>(x[i]);
+    }
+}
+
+// --------------------------------------------------------------------------------
+__attribute__((target("avx2,fma")))
+std::int32_t DotInt8Avx2(const std::int8_t* x, const std::int8_t* y, const std::size_t size) {
+    // The bytes are widened to 16 bits, so that the pairwise products can be 
+    // summed into 32-bit lanes without the saturation of _mm256_maddubs_epi16.
+    __m256i sum{_mm256_setzero_si256()};
+    std::size_t i{};
+    for (; i + 16 <= size; i += 16) {
+        const __m256i a{_mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i)))};
+        const __m256i b{_mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(y + i)))};
+        sum = _mm256_add_epi32(sum, _mm256_madd_epi16(a, b));
+    }
+    alignas(32) std::int32_t lanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), sum);
+    std::int32_t result{};
+    for (const auto& lane : lanes) { result += lane; }
+    return result + DotInt8Scalar(x + i, y + i, size - i);
+}
+
+// --------------------------------------------------------------------------------
+__attribute__((target("avx512f,avx512bw")))
+std::int32_t DotInt8Avx512(const std::int8_t* x, const std::int8_t* y, const std::size_t size) {
+    __m512i sum{_mm512_setzero_si512()};
+    std::size_t i{};
+    for (; i + 32 <= size; i += 32) {
+        const __m512i a{_mm512_cvtepi8_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i)))};
+        const __m512i b{_mm512_cvtepi8_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + i)))};
+        sum = _mm512_add_epi32(sum, _mm512_madd_epi16(a, b));
+    }
+    alignas(64) std::int32_t lanes[16];
+    _mm512_store_si512(lanes, sum);
+    return SumLanes(lanes, 16) + DotInt8Scalar(x + i, y + i, size - i);
+}
+
+#endif /* LINALG_X86_KERNELS */
+
+// See simd.hpp.
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+/********************************************************************************
+ * @brief The number of rows of a register tile of the matrix kernels. A tile of
+ *        c holds kTileRows x 2 vectors, which leaves enough registers for the
+ *        operands with 16 vector registers (AVX2).
+ *
+ * @note The loops over a tile are unrolled explicitly, since GCC only unrolls 
+ *       them by itself at -O3 and the tile must be kept in registers.
+ ********************************************************************************/
+constexpr std::size_t kTileRows{4};
+
+/********************************************************************************
+ * @brief The number of rows of b (the inner dimension) multiplied at a time by
+ *        c += a * b.
+ ********************************************************************************/
+constexpr std::size_t kBlockDepth{128};
+
+/********************************************************************************
+ * @brief Describes a matrix product for the matrix kernels, where c is m x n 
+ *        and k is the inner dimension. Element (i, r) of a is found at
+ *        a[i * a_row_stride + r * a_column_stride], so a may be transposed.
+ ********************************************************************************/
+template <typename T, typename U>
+struct Product {
+    const U* a{};                    /* The left matrix. */
+    std::size_t a_row_stride{};      /* The distance between the rows of a. */
+    std::size_t a_column_stride{1};  /* The distance between the columns of a. */
+    const T* b{};                    /* The right matrix. */
+    std::size_t b_stride{};          /* The distance between the rows of b. */
+    U* c{};                          /* The result matrix. */
+    std::size_t c_stride{};          /* The distance between the rows of c. */
+    std::size_t m{};                 /* The number of rows of c. */
+    std::size_t n{};                 /* The number of columns of c. */
+    std::size_t k{};                 /* The inner dimension. */
+
+    U A(const std::size_t i, const std::size_t r) const { 
+        return a[i * a_row_stride + r * a_column_stride]; 
+    }
+};
+
+// --------------------------------------------------------------------------------
+template <typename V, typename T>
+[[gnu::always_inline]] inline V LoadVector(const T* x) {
+    if constexpr (std::is_same_v<T, BFloat16>) {
+        // A bfloat16 number is the upper half of the corresponding float.
+        constexpr auto kSize{sizeof(V) / sizeof(float)};
+        const auto bits{simd::Load<simd::Vector<std::uint16_t, kSize>>(x)};
+        return simd::BitCast<V>(__builtin_convertvector(bits, simd::Vector<std::uint32_t, kSize>) 
+                                << 16);
+    } else {
+        return simd::Load<V>(x);
+    }
+}
+
+// --------------------------------------------------------------------------------
+template <typename V, typename T, typename U>
+[[gnu::always_inline]] inline void AxpyRow(const U alpha, const T* x, U* y, const std::size_t size) {
+    constexpr auto kWidth{sizeof(V) / sizeof(U)};
+    const auto a{simd::Broadcast<V>(alpha)};
+    std::size_t i{};
+    for (; i + kWidth <= size; i += kWidth) {
+        simd::Store(y + i, simd::Load<V>(y + i) + a * LoadVector<V>(x + i));
+    }
+    for (; i < size; ++i) { y[i] += alpha * static_cast<U>(x[i]); }
+}
+
+/********************************************************************************
+ * @brief Adds the product of a tile of a (Rows rows) and a panel of b (Columns
+ *        vectors wide, starting at column j) to c. The tile of c is accumulated
+ *        in registers over the whole inner dimension.
+ ********************************************************************************/
+template <std::size_t Rows, std::size_t Columns, typename V, typename T, typename U>
+[[gnu::always_inline]] inline void MultiplyAddTile(const Product<T, U>& p, const std::size_t i,
+                                                   const std::size_t j) {
+    constexpr auto kWidth{sizeof(V) / sizeof(U)};
+    V sum[Rows][Columns]{};
+    for (std::size_t r{}; r < p.k; ++r) {
+        V b[Columns];
+        #pragma GCC unroll 16
+        for (std::size_t col{}; col < Columns; ++col) {
+            b[col] = LoadVector<V>(p.b + r * p.b_stride + j + col * kWidth);
+        }
+        #pragma GCC unroll 16
+        for (std::size_t row{}; row < Rows; ++row) {
+            const auto a{simd::Broadcast<V>(p.A(i + row, r))};
+            #pragma GCC unroll 16
+            for (std::size_t col{}; col < Columns; ++col) { sum[row][col] += a * b[col]; }
+        }
+    }
+    #pragma GCC unroll 16
+    for (std::size_t row{}; row < Rows; ++row) {
+        #pragma GCC unroll 16
+        for (std::size_t col{}; col < Columns; ++col) {
+            auto* c{p.c + (i + row) * p.c_stride + j + col * kWidth};
+            simd::Store(c, simd::Load<V>(c) + sum[row][col]);
+        }
+    }
+}
+
+// --------------------------------------------------------------------------------
+template <std::size_t Columns, typename V, typename T, typename U>
+[[gnu::always_inline]] inline void MultiplyAddPanel(const Product<T, U>& p, const std::size_t j) {
+    std::size_t i{};
+    for (; i + kTileRows <= p.m; i += kTileRows) { MultiplyAddTile<kTileRows, Columns, V>(p, i, j); }
+    switch (p.m - i) {
+        case 3: return MultiplyAddTile<3, Columns, V>(p, i, j);
+        case 2: return MultiplyAddTile<2, Columns, V>(p, i, j);
+        case 1: return MultiplyAddTile<1, Columns, V>(p, i, j);
+        default: return;
+    }
+}
+
+/********************************************************************************
+ * @brief Calculates c += a * b for one block of the inner dimension with register
+ *        tiles of V vectors. The panels of b (two vectors wide) are reused for
+ *        every tile of a while in cache.
+ ********************************************************************************/
+template <typename V, typename T, typename U>
+[[gnu::always_inline]] inline void MultiplyAddBlock(const Product<T, U>& p) {
+    constexpr auto kWidth{sizeof(V) / sizeof(U)};
+    std::size_t j{};
+    for (; j + 2 * kWidth <= p.n; j += 2 * kWidth) { MultiplyAddPanel<2, V>(p, j); }
+    for (; j + kWidth <= p.n; j += kWidth) { MultiplyAddPanel<1, V>(p, j); }
+    for (std::size_t i{}; i < p.m; ++i) {
+        for (std::size_t col{j}; col < p.n; ++col) {
+            U sum{};
+            for (std::size_t r{}; r < p.k; ++r) {
+                sum += p.A(i, r) * static_cast<U>(p.b[r * p.b_stride + col]);
+            }
+            p.c[i * p.c_stride + col] += sum;
+        }
+    }
+}
+
+/********************************************************************************
+ * @brief Calculates the dot products of Rows rows of a (starting at row i) and 
+ *        Columns rows of b (starting at row j), i.e. a tile of c = a * b^T. All
+ *        products of the tile share the loads of the operands.
+ ********************************************************************************/
+template <std::size_t Rows, std::size_t Columns, typename V, typename T, typename U>
+[[gnu::always_inline]] inline void DotTile(const Product<T, U>& p, const std::size_t i,
+                                           const std::size_t j) {
+    constexpr auto kWidth{sizeof(V) / sizeof(U)};
+    V sum[Rows][Columns]{};
+    std::size_t r{};
+    for (; r + kWidth <= p.k; r += kWidth) {
+        V b[Columns];
+        #pragma GCC unroll 16
+        for (std::size_t col{}; col < Columns; ++col) {
+            b[col] = LoadVector<V>(p.b + (j + col) * p.b_stride + r);
+        }
+        #pragma GCC unroll 16
+        for (std::size_t row{}; row < Rows; ++row) {
+            const auto a{simd::Load<V>(p.a + (i + row) * p.a_row_stride + r)};
+            #pragma GCC unroll 16
+            for (std::size_t col{}; col < Columns; ++col) {
+                sum[row][col] = simd::MultiplyAdd(a, b[col], sum[row][col]);
+            }
+        }
+    }
+    if (r < p.k) {
+        // The remaining elements are padded with zeros to one more vector, so that
+        // every dot product is rounded the same way whatever the shape of the tile,
+        // i.e. a row of c doesn't depend on the number of rows of a.
+        V b[Columns]{};
+        #pragma GCC unroll 16
+        for (std::size_t col{}; col < Columns; ++col) {
+            for (std::size_t q{r}; q < p.k; ++q) {
+                b[col][q - r] = static_cast<U>(p.b[(j + col) * p.b_stride + q]);
+            }
+        }
+        #pragma GCC unroll 16
+        for (std::size_t row{}; row < Rows; ++row) {
+            V a{};
+            for (std::size_t q{r}; q < p.k; ++q) { a[q - r] = p.A(i + row, q); }
+            #pragma GCC unroll 16
+            for (std::size_t col{}; col < Columns; ++col) {
+                sum[row][col] = simd::MultiplyAdd(a, b[col], sum[row][col]);
+            }
+        }
+    }
+    #pragma GCC unroll 16
+    for (std::size_t row{}; row < Rows; ++row) {
+        #pragma GCC unroll 16
+        for (std::size_t col{}; col < Columns; ++col) {
+            U result{};
+            #pragma GCC unroll 16
+            for (std::size_t lane{}; lane < kWidth; ++lane) { result += sum[row][col][lane]; }
+            p.c[(i + row) * p.c_stride + j + col] = result;
+        }
+    }
+}
+
+// --------------------------------------------------------------------------------
+template <std::size_t Rows, typename V, typename T, typename U>
+[[gnu::always_inline]] inline void DotRows(const Product<T, U>& p, const std::size_t i) {
+    std::size_t j{};
+    for (; j + kTileRows <= p.n; j += kTileRows) { DotTile<Rows, kTileRows, V>(p, i, j); }
+    switch (p.n - j) {
+        case 3: return DotTile<Rows, 3, V>(p, i, j);
+        case 2: return DotTile<Rows, 2, V>(p, i, j);
+        case 1: return DotTile<Rows, 1, V>(p, i, j);
+        default: return;
+    }
+}
+
+/********************************************************************************
+ * @brief Calculates c += a * b. The inner dimension is split into blocks of
+ *        kBlockDepth rows of b, so that a panel of b stays in L1 cache.
+ ********************************************************************************/
+template <typename V, typename T, typename U>
+[[gnu::always_inline]] inline void MultiplyAddKernel(const Product<T, U>& p) {
+    if (p.m < kTileRows) {
+        // Too few rows of a for the tiles to reuse b, which is streamed row by row instead.
+        for (std::size_t r{}; r < p.k; ++r) {
+            for (std::size_t i{}; i < p.m; ++i) {
+                AxpyRow<V>(p.A(i, r), p.b + r * p.b_stride, p.c + i * p.c_stride, p.n);
+            }
+        }
+        return;
+    }
+    for (std::size_t r{}; r < p.k; r += kBlockDepth) {
+        auto block{p};
+        block.a += r * p.a_column_stride;
+        block.b += r * p.b_stride;
+        block.k = std::min(kBlockDepth, p.k - r);
+        MultiplyAddBlock<V>(block);
+    }
+}
+
+/********************************************************************************
+ * @brief Calculates c = a * b^T with register tiles of 2 x kTileRows dot products,
+ *        each accumulated in one V vector.
+ ********************************************************************************/
+template <typename V, typename T, typename U>
+[[gnu::always_inline]] inline void MultiplyTransposedKernel(const Product<T, U>& p) {
+    std::size_t i{};
+    for (; i + 2 <= p.m; i += 2) { DotRows<2, V>(p, i); }
+    if (i < p.m) { DotRows<1, V>(p, i); }
+}
+
+// --------------------------------------------------------------------------------
+template <typename T, typename U>
+void MultiplyTransposedBaseline(const Product<T, U>& p) {
+    MultiplyTransposedKernel<simd::Vector<U, 16 / sizeof(U)>>(p);
+}
+
+// --------------------------------------------------------------------------------
+template <typename T, typename U>
+void MultiplyAddBaseline(const Product<T, U>& p) {
+    MultiplyAddKernel<simd::Vector<U, 16 / sizeof(U)>>(p);
+}
+
+#ifdef LINALG_X86_KERNELS
+
+// --------------------------------------------------------------------------------
+template <typename T, typename U>
+__attribute__((target("avx2,fma")))
+void MultiplyTransposedAvx2(const Product<T, U>& p) {
+    MultiplyTransposedKernel<simd::Vector<U, 32 / sizeof(U)>>(p);
+}
+
+// --------------------------------------------------------------------------------
+template <typename T, typename U>
+__attribute__((target("avx2,fma")))
+void MultiplyAddAvx2(const Product<T, U>& p) {
+    MultiplyAddKernel<simd::Vector<U, 32 / sizeof(U)>>(p);
+}
+
+// --------------------------------------------------------------------------------
+template <typename T, typename U>
+__attribute__((target("avx512f")))
+void MultiplyTransposedAvx512(const Product<T, U>& p) {
+    MultiplyTransposedKernel<simd::Vector<U, 64 / sizeof(U)>>(p);
+}
+
+// --------------------------------------------------------------------------------
+template <typename T, typename U>
+__attribute__((target("avx512f")))
+void MultiplyAddAvx512(const Product<T, U>& p) {
+    MultiplyAddKernel<simd::Vector<U, 64 / sizeof(U)>>(p);
+}
+
+#endif /* LINALG_X86_KERNELS */
+
+/********************************************************************************
+ * @brief Holds the kernels of one combination of vector types.
+ *
+ * @tparam T The type of the first vector (typically the weights).
+ * @tparam U The type of the second vector (typically the activations).
+ ********************************************************************************/
+template <typename T, typename U>
+struct KernelSet {
+    U (*dot)(const T*, const U*, const std::size_t){DotScalar<T, U>};
+    void (*axpy)(const U, const T*, U*, const std::size_t){AxpyScalar<T, U>};
+    void (*multiply_transposed)(const Product<T, U>&){MultiplyTransposedBaseline<T, U>};
+    void (*multiply_add)(const Product<T, U>&){MultiplyAddBaseline<T, U>};
+};
+
+/********************************************************************************
+ * @brief Holds the kernels selected for the active SIMD level.
+ ********************************************************************************/
+struct Kernels {
+    SimdLevel level{SimdLevel::kScalar};
+    KernelSet<double, double> f64{};
+    KernelSet<float, float> f32{};
+    KernelSet<BFloat16, float> bf16{};
+    std::int32_t (*dot_int8)(const std::int8_t*, const std::int8_t*, const std::size_t){
+        DotInt8Scalar};
+};
+
+// --------------------------------------------------------------------------------
+Kernels SelectKernels(const SimdLevel level) {
+    Kernels kernels{};
+#ifdef LINALG_X86_KERNELS
+    kernels.level = std::min(level, SupportedSimdLevel());
+    if (kernels.level == SimdLevel::kAvx512) {
+        kernels.f64 = {DotAvx512, AxpyAvx512, MultiplyTransposedAvx512, MultiplyAddAvx512};
+        kernels.f32 = {DotAvx512, AxpyAvx512, MultiplyTransposedAvx512, MultiplyAddAvx512};
+        kernels.bf16 = {DotAvx512, AxpyAvx512, MultiplyTransposedAvx512, MultiplyAddAvx512};
+        kernels.dot_int8 = __builtin_cpu_supports("avx512bw") ? DotInt8Avx512 : DotInt8Avx2;
+    } else if (kernels.level == SimdLevel::kAvx2) {
+        kernels.f64 = {DotAvx2, AxpyAvx2, MultiplyTransposedAvx2, MultiplyAddAvx2};
+        kernels.f32 = {DotAvx2, AxpyAvx2, MultiplyTransposedAvx2, MultiplyAddAvx2};
+        kernels.bf16 = {DotAvx2, AxpyAvx2, MultiplyTransposedAvx2, MultiplyAddAvx2};
+        kernels.dot_int8 = DotInt8Avx2;
+    }
+#else
+    (void)level;
+#endif
+    return kernels;
+}
+
+// --------------------------------------------------------------------------------
+const Kernels& KernelsOfLevel(const SimdLevel level) {
+    static const std::array<Kernels, 3> kernels{SelectKernels(SimdLevel::kScalar),
+                                                SelectKernels(SimdLevel::kAvx2),
+                                                SelectKernels(SimdLevel::kAvx512)};
+    return kernels[static_cast<std::size_t>(level)];
+}
+
+/********************************************************************************
+ * @brief Provides the pointer to the kernels of the active SIMD level.
+ *
+ * @note The kernels of every level are selected before the pointer is initialized
+ *       and never change, so SetSimdLevel only swaps the pointer. It may then be
+ *       called while other threads use the kernels, which only need a relaxed load.
+ ********************************************************************************/
+std::atomic<const Kernels*>& ActiveKernelsPointer(void) {
+    static std::atomic<const Kernels*> active{&KernelsOfLevel(SupportedSimdLevel())};
+    return active;
+}
+
+// --------------------------------------------------------------------------------
+const Kernels& ActiveKernels(void) {
+    return *ActiveKernelsPointer().load(std::memory_order_relaxed);
+}
+
+// --------------------------------------------------------------------------------
+template <typename T, typename U>
+const KernelSet<T, U>* ActiveKernelSet(void) {
+    if constexpr (std::is_same_v<T, double> && std::is_same_v<U, double>) {
+        return &ActiveKernels().f64;
+    } else if constexpr (std::is_same_v<T, float> && std::is_same_v<U, float>) {
+        return &ActiveKernels().f32;
+    } else if constexpr (std::is_same_v<T, BFloat16> && std::is_same_v<U, float>) {
+        return &ActiveKernels().bf16;
+    } else {
+        return nullptr;
+    }
+}
+
+} /* namespace */
+
+// --------------------------------------------------------------------------------
+SimdLevel SupportedSimdLevel(void) {
+#ifdef LINALG_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) { return SimdLevel::kAvx512; }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return SimdLevel::kAvx2;
+    }
+#endif
+    return SimdLevel::kScalar;
+}
+
+// --------------------------------------------------------------------------------
+SimdLevel ActiveSimdLevel(void) { return ActiveKernels().level; }
+
+// --------------------------------------------------------------------------------
+SimdLevel SetSimdLevel(const SimdLevel level) {
+    const auto& kernels{KernelsOfLevel(level)};
+    ActiveKernelsPointer().store(&kernels, std::memory_order_relaxed);
+    return kernels.level;
+}
+
+// --------------------------------------------------------------------------------
+template <typename T, typename U>
+U Dot(const T* x, const U* y, const std::size_t size) {
+    if (const auto* kernels{ActiveKernelSet<T, U>()}) { return kernels->dot(x, y, size); }
+    return DotScalar(x, y, size);
+}
+
+// --------------------------------------------------------------------------------
+std::int32_t DotInt8(const std::int8_t* x, const std::int8_t* y, const std::size_t size) {
+    return ActiveKernels().dot_int8(x, y, size);
+}
+
+// --------------------------------------------------------------------------------
+template <typename T, typename U>
+void Axpy(const ComputeType<U> alpha, const T* x, U* y, const std::size_t size) {
+    if constexpr (std::is_same_v<U, ComputeType<U>>) {
+        if (const auto* kernels{ActiveKernelSet<T, U>()}) {
+            return kernels->axpy(alpha, x, y, size);
+        }
+    }
+    AxpyScalar(alpha, x, y, size);
+}
+
+// --------------------------------------------------------------------------------
+template <typename T, typename U>
+void MultiplyTransposed(const MatrixView<const U>& a,
+                        const MatrixView<const T>& b,
+                        const MatrixView<U>& c) {
+    // The rows of b are processed in blocks, which stay in cache while all rows
+    // of a are multiplied with them.
+    const auto k{std::min(a.NumColumns(), b.NumColumns())};
+    const auto block{NumRowsPerBlock<T>(k)};
+    const auto* kernels{ActiveKernelSet<T, U>()};
+    for (std::size_t j0{}; j0 < b.NumRows(); j0 += block) {
+        const Product<T, U> product{a.Data(), a.Stride(), 1, b.Row(j0), b.Stride(), 
+                                    c.Data() + j0, c.Stride(), std::min(a.NumRows(), c.NumRows()),
+                                    std::min(j0 + block, b.NumRows()) - j0, k};
+        kernels->multiply_transposed(product);
+    }
+}
+
+// --------------------------------------------------------------------------------
+template <typename T, typename U>
+void Multiply(const MatrixView<const U>& a,
+              const MatrixView<const T>& b,
+              const MatrixView<U>& c) {
+    const auto k{std::min(a.NumColumns(), b.NumRows())};
+    const auto n{std::min(b.NumColumns(), c.NumColumns())};
+    for (std::size_t i{}; i < c.NumRows(); ++i) {
+        std::fill(c.Row(i), c.Row(i) + n, U{});
+    }
+    const Product<T, U> product{a.Data(), a.Stride(), 1, b.Data(), b.Stride(), c.Data(), 
+                                c.Stride(), std::min(a.NumRows(), c.NumRows()), n, k};
+    ActiveKernelSet<T, U>()->multiply_add(product);
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+void AddTransposedProduct(const MatrixView<const T>& a,
+                          const MatrixView<const T>& b,
+                          const MatrixView<T>& c) {
+    // Row i of transpose(a) is column i of a, i.e. the rows and columns swap strides.
+    const auto k{std::min(a.NumRows(), b.NumRows())};
+    const auto m{std::min(a.NumColumns(), c.NumRows())};
+    const auto n{std::min(b.NumColumns(), c.NumColumns())};
+    const Product<T, T> product{a.Data(), 1, a.Stride(), b.Data(), b.Stride(), c.Data(), 
+                                c.Stride(), m, n, k};
+    ActiveKernelSet<T, T>()->multiply_add(product);
+}
+
+template double Dot(const double*, const double*, const std::size_t);
+template float Dot(const float*, const float*, const std::size_t);
+template float Dot(const BFloat16*, const float*, const std::size_t);
+
+template void Axpy(const double, const double*, double*, const std::size_t);
+template void Axpy(const float, const float*, float*, const std::size_t);
+template void Axpy(const float, const BFloat16*, float*, const std::size_t);
+template void Axpy(const float, const float*, BFloat16*, const std::size_t);
+
+template void MultiplyTransposed(const MatrixView<const double>&,
+                                 const MatrixView<const double>&, const MatrixView<double>&);
+template void MultiplyTransposed(const MatrixView<const float>&,
+                                 const MatrixView<const float>&, const MatrixView<float>&);
+template void MultiplyTransposed(const MatrixView<const float>&,
+                                 const MatrixView<const BFloat16>&, const MatrixView<float>&);
+
+template void Multiply(const MatrixView<const double>&,
+                       const MatrixView<const double>&, const MatrixView<double>&);
+template void Multiply(const MatrixView<const float>&,
+                       const MatrixView<const float>&, const MatrixView<float>&);
+template void Multiply(const MatrixView<const float>&,
+                       const MatrixView<const BFloat16>&, const MatrixView<float>&);
+
+template void AddTransposedProduct(const MatrixView<const double>&,
+                                   const MatrixView<const double>&, const MatrixView<double>&);
+template void AddTransposedProduct(const MatrixView<const float>&,
+                                   const MatrixView<const float>&, const MatrixView<float>&);
+
+} /* namespace linalg */
+} /* namespace machine_learning */
+} /* namespace yrgo */
@@ -0,0 +1,257 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <linalg.hpp>
+#include <model_file.hpp>
+
+namespace yrgo {
+namespace machine_learning {
+
+namespace {
+
+// --------------------------------------------------------------------------------
+std::uint64_t AlignOffset(const std::uint64_t offset) {
+    constexpr auto kAlignment{utils::memory::kCacheLineSize};
+    return (offset + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+void WriteBlob(std::ofstream& file, const T* data, const std::size_t size,
+               const std::uint64_t offset) {
+    const auto position{static_cast<std::uint64_t>(file.tellp())};
+    const std::vector<char> padding(offset - position, 0);
+    file.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+    file.write(reinterpret_cast<const char*>(data), 
+               static_cast<std::streamsize>(size * sizeof(T)));
+}
+
+// --------------------------------------------------------------------------------
+bool IsInFile(const std::uint64_t offset, const std::uint64_t num_rows, 
+              const std::uint64_t row_size, const std::uint64_t file_size) {
+    return row_size > 0 && offset <= file_size && num_rows <= (file_size - offset) / row_size;
+}
+
+// --------------------------------------------------------------------------------
+[[noreturn]] void ThrowInvalidFile(const std::string& path, const std::string& reason) {
+    throw std::runtime_error("Invalid model file " + path + ": " + reason + "!");
+}
+
+} /* namespace */
+
+namespace model_file {
+
+// --------------------------------------------------------------------------------
+template <typename T>
+bool Save(const BasicNeuralNetwork<T>& network, const std::string& path) {
+    using Compute = ComputeType<T>;
+    FileHeader file_header{};
+    std::copy(std::begin(kMagic), std::end(kMagic), file_header.magic);
+    file_header.version = kVersion;
+    file_header.scalar_type = ScalarTypeOf<T>();
+    file_header.num_layers = network.NumLayers();
+
+    std::vector<LayerHeader> layer_headers(network.NumLayers());
+    auto offset{static_cast<std::uint64_t>(sizeof(FileHeader) +
+                                           layer_headers.size() * sizeof(LayerHeader))};
+    for (std::size_t i{}; i < network.NumLayers(); ++i) {
+        const auto& layer{network.Layers()[i]};
+        auto& header{layer_headers[i]};
+        header.num_nodes = layer.NumNodes();
+        header.num_weights_per_node = layer.NumWeightsPerNode();
+        header.weight_stride = layer.WeightStride();
+        header.act_func = layer.ActivationFunction();
+        header.weight_offset = AlignOffset(offset);
+        header.bias_offset = AlignOffset(header.weight_offset +
+                                         layer.WeightMatrix().size() * sizeof(T));
+        offset = header.bias_offset + layer.NumNodes() * sizeof(Compute);
+    }
+    file_header.file_size = offset;
+
+    std::ofstream file{path, std::ios::binary | std::ios::trunc};
+    if (!file) { return false; }
+    file.write(reinterpret_cast<const char*>(&file_header), sizeof(file_header));
+    file.write(reinterpret_cast<const char*>(layer_headers.data()),
+               static_cast<std::streamsize>(layer_headers.size() * sizeof(LayerHeader)));
+    for (std::size_t i{}; i < network.NumLayers(); ++i) {
+        const auto& layer{network.Layers()[i]};
+        WriteBlob(file, layer.WeightMatrix().data(), layer.WeightMatrix().size(),
+                  layer_headers[i].weight_offset);
+        WriteBlob(file, layer.Bias().data(), layer.Bias().size(), layer_headers[i].bias_offset);
+    }
+    return static_cast<bool>(file.flush());
+}
+
+} /* namespace model_file */
+
+// --------------------------------------------------------------------------------
+template <typename T>
+BasicMappedNeuralNetwork<T>::BasicMappedNeuralNetwork(const std::string& path) {
+    using namespace model_file;
+    const auto fd{open(path.c_str(), O_RDONLY)};
+    if (fd < 0) { throw std::runtime_error("Failed to open model file " + path + "!"); }
+    struct stat status{};
+    if (fstat(fd, &status) != 0 || status.st_size < static_cast<off_t>(sizeof(FileHeader))) {
+        close(fd);
+        ThrowInvalidFile(path, "file too small");
+    }
+    size_ = static_cast<std::size_t>(status.st_size);
+    data_ = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data_ == MAP_FAILED) {
+        data_ = nullptr;
+        throw std::runtime_error("Failed to map model file " + path + "!");
+    }
+
+    // Release the mapping if the validation below fails, since the destructor
+    // isn't run for objects whose constructor throws.
+    try {
+        const auto* bytes{static_cast<const char*>(data_)};
+        FileHeader file_header{};
+        std::memcpy(&file_header, bytes, sizeof(file_header));
+        if (!std::equal(std::begin(kMagic), std::end(kMagic), file_header.magic)) {
+            ThrowInvalidFile(path, "unknown format");
+        }
+        if (file_header.version != kVersion) { ThrowInvalidFile(path, "unsupported version"); }
+        if (file_header.scalar_type != ScalarTypeOf<T>()) {
+            ThrowInvalidFile(path, "mismatching scalar type");
+        }
+        if (file_header.file_size != size_ || file_header.num_layers == 0 ||
+            file_header.num_layers > (size_ - sizeof(FileHeader)) / sizeof(LayerHeader)) {
+            ThrowInvalidFile(path, "truncated file");
+        }
+
+        for (std::size_t i{}; i < file_header.num_layers; ++i) {
+            LayerHeader header{};
+            std::memcpy(&header, bytes + sizeof(FileHeader) + i * sizeof(LayerHeader),
+                        sizeof(header));
+            if (header.num_nodes == 0 || header.weight_stride < header.num_weights_per_node ||
+                header.weight_stride > size_ ||
+                !activation::IsValid(header.act_func) ||
+                header.weight_offset % alignof(T) != 0 || 
+                header.bias_offset % alignof(Compute) != 0 ||
+                !IsInFile(header.weight_offset, header.num_nodes, 
+                          header.weight_stride * sizeof(T), size_) ||
+                !IsInFile(header.bias_offset, header.num_nodes, sizeof(Compute), size_)) {
+                ThrowInvalidFile(path, "corrupt layer " + std::to_string(i));
+            }
+            if (!layers_.empty() && 
+                layers_.back().weights.NumRows() != header.num_weights_per_node) {
+                ThrowInvalidFile(path, "mismatching number of weights in layer " + 
+                                       std::to_string(i));
+            }
+            const auto* weights{reinterpret_cast<const T*>(bytes + header.weight_offset)};
+            const auto* bias{reinterpret_cast<const Compute*>(bytes + header.bias_offset)};
+            layers_.push_back({{weights, header.num_nodes, header.num_weights_per_node, 
+                                header.weight_stride},
+                               {bias, header.num_nodes},
+                               header.act_func});
+        }
+    } catch (...) {
+        munmap(data_, size_);
+        throw;
+    }
+
+    output_.resize(layers_.size());
+    for (std::size_t i{}; i < layers_.size(); ++i) {
+        output_[i].resize(layers_[i].weights.NumRows());
+    }
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+BasicMappedNeuralNetwork<T>::~BasicMappedNeuralNetwork(void) {
+    if (data_ != nullptr) { munmap(data_, size_); }
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+std::vector<BasicDenseLayer<T>> BasicMappedNeuralNetwork<T>::CopyLayers(void) const {
+    std::vector<BasicDenseLayer<T>> layers{};
+    layers.reserve(layers_.size());
+    for (const auto& mapped : layers_) {
+        auto& layer{layers.emplace_back(mapped.weights.NumRows(), mapped.weights.NumColumns(),
+                                        mapped.act_func)};
+        for (std::size_t i{}; i < layer.NumNodes(); ++i) {
+            std::copy_n(mapped.weights.Row(i), layer.NumWeightsPerNode(), 
+                        layer.Weights(i).begin());
+        }
+        std::copy(mapped.bias.begin(), mapped.bias.end(), layer.Bias().begin());
+    }
+    return layers;
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+const std::vector<ComputeType<T>>& BasicMappedNeuralNetwork<T>::Predict(
+    const std::vector<Compute>& input) {
+    Feedforward(layers_.front(), {input.data(), 1, input.size()},
+                {output_.front().data(), 1, output_.front().size()});
+    for (std::size_t i{1}; i < layers_.size(); ++i) {
+        Feedforward(layers_[i], {output_[i - 1].data(), 1, output_[i - 1].size()},
+                    {output_[i].data(), 1, output_[i].size()});
+    }
+    return output_.back();
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+bool BasicMappedNeuralNetwork<T>::PredictBatch(const MatrixView<const Compute>& input,
+                                               const MatrixView<Compute>& output) {
+    if (output.NumRows() < input.NumRows() || output.NumColumns() < NumOutputs()) {
+        return false;
+    }
+    const auto batch_size{std::min(kMaxPredictBatchSize, input.NumRows())};
+    batch_output_.resize(layers_.size());
+    for (std::size_t i{}; i < layers_.size(); ++i) {
+        batch_output_[i].Resize(batch_size, layers_[i].weights.NumRows());
+    }
+    for (std::size_t i{}; i < input.NumRows(); i += kMaxPredictBatchSize) {
+        const auto num_sets{std::min(kMaxPredictBatchSize, input.NumRows() - i)};
+        Feedforward(layers_.front(), input.Rows(i, num_sets), batch_output_.front().View());
+        for (std::size_t j{1}; j < layers_.size(); ++j) {
+            Feedforward(layers_[j], batch_output_[j - 1].View().Rows(0, num_sets),
+                        batch_output_[j].View());
+        }
+        for (std::size_t j{}; j < num_sets; ++j) {
+            std::copy_n(batch_output_.back().Row(j), NumOutputs(), output.Row(i + j));
+        }
+    }
+    return true;
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+void BasicMappedNeuralNetwork<T>::Feedforward(const Layer& layer,
+                                              const MatrixView<const Compute>& input,
+                                              const MatrixView<Compute>& output) const {
+    const auto num_sets{std::min(input.NumRows(), output.NumRows())};
+    const auto num_nodes{std::min(layer.weights.NumRows(), output.NumColumns())};
+    linalg::MultiplyTransposed<T, Compute>(input.Rows(0, num_sets),
+                                           layer.weights.Rows(0, num_nodes), output);
+    activation::Dispatch(layer.act_func, [&](const auto act) {
+        for (std::size_t i{}; i < num_sets; ++i) {
+            Compute* row{output.Row(i)};
+            for (std::size_t j{}; j < num_nodes; ++j) { row[j] += layer.bias[j]; }
+            act.Apply(row, num_nodes, fast_math::Accuracy::kExact);
+        }
+    });
+}
+
+template bool model_file::Save(const BasicNeuralNetwork<double>&, const std::string&);
+template bool model_file::Save(const BasicNeuralNetwork<float>&, const std::string&);
+template bool model_file::Save(const BasicNeuralNetwork<BFloat16>&, const std::string&);
+
+template class BasicMappedNeuralNetwork<double>;
+template class BasicMappedNeuralNetwork<float>;
+template class BasicMappedNeuralNetwork<BFloat16>;
+
+} /* namespace machine_learning */
+} /* namespace yrgo */
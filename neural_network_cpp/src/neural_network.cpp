@@ -1,3 +1,10 @@
+#include <algorithm>
+#include <barrier>
+#include <exception>
+#include <limits>
+#include <string>
+
+#include <linalg.hpp>
 #include <neural_network.hpp>
 
 namespace {
@@ -14,107 +21,851 @@ void Print(const std::vector<T>& data, std::ostream& ostream = std::cout) {
     }
     ostream << "]\n";
 }
+
+/********************************************************************************
+ * @brief Copies specified rows into a matrix with specified number of columns.
+ *        Rows that are too short are padded with zeros, rows that are too long
+ *        are truncated.
+ ********************************************************************************/
+template <typename T>
+void CopyRows(const std::vector<std::vector<T>>& rows, const std::size_t num_rows, 
+              const std::size_t num_columns, yrgo::machine_learning::Matrix<T>& matrix) {
+    matrix.Resize(num_rows, num_columns);
+    for (std::size_t i{}; i < num_rows; ++i) {
+        const auto num_copied{std::min(rows[i].size(), num_columns)};
+        std::copy_n(rows[i].begin(), num_copied, matrix.Row(i));
+        std::fill(matrix.Row(i) + num_copied, matrix.Row(i) + num_columns, T{});
+    }
+}
+
 } // namespace
 
 namespace yrgo {
 namespace machine_learning {
 
 // --------------------------------------------------------------------------------
-NeuralNetwork::NeuralNetwork(const std::size_t num_inputs, 
-                             const std::size_t num_hidden_nodes, 
-                             const std::size_t num_outputs,
-                             const ActFunc act_func_hidden, 
-                             const ActFunc act_func_output) 
-    : hidden_layer_(DenseLayer(num_hidden_nodes, num_inputs, act_func_hidden))
-    , output_layer_(DenseLayer(num_outputs, num_hidden_nodes, act_func_output)) {}
+template <typename T>
+BasicInferenceContext<T>::BasicInferenceContext(const BasicNeuralNetwork<T>& network) {
+    Prepare(network);
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+void BasicInferenceContext<T>::Prepare(const BasicNeuralNetwork<T>& network) {
+    const auto& layers{network.Layers()};
+    output_.resize(layers.size());
+    for (std::size_t i{}; i < layers.size(); ++i) {
+        output_[i].resize(layers[i].NumNodes());
+    }
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+void BasicInferenceContext<T>::PrepareBatch(const BasicNeuralNetwork<T>& network, 
+                                            const std::size_t num_sets) {
+    const auto& layers{network.Layers()};
+    batch_output_.resize(layers.size());
+    for (std::size_t i{}; i < layers.size(); ++i) {
+        if (batch_output_[i].NumRows() < num_sets || 
+            batch_output_[i].NumColumns() != layers[i].NumNodes()) {
+            batch_output_[i].Resize(num_sets, layers[i].NumNodes());
+        }
+    }
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+BasicNeuralNetwork<T>::BasicNeuralNetwork(const std::size_t num_inputs, 
+                                          const std::size_t num_hidden_nodes, 
+                                          const std::size_t num_outputs,
+                                          const ActFunc act_func_hidden, 
+                                          const ActFunc act_func_output) 
+    : BasicNeuralNetwork(num_inputs, std::vector<std::size_t>{num_hidden_nodes}, num_outputs,
+                    act_func_hidden, act_func_output) {}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+BasicNeuralNetwork<T>::BasicNeuralNetwork(const std::size_t num_inputs, 
+                                          const std::vector<std::size_t>& num_hidden_nodes, 
+                                          const std::size_t num_outputs,
+                                          const ActFunc act_func_hidden, 
+                                          const ActFunc act_func_output) {
+    if (act_func_hidden == ActFunc::kSoftmax && !num_hidden_nodes.empty()) {
+        throw std::invalid_argument("Softmax is only supported in the output layer!");
+    }
+    auto num_weights_per_node{num_inputs};
+    layers_.reserve(num_hidden_nodes.size() + 1);
+    for (const auto& num_nodes : num_hidden_nodes) {
+        layers_.emplace_back(num_nodes, num_weights_per_node, act_func_hidden);
+        num_weights_per_node = num_nodes;
+    }
+    layers_.emplace_back(num_outputs, num_weights_per_node, act_func_output);
+    BindArena();
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+BasicNeuralNetwork<T>::BasicNeuralNetwork(std::vector<Layer> layers) 
+    : layers_{std::move(layers)} {
+    if (layers_.empty()) { 
+        throw std::invalid_argument("Cannot create neural network without layers!"); 
+    }
+    for (std::size_t i{1}; i < layers_.size(); ++i) {
+        if (layers_[i - 1].ActivationFunction() == ActFunc::kSoftmax) {
+            throw std::invalid_argument("Softmax is only supported in the output layer!");
+        }
+        if (layers_[i].NumWeightsPerNode() != layers_[i - 1].NumNodes()) {
+            throw std::invalid_argument("Mismatching number of weights per node in layer " + 
+                                        std::to_string(i) + "!");
+        }
+    }
+    BindArena();
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+BasicNeuralNetwork<T>::BasicNeuralNetwork(const BasicNeuralNetwork& source)
+    : arena_{source.arena_}
+    , train_input_{source.train_input_}
+    , train_output_{source.train_output_}
+    , external_input_{source.external_input_}
+    , external_output_{source.external_output_}
+    , train_order_{source.train_order_}
+    , validation_input_{source.validation_input_}
+    , validation_output_{source.validation_output_}
+    , validation_prediction_{source.validation_prediction_}
+    , num_updates_{source.num_updates_} {
+    // The layers are pointed at the copied arena instead of copying their buffers.
+    layers_.reserve(source.layers_.size());
+    for (const auto& layer : source.layers_) {
+        layers_.push_back(Layer{layer, source.arena_, arena_});
+    }
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+BasicNeuralNetwork<T>& BasicNeuralNetwork<T>::operator=(const BasicNeuralNetwork& source) {
+    if (this != &source) { *this = BasicNeuralNetwork{source}; }
+    return *this;
+}
 
 // --------------------------------------------------------------------------------
-bool NeuralNetwork::AddTrainingData(const std::vector<std::vector<double>>& train_input,
-                                    const std::vector<std::vector<double>>& train_output) {
-    train_input_ = train_input; 
-    train_output_ = train_output;
-    CheckNumTrainingSets(); 
-    InitTrainOrderVector(); 
+template <typename T>
+bool BasicNeuralNetwork<T>::AddTrainingData(const std::vector<std::vector<Compute>>& train_input,
+                                            const std::vector<std::vector<Compute>>& train_output) {
+    const auto num_sets{std::min(train_input.size(), train_output.size())};
+    CopyRows(train_input, num_sets, NumInputs(), train_input_);
+    CopyRows(train_output, num_sets, NumOutputs(), train_output_);
+    external_input_ = {};
+    external_output_ = {};
+    InitTrainOrderVector(num_sets); 
     return NumTrainingSets() > 0;
 }    
 
 // --------------------------------------------------------------------------------
-bool NeuralNetwork::Train(const std::size_t num_epochs, const double learning_rate) {
-    if (NumTrainingSets() == 0 || num_epochs == 0 || learning_rate <= 0) { return false; }
+template <typename T>
+bool BasicNeuralNetwork<T>::AddTrainingData(Matrix<Compute>&& train_input, 
+                                            Matrix<Compute>&& train_output) {
+    if (train_input.NumColumns() != NumInputs() || train_output.NumColumns() != NumOutputs()) {
+        return false;
+    }
+    const auto num_sets{std::min(train_input.NumRows(), train_output.NumRows())};
+    train_input_ = std::move(train_input);
+    train_output_ = std::move(train_output);
+    external_input_ = {};
+    external_output_ = {};
+    InitTrainOrderVector(num_sets); 
+    return NumTrainingSets() > 0;
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+bool BasicNeuralNetwork<T>::AddTrainingData(const MatrixView<const Compute>& train_input, 
+                                            const MatrixView<const Compute>& train_output) {
+    if (train_input.NumColumns() != NumInputs() || train_output.NumColumns() != NumOutputs()) {
+        return false;
+    }
+    external_input_ = train_input;
+    external_output_ = train_output;
+    train_input_ = {};
+    train_output_ = {};
+    InitTrainOrderVector(std::min(train_input.NumRows(), train_output.NumRows())); 
+    return NumTrainingSets() > 0;
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+bool BasicNeuralNetwork<T>::SetValidationData(
+    const std::vector<std::vector<Compute>>& validation_input,
+    const std::vector<std::vector<Compute>>& validation_output) {
+    const auto num_sets{std::min(validation_input.size(), validation_output.size())};
+    CopyRows(validation_input, num_sets, NumInputs(), validation_input_);
+    CopyRows(validation_output, num_sets, NumOutputs(), validation_output_);
+    validation_prediction_.Resize(num_sets, NumOutputs());
+    return num_sets > 0;
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+bool BasicNeuralNetwork<T>::Train(const std::size_t num_epochs, const Compute learning_rate,
+                                  const std::size_t batch_size) {
+    if (NumTrainingSets() == 0 || num_epochs == 0 || learning_rate <= 0 || batch_size == 0) { 
+        return false; 
+    }
     
-    for (std::size_t i{}; i < num_epochs; ++i) {
-        RandomizeTrainingOrder(); 
-        for (const auto& j : train_order_) {
-            Feedforward(train_input_[j]);
-            Backpropagate(train_output_[j]);
-            Optimize(train_input_[j], learning_rate);
+    BeginProfile();
+    for (std::size_t i{}; i < num_epochs; ++i) { TrainEpoch(learning_rate, batch_size); }
+    EndProfile();
+    return true;
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+template <typename EpochsFunction>
+TrainingReport BasicNeuralNetwork<T>::RunEpochs(const TrainingOptions& options, 
+                                                EpochsFunction&& train_epochs) {
+    const auto start{std::chrono::steady_clock::now()};
+    TrainingReport report{};
+    BeginProfile();
+
+    // The parameters of the best epoch are only copied when they may be restored.
+    // All storage is allocated up front, so the epochs don't allocate any memory.
+    const auto early_stopping{options.patience > 0 && NumValidationSets() > 0};
+    const auto restore_best{early_stopping && options.restore_best};
+    Arena best_arena{};
+    if (restore_best) { best_arena = arena_; }
+    report.training_loss.reserve(options.num_epochs);
+    if (NumValidationSets() > 0) { report.validation_loss.reserve(options.num_epochs); }
+    auto best_loss{std::numeric_limits<double>::infinity()};
+    std::size_t num_epochs_without_improvement{};
+
+    // The epochs are trained by train_epochs, which gets the learning rate of each
+    // epoch and reports the training loss after each epoch. Training stops as soon 
+    // as end_epoch returns false.
+    const auto learning_rate{[&options](const std::size_t epoch) {
+        return training::LearningRate(options.schedule, options.learning_rate, epoch, 
+                                      options.num_epochs);
+    }};
+    const auto end_epoch{[&](const std::size_t epoch, const double training_loss) {
+        const auto loss{NumValidationSets() > 0 ? 
+            ValidationLoss() : std::numeric_limits<double>::quiet_NaN()};
+        report.num_epochs = epoch + 1;
+        report.training_loss.push_back(training_loss);
+        if (options.on_epoch) {
+            options.on_epoch({epoch + 1, learning_rate(epoch), training_loss, loss, 
+                              std::chrono::steady_clock::now() - start});
+        }
+        if (NumValidationSets() == 0) { return true; }
+
+        report.validation_loss.push_back(loss);
+        if (loss < best_loss - options.min_improvement) {
+            best_loss = loss;
+            report.best_epoch = epoch + 1;
+            num_epochs_without_improvement = 0;
+            if (restore_best) { best_arena.CopyFrom(arena_); }
+        } else if (early_stopping && ++num_epochs_without_improvement >= options.patience) {
+            report.stopped_early = true;
+            return false;
+        }
+        return true;
+    }};
+    train_epochs([&learning_rate](const std::size_t epoch) { 
+        return static_cast<Compute>(learning_rate(epoch)); 
+    }, end_epoch);
+    if (restore_best && report.best_epoch > 0 && report.best_epoch < report.num_epochs) { 
+        Restore(best_arena); 
+    }
+    report.wall_time = std::chrono::steady_clock::now() - start;
+    EndProfile();
+    return report;
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+TrainingReport BasicNeuralNetwork<T>::Train(const TrainingOptions& options) {
+    if (NumTrainingSets() == 0 || options.num_epochs == 0 || options.learning_rate <= 0 || 
+        options.batch_size == 0) { 
+        return TrainingReport{}; 
+    }
+    // The worker threads and their contexts are created once for all epochs.
+    return RunEpochs(options, [this, &options](const auto& learning_rate, 
+                                               const auto& end_epoch) {
+        if (options.num_threads > 1) {
+            TrainParallelEpochs(options.num_epochs, learning_rate, options.batch_size, 
+                                options.num_threads, options.mode, end_epoch);
+            return;
+        }
+        for (std::size_t i{}; i < options.num_epochs; ++i) {
+            if (!end_epoch(i, TrainEpoch(learning_rate(i), options.batch_size))) { return; }
+        }
+    });
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+TrainingReport BasicNeuralNetwork<T>::Train(DatasetReader<Compute>& reader, 
+                                            const TrainingOptions& options) {
+    if (reader.NumInputs() != NumInputs() || reader.NumOutputs() != NumOutputs() ||
+        options.num_epochs == 0 || options.learning_rate <= 0 || options.batch_size == 0 || 
+        options.shuffle_buffer_size == 0) { 
+        return TrainingReport{}; 
+    }
+    StreamBuffers buffers{};
+    buffers.input.Resize(options.shuffle_buffer_size, NumInputs());
+    buffers.output.Resize(options.shuffle_buffer_size, NumOutputs());
+    buffers.chunk_input.Resize(options.shuffle_buffer_size, NumInputs());
+    buffers.chunk_output.Resize(options.shuffle_buffer_size, NumOutputs());
+    PrepareTrainingContext(train_context_, options.batch_size);
+    return RunEpochs(options, [&](const auto& learning_rate, const auto& end_epoch) {
+        for (std::size_t i{}; i < options.num_epochs; ++i) {
+            const auto loss{TrainStreamEpoch(reader, buffers, learning_rate(i), 
+                                             options.batch_size)};
+            if (!end_epoch(i, loss)) { return; }
         }
+    });
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+bool BasicNeuralNetwork<T>::TrainParallel(const std::size_t num_epochs, 
+                                          const Compute learning_rate,
+                                          const std::size_t batch_size,
+                                          const std::size_t num_threads,
+                                          const ParallelMode mode) {
+    if (NumTrainingSets() == 0 || num_epochs == 0 || learning_rate <= 0 || batch_size == 0) { 
+        return false; 
     }
+    if (num_threads <= 1) { return Train(num_epochs, learning_rate, batch_size); }
+    BeginProfile();
+    TrainParallelEpochs(num_epochs, [learning_rate](const std::size_t) { return learning_rate; },
+                        batch_size, num_threads, mode, 
+                        [](const std::size_t, const double) { return true; });
+    EndProfile();
     return true;
 }
 
 // --------------------------------------------------------------------------------
-const std::vector<double>& NeuralNetwork::Predict(const std::vector<double>& input) {
-     Feedforward(input);
-     return output_layer_.Output(); 
+template <typename T>
+template <typename LearningRate, typename EndEpoch>
+void BasicNeuralNetwork<T>::TrainParallelEpochs(const std::size_t num_epochs, 
+                                                const LearningRate& learning_rate,
+                                                const std::size_t batch_size,
+                                                const std::size_t num_threads,
+                                                const ParallelMode mode,
+                                                const EndEpoch& end_epoch) {
+    std::vector<TrainingContext> contexts(num_threads);
+    for (auto& context : contexts) {
+        PrepareTrainingContext(context, batch_size);
+    }
+    std::barrier sync{static_cast<std::ptrdiff_t>(num_threads)};
+
+    // The update counts (used by the optimizers) are derived from the epoch and
+    // the batch, so that no counter is shared between the threads. Hogwild threads
+    // count their batches in turns, i.e. batch i of thread t is i * num_threads + t.
+    const auto first_update{num_updates_};
+    const auto num_shard_batches{
+        ((NumTrainingSets() + num_threads - 1) / num_threads + batch_size - 1) / batch_size};
+    const auto num_batches{mode == ParallelMode::kHogwild ? num_shard_batches * num_threads :
+                           (NumTrainingSets() + batch_size - 1) / batch_size};
+
+    // Thread 0 prepares each epoch and ends it (e.g. checks for early stopping) 
+    // while the other threads wait at the barrier. An exception thrown meanwhile
+    // (e.g. by the epoch callback) stops all threads and is rethrown after joining.
+    Compute epoch_learning_rate{};
+    bool stop{false};
+    std::exception_ptr error{};
+    auto begin_epoch{[&](const std::size_t epoch) {
+        RandomizeTrainingOrder();
+        epoch_learning_rate = learning_rate(epoch);
+    }};
+    auto finish_epoch{[&](const std::size_t epoch) {
+        num_updates_ = first_update + (epoch + 1) * num_batches;
+        double loss{};
+        for (const auto& context : contexts) { loss += context.loss; }
+        stop = !end_epoch(epoch, loss / NumTrainingSets()) || epoch + 1 == num_epochs;
+        if (!stop) { begin_epoch(epoch + 1); }
+    }};
+    auto update_step{[&](const std::size_t epoch, const std::size_t batch, 
+                         const std::size_t num_sets) {
+        return optimizer::UpdateStep{epoch_learning_rate, 1.0 / num_sets,
+                                     first_update + epoch * num_batches + batch + 1};
+    }};
+
+    auto train_synchronous{[&](const std::size_t thread, const std::size_t epoch) {
+        for (std::size_t first{}; first < NumTrainingSets(); first += batch_size) {
+            const auto num_sets{std::min(batch_size, NumTrainingSets() - first)};
+            const auto shard_first{first + num_sets * thread / num_threads};
+            const auto shard_last{first + num_sets * (thread + 1) / num_threads};
+            contexts[thread].loss += ComputeGradients(contexts[thread], shard_first, 
+                                                      shard_last - shard_first);
+            sync.arrive_and_wait();
+            ReduceGradients(contexts, update_step(epoch, first / batch_size, num_sets), thread);
+            sync.arrive_and_wait();
+        }
+    }};
+
+    // The parameters are read and written by all threads without synchronization,
+    // which is the defining trade-off of Hogwild training.
+    auto train_hogwild{[&](const std::size_t thread, const std::size_t epoch) {
+        const auto shard_first{NumTrainingSets() * thread / num_threads};
+        const auto shard_last{NumTrainingSets() * (thread + 1) / num_threads};
+        for (std::size_t first{shard_first}; first < shard_last; first += batch_size) {
+            const auto num_sets{std::min(batch_size, shard_last - first)};
+            contexts[thread].loss += ComputeGradients(contexts[thread], first, num_sets);
+            const auto batch{(first - shard_first) / batch_size * num_threads + thread};
+            ApplyGradients(contexts[thread], update_step(epoch, batch, num_sets), 0, 1);
+        }
+    }};
+
+    auto train{[&](const std::size_t thread) {
+        for (std::size_t i{};; ++i) {
+            sync.arrive_and_wait();
+            if (stop) { return; }
+            contexts[thread].loss = 0;
+            if (mode == ParallelMode::kHogwild) {
+                train_hogwild(thread, i);
+            } else {
+                train_synchronous(thread, i);
+            }
+            sync.arrive_and_wait();
+            if (thread != 0) { continue; }
+            try {
+                finish_epoch(i);
+            } catch (...) {
+                error = std::current_exception();
+                stop = true;
+            }
+        }
+    }};
+
+    begin_epoch(0);
+    std::vector<std::thread> threads{};
+    for (std::size_t i{1}; i < num_threads; ++i) {
+        threads.emplace_back(train, i);
+    }
+    train(0);
+    for (auto& thread : threads) { thread.join(); }
+    if (error) { std::rethrow_exception(error); }
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+const std::vector<ComputeType<T>>& BasicNeuralNetwork<T>::Predict(
+    const std::vector<Compute>& input) {
+    return Predict(input, context_);
 }
 
 // --------------------------------------------------------------------------------
-void NeuralNetwork::PrintPredictions(const std::vector<std::vector<double>>& input_sets,
-                                     const std::size_t num_decimals,
-                                     std::ostream& ostream) {
+template <typename T>
+bool BasicNeuralNetwork<T>::PredictBatch(const MatrixView<const Compute>& input, 
+                                         const MatrixView<Compute>& output) {
+    return PredictBatch(input, output, context_);
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+const std::vector<ComputeType<T>>& BasicNeuralNetwork<T>::Predict(
+    const std::vector<Compute>& input, BasicInferenceContext<T>& context) const {
+    context.Prepare(*this);
+    layers_.front().Feedforward(input, context.output_.front());
+    for (std::size_t i{1}; i < layers_.size(); ++i) {
+        layers_[i].Feedforward(context.output_[i - 1], context.output_[i]);
+    }
+    return context.output_.back();
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+bool BasicNeuralNetwork<T>::PredictBatch(const MatrixView<const Compute>& input, 
+                                         const MatrixView<Compute>& output,
+                                         BasicInferenceContext<T>& context) const {
+    if (output.NumRows() < input.NumRows() || output.NumColumns() < NumOutputs()) { 
+        return false; 
+    }
+    context.PrepareBatch(*this, std::min(kMaxPredictBatchSize, input.NumRows()));
+    auto& activations{context.batch_output_};
+    const auto& prediction{activations.back()};
+    for (std::size_t i{}; i < input.NumRows(); i += kMaxPredictBatchSize) {
+        const auto num_sets{std::min(kMaxPredictBatchSize, input.NumRows() - i)};
+        layers_.front().FeedforwardBatch(input.Rows(i, num_sets), activations.front().View());
+        for (std::size_t j{1}; j < layers_.size(); ++j) {
+            layers_[j].FeedforwardBatch(activations[j - 1].View().Rows(0, num_sets), 
+                                        activations[j].View());
+        }
+        for (std::size_t j{}; j < num_sets; ++j) {
+            std::copy_n(prediction.Row(j), NumOutputs(), output.Row(i + j));
+        }
+    }
+    return true;
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+void BasicNeuralNetwork<T>::PrintPredictions(const std::vector<std::vector<Compute>>& input_sets,
+                                             const std::size_t num_decimals,
+                                             std::ostream& ostream) {
     if (input_sets.size() == 0) { return; }
     ostream << std::fixed << std::setprecision(num_decimals);
     ostream << "--------------------------------------------------------------------------------";
     for (const auto& input: input_sets) {
         ostream << "\nInput:\t";
-        Print<double>(input, ostream);
+        Print<Compute>(input, ostream);
         ostream << "Output:\t";
-        Print<double>(Predict(input), ostream);
+        Print<Compute>(Predict(input), ostream);
     }
     ostream << "--------------------------------------------------------------------------------\n\n";
 }
 
 // --------------------------------------------------------------------------------
-void NeuralNetwork::CheckNumTrainingSets() {
-    if (train_input_.size() != train_output_.size()) {
-        const auto num_sets{train_input_.size() < train_output_.size() ?
-            train_input_.size() : train_output_.size()};
-        train_input_.resize(num_sets);
-        train_output_.resize(num_sets);
+template <typename T>
+void BasicNeuralNetwork<T>::PrintProfile(std::ostream& ostream) const {
+    std::vector<std::uint64_t> layer_flops(layers_.size());
+    for (std::size_t i{}; i < layers_.size(); ++i) { layer_flops[i] = layers_[i].NumFlops(); }
+    instrumentation::Print(layer_flops, ostream);
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+void BasicNeuralNetwork<T>::BindArena(void) {
+    // The buffers of all layers are moved into one arena, ordered from input to output.
+    std::size_t size{};
+    for (const auto& layer : layers_) { size += layer.buffers_.Size(); }
+    Arena arena{size};
+    for (auto& layer : layers_) { layer.buffers_ = typename Layer::Buffers{layer.buffers_, arena}; }
+    arena_ = std::move(arena);
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+void BasicNeuralNetwork<T>::BeginProfile(void) {
+    if constexpr (instrumentation::kEnabled) {
+        instrumentation::Reset();
+        for (auto& layer : layers_) { layer.ResetFlops(); }
+    }
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+void BasicNeuralNetwork<T>::EndProfile(void) const {
+    if constexpr (instrumentation::kEnabled) { PrintProfile(std::clog); }
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+MatrixView<const ComputeType<T>> BasicNeuralNetwork<T>::TrainingInput(void) const {
+    return external_input_.Data() != nullptr ? external_input_ : train_input_.View();
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+MatrixView<const ComputeType<T>> BasicNeuralNetwork<T>::TrainingOutput(void) const {
+    return external_output_.Data() != nullptr ? external_output_ : train_output_.View();
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+double BasicNeuralNetwork<T>::ValidationLoss(void) {
+    const instrumentation::ScopedTimer timer{instrumentation::Phase::kValidation};
+    if (!PredictBatch(validation_input_.View(), validation_prediction_.View())) {
+        return std::numeric_limits<double>::quiet_NaN();
     }
+    double loss{};
+    for (std::size_t i{}; i < NumValidationSets(); ++i) {
+        loss += training::Loss(layers_.back().ActivationFunction(), validation_prediction_.Row(i),
+                               validation_output_.Row(i), NumOutputs());
+    }
+    return loss / NumValidationSets();
 }
 
 // --------------------------------------------------------------------------------
-void NeuralNetwork::InitTrainOrderVector() {
-    train_order_.resize(train_input_.size());
+template <typename T>
+void BasicNeuralNetwork<T>::InitTrainOrderVector(const std::size_t num_sets) {
+    train_order_.resize(num_sets);
     for (std::size_t i{}; i < train_order_.size(); ++i) {
         train_order_[i] = i; 
     }
 }
 
 // --------------------------------------------------------------------------------
-void NeuralNetwork::RandomizeTrainingOrder() {
+template <typename T>
+void BasicNeuralNetwork<T>::RandomizeTrainingOrder() {
+    const instrumentation::ScopedTimer timer{instrumentation::Phase::kShuffle};
     utils::random::ShuffleVector<std::size_t>(train_order_);
 }
 
 // --------------------------------------------------------------------------------
-void NeuralNetwork::Feedforward(const std::vector<double>& input) {
-    hidden_layer_.Feedforward(input); 
-    output_layer_.Feedforward(hidden_layer_.Output());
+template <typename T>
+void BasicNeuralNetwork<T>::Feedforward(const std::span<const Compute> input) {
+    layers_.front().Feedforward(input); 
+    for (std::size_t i{1}; i < layers_.size(); ++i) {
+        layers_[i].Feedforward(layers_[i - 1].Output());
+    }
 }
 
 // --------------------------------------------------------------------------------
-void NeuralNetwork::Backpropagate(const std::vector<double>& reference) {
-    output_layer_.Backpropagate(reference);
-    hidden_layer_.Backpropagate(output_layer_);
+template <typename T>
+double BasicNeuralNetwork<T>::Backpropagate(const std::span<const Compute> reference) {
+    const auto loss{layers_.back().Backpropagate(reference)};
+    for (std::size_t i{layers_.size() - 1}; i > 0; --i) {
+        layers_[i - 1].Backpropagate(layers_[i]);
+    }
+    return loss;
 }
 
 // --------------------------------------------------------------------------------
-void NeuralNetwork::Optimize(const std::vector<double>& input, const double learning_rate) {
-    hidden_layer_.Optimize(input, learning_rate);
-    output_layer_.Optimize(hidden_layer_.Output(), learning_rate);
+template <typename T>
+void BasicNeuralNetwork<T>::Optimize(const std::span<const Compute> input, 
+                                     const Compute learning_rate) {
+    // All training paths count the updates of the network, so the bias correction
+    // of Adam continues when the batch size or the data source changes.
+    const optimizer::UpdateStep step{learning_rate, 1, ++num_updates_};
+    layers_.front().Optimize(input, step);
+    for (std::size_t i{1}; i < layers_.size(); ++i) {
+        layers_[i].Optimize(layers_[i - 1].Output(), step);
+    }
 }
 
+// --------------------------------------------------------------------------------
+template <typename T>
+double BasicNeuralNetwork<T>::TrainEpoch(const Compute learning_rate, 
+                                         const std::size_t batch_size) {
+    // The loss of each training set is measured during backpropagation, i.e. 
+    // while the parameters are adjusted, so no extra pass over the data is made.
+    const auto train_input{TrainingInput()};
+    const auto train_output{TrainingOutput()};
+    double loss{};
+    RandomizeTrainingOrder(); 
+    if (batch_size == 1) {
+        for (const auto& i : train_order_) {
+            const std::span<const Compute> input{train_input.Row(i), NumInputs()};
+            Feedforward(input);
+            loss += Backpropagate({train_output.Row(i), NumOutputs()});
+            Optimize(input, learning_rate);
+        }
+    } else {
+        for (std::size_t i{}; i < NumTrainingSets(); i += batch_size) {
+            loss += TrainBatch(i, batch_size, learning_rate);
+        }
+    }
+    return loss / NumTrainingSets();
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+double BasicNeuralNetwork<T>::TrainStreamEpoch(DatasetReader<Compute>& reader, 
+                                               StreamBuffers& buffers,
+                                               const Compute learning_rate, 
+                                               const std::size_t batch_size) {
+    // The shuffle buffer is filled first. Afterwards each incoming set replaces a
+    // randomly selected buffered set, which is trained on, so the sets are shuffled
+    // within a window of the buffer size instead of over the whole dataset.
+    // Time not spent in the nested phases is spent on reading and moving sets.
+    const instrumentation::ScopedTimer timer{instrumentation::Phase::kData};
+    const auto capacity{buffers.input.NumRows()};
+    double loss{};
+    std::size_t num_sets{};
+    reader.Rewind();
+    buffers.size = 0;
+    buffers.num_batched = 0;
+    while (true) {
+        if (buffers.size < capacity) {
+            const auto num_free{capacity - buffers.size};
+            const auto num_read{reader.Read(buffers.input.View().Rows(buffers.size, num_free),
+                                            buffers.output.View().Rows(buffers.size, num_free))};
+            if (num_read == 0) { break; }
+            buffers.size += num_read;
+            continue;
+        }
+        const auto num_read{reader.Read(buffers.chunk_input.View(), buffers.chunk_output.View())};
+        if (num_read == 0) { break; }
+        for (std::size_t i{}; i < num_read; ++i) {
+            const auto slot{utils::random::GetNumber<std::size_t>(0, capacity - 1)};
+            loss += TrainStreamSet(buffers, slot, learning_rate, batch_size);
+            std::copy_n(buffers.chunk_input.Row(i), NumInputs(), buffers.input.Row(slot));
+            std::copy_n(buffers.chunk_output.Row(i), NumOutputs(), buffers.output.Row(slot));
+        }
+        num_sets += num_read;
+    }
+
+    // The remaining sets are drained in random order.
+    while (buffers.size > 0) {
+        const auto slot{utils::random::GetNumber<std::size_t>(0, buffers.size - 1)};
+        loss += TrainStreamSet(buffers, slot, learning_rate, batch_size);
+        --buffers.size;
+        std::copy_n(buffers.input.Row(buffers.size), NumInputs(), buffers.input.Row(slot));
+        std::copy_n(buffers.output.Row(buffers.size), NumOutputs(), buffers.output.Row(slot));
+        ++num_sets;
+    }
+    if (buffers.num_batched > 0) {
+        loss += ComputeBatchGradients(train_context_, buffers.num_batched);
+        ApplyGradients(train_context_, {learning_rate, 1.0 / buffers.num_batched, 
+                                        ++num_updates_}, 0, 1);
+    }
+    return num_sets > 0 ? loss / num_sets : 0.0;
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+double BasicNeuralNetwork<T>::TrainStreamSet(StreamBuffers& buffers, const std::size_t slot, 
+                                             const Compute learning_rate, 
+                                             const std::size_t batch_size) {
+    if (batch_size == 1) {
+        const std::span<const Compute> input{buffers.input.Row(slot), NumInputs()};
+        Feedforward(input);
+        const auto loss{Backpropagate({buffers.output.Row(slot), NumOutputs()})};
+        Optimize(input, learning_rate);
+        return loss;
+    }
+    std::copy_n(buffers.input.Row(slot), NumInputs(), 
+                train_context_.input.Row(buffers.num_batched));
+    std::copy_n(buffers.output.Row(slot), NumOutputs(), 
+                train_context_.reference.Row(buffers.num_batched));
+    if (++buffers.num_batched < batch_size) { return 0.0; }
+    buffers.num_batched = 0;
+    const auto loss{ComputeBatchGradients(train_context_, batch_size)};
+    ApplyGradients(train_context_, {learning_rate, 1.0 / batch_size, ++num_updates_}, 0, 1);
+    return loss;
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+double BasicNeuralNetwork<T>::TrainBatch(const std::size_t first, const std::size_t batch_size, 
+                                         const Compute learning_rate) {
+    const auto num_sets{std::min(batch_size, NumTrainingSets() - first)};
+    PrepareTrainingContext(train_context_, batch_size);
+    const auto loss{ComputeGradients(train_context_, first, num_sets)};
+    ApplyGradients(train_context_, {learning_rate, 1.0 / num_sets, ++num_updates_}, 0, 1);
+    return loss;
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+void BasicNeuralNetwork<T>::PrepareTrainingContext(TrainingContext& context, 
+                                                   const std::size_t batch_size) const {
+    if (context.output.size() == layers_.size() && context.input.NumRows() >= batch_size) {
+        return;
+    }
+    context.input.Resize(batch_size, NumInputs());
+    context.reference.Resize(batch_size, NumOutputs());
+    context.output.resize(layers_.size());
+    context.error.resize(layers_.size());
+    context.weight_gradient.resize(layers_.size());
+    context.bias_gradient.resize(layers_.size());
+    std::size_t gradient_size{};
+    for (const auto& layer : layers_) {
+        const auto stride{utils::memory::PaddedSize<Compute>(layer.NumWeightsPerNode())};
+        gradient_size += Arena::SizeOf<Compute>(layer.NumNodes() * stride) + 
+                         Arena::SizeOf<Compute>(layer.NumNodes());
+    }
+    context.gradients = Arena{gradient_size};
+    for (std::size_t i{}; i < layers_.size(); ++i) {
+        const auto num_nodes{layers_[i].NumNodes()};
+        const auto num_weights{layers_[i].NumWeightsPerNode()};
+        const auto stride{utils::memory::PaddedSize<Compute>(num_weights)};
+        context.output[i].Resize(batch_size, num_nodes);
+        context.error[i].Resize(batch_size, num_nodes);
+        const auto weights{context.gradients.template Allocate<Compute>(num_nodes * stride)};
+        context.weight_gradient[i] = MatrixView<Compute>{weights.data(), num_nodes, num_weights,
+                                                         stride};
+        context.bias_gradient[i] = context.gradients.template Allocate<Compute>(num_nodes);
+    }
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+double BasicNeuralNetwork<T>::ComputeGradients(TrainingContext& context, 
+                                               const std::size_t first, 
+                                               const std::size_t num_sets) const {
+    // The shuffled sets are gathered into the batch, one contiguous row per set.
+    const instrumentation::ScopedTimer timer{instrumentation::Phase::kData};
+    const auto train_input{TrainingInput()};
+    const auto train_output{TrainingOutput()};
+    for (std::size_t i{}; i < num_sets; ++i) {
+        const auto set{train_order_[first + i]};
+        std::copy_n(train_input.Row(set), NumInputs(), context.input.Row(i));
+        std::copy_n(train_output.Row(set), NumOutputs(), context.reference.Row(i));
+    }
+    return ComputeBatchGradients(context, num_sets);
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+double BasicNeuralNetwork<T>::ComputeBatchGradients(TrainingContext& context, 
+                                                    const std::size_t num_sets) const {
+    context.gradients.Clear();
+    if (num_sets == 0) { return 0; }
+
+    const auto input{context.input.View().Rows(0, num_sets)};
+    const auto reference{context.reference.View().Rows(0, num_sets)};
+    auto output{[&context, num_sets](const std::size_t i) { 
+        return context.output[i].View().Rows(0, num_sets); 
+    }};
+    auto error{[&context, num_sets](const std::size_t i) { 
+        return context.error[i].View().Rows(0, num_sets); 
+    }};
+
+    layers_.front().FeedforwardBatch(input, output(0));
+    for (std::size_t i{1}; i < layers_.size(); ++i) {
+        layers_[i].FeedforwardBatch(output(i - 1), output(i));
+    }
+    const auto loss{layers_.back().BackpropagateBatch(output(layers_.size() - 1), reference, 
+                                                      error(layers_.size() - 1))};
+    for (std::size_t i{layers_.size() - 1}; i > 0; --i) {
+        layers_[i - 1].BackpropagateBatch(output(i - 1), layers_[i], error(i), error(i - 1));
+    }
+    layers_.front().AccumulateGradients(input, error(0), context.weight_gradient[0], 
+                                        context.bias_gradient[0]);
+    for (std::size_t i{1}; i < layers_.size(); ++i) {
+        layers_[i].AccumulateGradients(output(i - 1), error(i), context.weight_gradient[i],
+                                       context.bias_gradient[i]);
+    }
+    return loss;
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+void BasicNeuralNetwork<T>::ApplyGradients(const TrainingContext& context, 
+                                           const optimizer::UpdateStep& step, 
+                                           const std::size_t thread, 
+                                           const std::size_t num_threads) {
+    for (std::size_t i{}; i < layers_.size(); ++i) {
+        const auto first_node{layers_[i].NumNodes() * thread / num_threads};
+        const auto last_node{layers_[i].NumNodes() * (thread + 1) / num_threads};
+        layers_[i].ApplyGradients(context.weight_gradient[i], context.bias_gradient[i], 
+                                  step, first_node, last_node - first_node);
+    }
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+void BasicNeuralNetwork<T>::ReduceGradients(std::vector<TrainingContext>& contexts, 
+                                            const optimizer::UpdateStep& step,
+                                            const std::size_t thread) {
+    // Each thread sums and applies the gradients of its own range of nodes, 
+    // so the reduction runs in parallel without any locking.
+    auto& total{contexts.front()};
+    for (std::size_t i{}; i < layers_.size(); ++i) {
+        const auto first_node{layers_[i].NumNodes() * thread / contexts.size()};
+        const auto last_node{layers_[i].NumNodes() * (thread + 1) / contexts.size()};
+        const auto num_weights{layers_[i].NumWeightsPerNode()};
+        for (std::size_t j{1}; j < contexts.size(); ++j) {
+            const auto& context{contexts[j]};
+            for (std::size_t k{first_node}; k < last_node; ++k) {
+                linalg::Axpy(1.0, context.weight_gradient[i].Row(k), 
+                             total.weight_gradient[i].Row(k), num_weights);
+                total.bias_gradient[i][k] += context.bias_gradient[i][k];
+            }
+        }
+    }
+    ApplyGradients(total, step, thread, contexts.size());
+}
+
+template class BasicInferenceContext<double>;
+template class BasicInferenceContext<float>;
+template class BasicInferenceContext<BFloat16>;
+template class BasicNeuralNetwork<double>;
+template class BasicNeuralNetwork<float>;
+template class BasicNeuralNetwork<BFloat16>;
+
 } /* namespace machine_learning */
 } /* namespace yrgo */
\ No newline at end of file
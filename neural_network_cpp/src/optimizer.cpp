@@ -0,0 +1,171 @@
+#include <cmath>
+#include <type_traits>
+
+#include <optimizer.hpp>
+#include <simd.hpp>
+
+namespace yrgo {
+namespace machine_learning {
+namespace optimizer {
+
+namespace {
+
+// See simd.hpp.
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+/********************************************************************************
+ * @brief Fused update of parameters of type T and the optimizer state. Each
+ *        element of every buffer is read and written exactly once.
+ ********************************************************************************/
+template <typename T, OptimizerType Type>
+struct UpdateKernel {
+    using Compute = ComputeType<T>;
+
+    T* parameters;           /* The parameters to update. */
+    const Compute* gradient; /* The gradients of the parameters. */
+    Compute* first;          /* First state buffer (velocity, mean or first moment). */
+    Compute* second;         /* Second state buffer (second moment of Adam). */
+    Compute learning_rate;   /* The learning rate. */
+    Compute scale;           /* Factor to scale the gradients with. */
+    Compute momentum;        /* Momentum, or decay of the first moment. */
+    Compute decay;           /* Decay of the mean squared gradients. */
+    Compute epsilon;         /* Added to the root mean square. */
+    Compute weight_decay;    /* L2 penalty. */
+    Compute correction1;     /* Bias correction of the first moment. */
+    Compute correction2;     /* Bias correction of the second moment. */
+
+    template <typename V>
+    [[gnu::always_inline]] void Apply(const std::size_t i) const {
+        V w{LoadParameters<V>(i)};
+        V d{simd::Load<V>(gradient + i) * scale};
+        if constexpr (Type == OptimizerType::kAdamW) {
+            w -= learning_rate * weight_decay * w;
+        } else {
+            d -= weight_decay * w;
+        }
+
+        if constexpr (Type == OptimizerType::kSgd) {
+            w += learning_rate * d;
+        } else if constexpr (Type == OptimizerType::kMomentum ||
+                             Type == OptimizerType::kNesterov) {
+            const V v{momentum * simd::Load<V>(first + i) + d};
+            simd::Store(first + i, v);
+            w += Type == OptimizerType::kMomentum ? learning_rate * v
+                                                  : learning_rate * (d + momentum * v);
+        } else if constexpr (Type == OptimizerType::kRmsProp) {
+            const V s{decay * simd::Load<V>(first + i) + (Compute{1} - decay) * d * d};
+            simd::Store(first + i, s);
+            w += learning_rate * d / (simd::Sqrt(s) + epsilon);
+        } else {
+            const V m{momentum * simd::Load<V>(first + i) + (Compute{1} - momentum) * d};
+            const V s{decay * simd::Load<V>(second + i) + (Compute{1} - decay) * d * d};
+            simd::Store(first + i, m);
+            simd::Store(second + i, s);
+            w += learning_rate * (m * correction1) / (simd::Sqrt(s * correction2) + epsilon);
+        }
+        StoreParameters(i, w);
+    }
+
+    template <typename V>
+    [[gnu::always_inline]] V LoadParameters(const std::size_t i) const {
+        if constexpr (std::is_same_v<T, Compute>) {
+            return simd::Load<V>(parameters + i);
+        } else {
+            return static_cast<Compute>(parameters[i]);
+        }
+    }
+
+    template <typename V>
+    [[gnu::always_inline]] void StoreParameters(const std::size_t i, const V& w) const {
+        if constexpr (std::is_same_v<T, Compute>) {
+            simd::Store(parameters + i, w);
+        } else {
+            parameters[i] = static_cast<T>(w);
+        }
+    }
+};
+
+// --------------------------------------------------------------------------------
+template <OptimizerType Type, typename T>
+void Run(const OptimizerConfig& config, const UpdateStep& step,
+         const ComputeType<T>* gradient, T* parameters, ComputeType<T>* state,
+         const std::size_t state_stride, const std::size_t size) {
+    using Compute = ComputeType<T>;
+    constexpr bool kIsAdam{Type == OptimizerType::kAdam || Type == OptimizerType::kAdamW};
+    const auto correction{[&step](const double decay) {
+        return kIsAdam ? 1.0 / (1.0 - std::pow(decay, static_cast<double>(step.count))) : 1.0;
+    }};
+    const UpdateKernel<T, Type> kernel{
+        parameters, gradient, state,
+        NumStateBuffers(Type) > 1 ? state + state_stride : nullptr,
+        static_cast<Compute>(step.learning_rate),
+        static_cast<Compute>(step.gradient_scale),
+        static_cast<Compute>(config.momentum),
+        static_cast<Compute>(config.decay),
+        static_cast<Compute>(config.epsilon),
+        static_cast<Compute>(config.weight_decay),
+        static_cast<Compute>(correction(config.momentum)),
+        static_cast<Compute>(correction(config.decay))};
+
+    // Parameters stored with reduced precision are converted one at a time.
+    if constexpr (std::is_same_v<T, Compute>) {
+        simd::Run<T>(size, kernel);
+    } else {
+        for (std::size_t i{}; i < size; ++i) { kernel.template Apply<Compute>(i); }
+    }
+}
+
+} /* namespace */
+
+// --------------------------------------------------------------------------------
+std::size_t NumStateBuffers(const OptimizerType type) {
+    switch (type) {
+        case OptimizerType::kMomentum:
+        case OptimizerType::kNesterov:
+        case OptimizerType::kRmsProp:
+            return 1;
+        case OptimizerType::kAdam:
+        case OptimizerType::kAdamW:
+            return 2;
+        default:
+            return 0;
+    }
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+void Update(const OptimizerConfig& config, const UpdateStep& step,
+            const ComputeType<T>* gradient, T* parameters, ComputeType<T>* state,
+            const std::size_t state_stride, const std::size_t size) {
+    switch (config.type) {
+        case OptimizerType::kMomentum:
+            return Run<OptimizerType::kMomentum>(config, step, gradient, parameters, state,
+                                                 state_stride, size);
+        case OptimizerType::kNesterov:
+            return Run<OptimizerType::kNesterov>(config, step, gradient, parameters, state,
+                                                 state_stride, size);
+        case OptimizerType::kRmsProp:
+            return Run<OptimizerType::kRmsProp>(config, step, gradient, parameters, state,
+                                                state_stride, size);
+        case OptimizerType::kAdam:
+            return Run<OptimizerType::kAdam>(config, step, gradient, parameters, state,
+                                             state_stride, size);
+        case OptimizerType::kAdamW:
+            return Run<OptimizerType::kAdamW>(config, step, gradient, parameters, state,
+                                              state_stride, size);
+        default:
+            return Run<OptimizerType::kSgd>(config, step, gradient, parameters, state,
+                                            state_stride, size);
+    }
+}
+
+template void Update(const OptimizerConfig&, const UpdateStep&, const double*, double*,
+                     double*, const std::size_t, const std::size_t);
+template void Update(const OptimizerConfig&, const UpdateStep&, const float*, float*,
+                     float*, const std::size_t, const std::size_t);
+template void Update(const OptimizerConfig&, const UpdateStep&, const float*, BFloat16*,
+                     float*, const std::size_t, const std::size_t);
+
+} /* namespace optimizer */
+} /* namespace machine_learning */
+} /* namespace yrgo */
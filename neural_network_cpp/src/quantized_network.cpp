@@ -0,0 +1,268 @@
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <stdexcept>
+
+#include <linalg.hpp>
+#include <quantized_network.hpp>
+
+namespace yrgo {
+namespace machine_learning {
+
+namespace {
+
+/********************************************************************************
+ * @brief The largest magnitude of a quantized value. The range is kept
+ *        symmetric, i.e. -128 is never used.
+ ********************************************************************************/
+constexpr float kMaxQuantized{127.0f};
+
+// --------------------------------------------------------------------------------
+float GetScale(const double max_value) {
+    return max_value > 0 ? static_cast<float>(max_value / kMaxQuantized) : 1.0f;
+}
+
+// --------------------------------------------------------------------------------
+std::int8_t Quantize(const float value, const float scale) {
+    const auto quantized{std::lround(value / scale)};
+    return static_cast<std::int8_t>(std::clamp<long>(quantized, -127, 127));
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+double MaxAbs(const MatrixView<const T>& matrix) {
+    double max_value{};
+    for (std::size_t i{}; i < matrix.NumRows(); ++i) {
+        for (std::size_t j{}; j < matrix.NumColumns(); ++j) {
+            max_value = std::max(max_value, std::abs(static_cast<double>(matrix.Row(i)[j])));
+        }
+    }
+    return max_value;
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+std::size_t OriginalSizeInBytes(const BasicNeuralNetwork<T>& network) {
+    std::size_t size{};
+    for (const auto& layer : network.Layers()) {
+        size += layer.NumNodes() * layer.NumWeightsPerNode() * sizeof(T) +
+                layer.NumNodes() * sizeof(ComputeType<T>);
+    }
+    return size;
+}
+
+} /* namespace */
+
+// --------------------------------------------------------------------------------
+template <typename T>
+QuantizedDenseLayer::QuantizedDenseLayer(const BasicDenseLayer<T>& layer,
+                                         const double max_input)
+    : num_weights_per_node_{layer.NumWeightsPerNode()}
+    , weight_stride_{utils::memory::PaddedSize<std::int8_t>(layer.NumWeightsPerNode())}
+    , input_scale_{GetScale(max_input)}
+    , act_func_{layer.ActivationFunction()} {
+    weights_.resize(layer.NumNodes() * weight_stride_, 0);
+    output_scale_.resize(layer.NumNodes());
+    bias_.resize(layer.NumNodes());
+    for (std::size_t i{}; i < layer.NumNodes(); ++i) {
+        const auto weights{layer.Weights(i)};
+        double max_weight{};
+        for (const auto& weight : weights) {
+            max_weight = std::max(max_weight, std::abs(static_cast<double>(weight)));
+        }
+        const auto weight_scale{GetScale(max_weight)};
+        for (std::size_t j{}; j < weights.size(); ++j) {
+            weights_[i * weight_stride_ + j] = 
+                Quantize(static_cast<float>(weights[j]), weight_scale);
+        }
+        output_scale_[i] = weight_scale * input_scale_;
+        bias_[i] = static_cast<float>(layer.Bias()[i]);
+    }
+}
+
+// --------------------------------------------------------------------------------
+std::size_t QuantizedDenseLayer::SizeInBytes(void) const {
+    return NumNodes() * (num_weights_per_node_ * sizeof(std::int8_t) + 2 * sizeof(float));
+}
+
+// --------------------------------------------------------------------------------
+void QuantizedDenseLayer::Feedforward(const std::span<const float> input,
+                                      const std::span<float> output,
+                                      std::vector<std::int8_t>& buffer) const {
+    const auto num_inputs{std::min(num_weights_per_node_, input.size())};
+    const auto num_nodes{std::min(NumNodes(), output.size())};
+    buffer.resize(num_inputs);
+    for (std::size_t i{}; i < num_inputs; ++i) {
+        buffer[i] = Quantize(input[i], input_scale_);
+    }
+    for (std::size_t i{}; i < num_nodes; ++i) {
+        const auto sum{linalg::DotInt8(weights_.data() + i * weight_stride_, buffer.data(),
+                                       num_inputs)};
+        output[i] = bias_[i] + output_scale_[i] * static_cast<float>(sum);
+    }
+    activation::Dispatch(act_func_, [&](const auto act) {
+        act.Apply(output.data(), num_nodes, fast_math::Accuracy::kExact);
+    });
+}
+
+// --------------------------------------------------------------------------------
+void QuantizedDenseLayer::FeedforwardBatch(const MatrixView<const float>& input,
+                                           const MatrixView<float>& output,
+                                           Matrix<std::int8_t>& buffer) const {
+    const auto num_sets{std::min(input.NumRows(), output.NumRows())};
+    const auto num_inputs{std::min(num_weights_per_node_, input.NumColumns())};
+    const auto num_nodes{std::min(NumNodes(), output.NumColumns())};
+    buffer.Resize(num_sets, num_inputs);
+    for (std::size_t i{}; i < num_sets; ++i) {
+        for (std::size_t j{}; j < num_inputs; ++j) {
+            buffer.Row(i)[j] = Quantize(input.Row(i)[j], input_scale_);
+        }
+    }
+    for (std::size_t j{}; j < num_nodes; ++j) {
+        const auto weights{weights_.data() + j * weight_stride_};
+        for (std::size_t i{}; i < num_sets; ++i) {
+            const auto sum{linalg::DotInt8(weights, buffer.Row(i), num_inputs)};
+            output.Row(i)[j] = bias_[j] + output_scale_[j] * static_cast<float>(sum);
+        }
+    }
+    activation::Dispatch(act_func_, [&](const auto act) {
+        for (std::size_t i{}; i < num_sets; ++i) {
+            act.Apply(output.Row(i), num_nodes, fast_math::Accuracy::kExact);
+        }
+    });
+}
+
+// --------------------------------------------------------------------------------
+void QuantizationReport::Print(std::ostream& ostream) const {
+    ostream << "--------------------------------------------------------------------------------\n";
+    ostream << "Compared input sets:\t" << num_sets << "\n";
+    ostream << std::scientific << std::setprecision(3);
+    ostream << "Max absolute error:\t" << max_error << "\n";
+    ostream << "Mean absolute error:\t" << mean_error << "\n";
+    ostream << std::defaultfloat;
+    ostream << "Original size:\t\t" << original_size << " bytes\n";
+    ostream << "Quantized size:\t\t" << quantized_size << " bytes\n";
+    ostream << "--------------------------------------------------------------------------------\n\n";
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+QuantizedNeuralNetwork::QuantizedNeuralNetwork(const BasicNeuralNetwork<T>& network,
+                                               const MatrixView<const ComputeType<T>>& calibration) {
+    if (calibration.NumRows() == 0) {
+        throw std::invalid_argument("Cannot quantize neural network without calibration sets!");
+    }
+    // Feed the calibration sets through the original layers one at a time to
+    // find the input range of every layer.
+    Matrix<ComputeType<T>> input{};
+    Matrix<ComputeType<T>> output{};
+    auto layer_input{calibration};
+    layers_.reserve(network.NumLayers());
+    for (const auto& layer : network.Layers()) {
+        layers_.emplace_back(layer, MaxAbs(layer_input));
+        output.Resize(calibration.NumRows(), layer.NumNodes());
+        layer.FeedforwardBatch(layer_input, output.View());
+        std::swap(input, output);
+        layer_input = input.View();
+    }
+    output_.resize(layers_.size());
+    for (std::size_t i{}; i < layers_.size(); ++i) {
+        output_[i].resize(layers_[i].NumNodes());
+    }
+}
+
+// --------------------------------------------------------------------------------
+std::size_t QuantizedNeuralNetwork::SizeInBytes(void) const {
+    std::size_t size{};
+    for (const auto& layer : layers_) { size += layer.SizeInBytes(); }
+    return size;
+}
+
+// --------------------------------------------------------------------------------
+const std::vector<float>& QuantizedNeuralNetwork::Predict(const std::vector<float>& input) {
+    layers_.front().Feedforward(input, output_.front(), buffer_);
+    for (std::size_t i{1}; i < layers_.size(); ++i) {
+        layers_[i].Feedforward(output_[i - 1], output_[i], buffer_);
+    }
+    return output_.back();
+}
+
+// --------------------------------------------------------------------------------
+bool QuantizedNeuralNetwork::PredictBatch(const MatrixView<const float>& input,
+                                          const MatrixView<float>& output) {
+    if (output.NumRows() < input.NumRows() || output.NumColumns() < NumOutputs()) {
+        return false;
+    }
+    // The scratch matrices are only reallocated when a larger batch is passed.
+    const auto batch_size{std::min(kMaxPredictBatchSize, input.NumRows())};
+    batch_output_.resize(layers_.size());
+    for (std::size_t i{}; i < layers_.size(); ++i) {
+        batch_output_[i].Resize(batch_size, layers_[i].NumNodes());
+    }
+    const auto& prediction{batch_output_.back()};
+    for (std::size_t i{}; i < input.NumRows(); i += kMaxPredictBatchSize) {
+        const auto num_sets{std::min(kMaxPredictBatchSize, input.NumRows() - i)};
+        layers_.front().FeedforwardBatch(input.Rows(i, num_sets), batch_output_.front().View(),
+                                         batch_buffer_);
+        for (std::size_t j{1}; j < layers_.size(); ++j) {
+            layers_[j].FeedforwardBatch(batch_output_[j - 1].View().Rows(0, num_sets),
+                                        batch_output_[j].View(), batch_buffer_);
+        }
+        for (std::size_t j{}; j < num_sets; ++j) {
+            std::copy_n(prediction.Row(j), NumOutputs(), output.Row(i + j));
+        }
+    }
+    return true;
+}
+
+// --------------------------------------------------------------------------------
+template <typename T>
+QuantizationReport QuantizedNeuralNetwork::Compare(const BasicNeuralNetwork<T>& network,
+                                                   const MatrixView<const ComputeType<T>>& input) {
+    QuantizationReport report{};
+    report.original_size = OriginalSizeInBytes(network);
+    report.quantized_size = SizeInBytes();
+    BasicInferenceContext<T> context{network};
+    std::vector<ComputeType<T>> original_input(network.NumInputs());
+    std::vector<float> quantized_input(NumInputs());
+    const auto num_columns{std::min(input.NumColumns(), NumInputs())};
+    double total_error{};
+
+    for (std::size_t i{}; i < input.NumRows(); ++i) {
+        std::copy_n(input.Row(i), num_columns, original_input.begin());
+        std::copy_n(input.Row(i), num_columns, quantized_input.begin());
+        const auto& expected{network.Predict(original_input, context)};
+        const auto& actual{Predict(quantized_input)};
+        for (std::size_t j{}; j < NumOutputs(); ++j) {
+            const auto error{std::abs(static_cast<double>(expected[j]) - actual[j])};
+            report.max_error = std::max(report.max_error, error);
+            total_error += error;
+        }
+    }
+    report.num_sets = input.NumRows();
+    if (report.num_sets > 0) {
+        report.mean_error = total_error / (report.num_sets * NumOutputs());
+    }
+    return report;
+}
+
+template QuantizedDenseLayer::QuantizedDenseLayer(const BasicDenseLayer<double>&, const double);
+template QuantizedDenseLayer::QuantizedDenseLayer(const BasicDenseLayer<float>&, const double);
+template QuantizedDenseLayer::QuantizedDenseLayer(const BasicDenseLayer<BFloat16>&, const double);
+
+template QuantizedNeuralNetwork::QuantizedNeuralNetwork(const BasicNeuralNetwork<double>&,
+                                                        const MatrixView<const double>&);
+template QuantizedNeuralNetwork::QuantizedNeuralNetwork(const BasicNeuralNetwork<float>&,
+                                                        const MatrixView<const float>&);
+template QuantizedNeuralNetwork::QuantizedNeuralNetwork(const BasicNeuralNetwork<BFloat16>&,
+                                                        const MatrixView<const float>&);
+
+template QuantizationReport QuantizedNeuralNetwork::Compare(const BasicNeuralNetwork<double>&,
+                                                            const MatrixView<const double>&);
+template QuantizationReport QuantizedNeuralNetwork::Compare(const BasicNeuralNetwork<float>&,
+                                                            const MatrixView<const float>&);
+template QuantizationReport QuantizedNeuralNetwork::Compare(const BasicNeuralNetwork<BFloat16>&,
+                                                            const MatrixView<const float>&);
+
+} /* namespace machine_learning */
+} /* namespace yrgo */
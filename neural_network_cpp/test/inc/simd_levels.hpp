@@ -0,0 +1,29 @@
+/********************************************************************************
+ * @brief Contains a helper for running tests with every instruction set 
+ *        supported by the CPU.
+ ********************************************************************************/
+#pragma once
+
+#include <vector>
+
+#include <linalg.hpp>
+
+namespace yrgo {
+namespace machine_learning {
+namespace test {
+
+/********************************************************************************
+ * @brief Provides the instruction sets supported by the CPU, starting with the
+ *        scalar kernels.
+ ********************************************************************************/
+inline std::vector<linalg::SimdLevel> SupportedLevels(void) {
+    std::vector<linalg::SimdLevel> levels{linalg::SimdLevel::kScalar};
+    for (const auto level : {linalg::SimdLevel::kAvx2, linalg::SimdLevel::kAvx512}) {
+        if (level <= linalg::SupportedSimdLevel()) { levels.push_back(level); }
+    }
+    return levels;
+}
+
+} /* namespace test */
+} /* namespace machine_learning */
+} /* namespace yrgo */
@@ -0,0 +1,42 @@
+/********************************************************************************
+ * @brief Contains a helper for tests writing files.
+ ********************************************************************************/
+#pragma once
+
+#include <filesystem>
+#include <string>
+
+namespace yrgo {
+namespace machine_learning {
+namespace test {
+
+/********************************************************************************
+ * @brief Temporary file removed when the test ends.
+ ********************************************************************************/
+class TemporaryFile {
+  public:
+
+    /********************************************************************************
+     * @brief Creates the path of a file with specified name in the temporary
+     *        directory. The file itself is created by the test.
+     ********************************************************************************/
+    explicit TemporaryFile(const std::string& name)
+        : path_{(std::filesystem::temp_directory_path() / name).string()} {}
+
+    /********************************************************************************
+     * @brief Removes the file, if created.
+     ********************************************************************************/
+    ~TemporaryFile(void) { std::filesystem::remove(path_); }
+
+    /********************************************************************************
+     * @brief Provides the path of the file.
+     ********************************************************************************/
+    const std::string& Path(void) const { return path_; }
+
+  private:
+    std::string path_{}; /* The path of the file. */
+};
+
+} /* namespace test */
+} /* namespace machine_learning */
+} /* namespace yrgo */
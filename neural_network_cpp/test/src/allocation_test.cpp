@@ -0,0 +1,234 @@
+/********************************************************************************
+ * @brief Tests verifying that training and inference don't allocate memory once
+ *        warmed up. The global allocation functions are replaced by versions
+ *        counting the allocations made while a test has armed the counter, so
+ *        any allocation in the steady state is caught, including allocations
+ *        made by background threads such as the one of PrefetchReader.
+ ********************************************************************************/
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <string>
+#include <vector>
+#include <dataset.hpp>
+#include <matrix.hpp>
+#include <neural_network.hpp>
+#include <temporary_file.hpp>
+
+namespace {
+
+/********************************************************************************
+ * @brief The number of allocations made while armed, see AllocationCounter.
+ ********************************************************************************/
+std::atomic<bool> armed{false};
+std::atomic<std::size_t> num_allocations{0};
+
+void* Allocate(const std::size_t size, const std::size_t alignment) {
+    if (armed) { ++num_allocations; }
+    const auto rounded_size{(size + alignment - 1) / alignment * alignment};
+    auto data{alignment > alignof(std::max_align_t) ? std::aligned_alloc(alignment, rounded_size)
+                                                    : std::malloc(size > 0 ? size : 1)};
+    if (data == nullptr) { throw std::bad_alloc{}; }
+    return data;
+}
+
+/********************************************************************************
+ * @brief Counts the allocations of all threads during its lifetime.
+ ********************************************************************************/
+class AllocationCounter {
+  public:
+    AllocationCounter(void) {
+        num_allocations = 0;
+        armed = true;
+    }
+    ~AllocationCounter(void) { armed = false; }
+    std::size_t Count(void) const { return num_allocations; }
+};
+
+} /* namespace */
+
+void* operator new(std::size_t size) { return Allocate(size, alignof(std::max_align_t)); }
+void* operator new[](std::size_t size) { return Allocate(size, alignof(std::max_align_t)); }
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return Allocate(size, static_cast<std::size_t>(alignment));
+}
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return Allocate(size, static_cast<std::size_t>(alignment));
+}
+void operator delete(void* data) noexcept { std::free(data); }
+void operator delete[](void* data) noexcept { std::free(data); }
+void operator delete(void* data, std::size_t) noexcept { std::free(data); }
+void operator delete[](void* data, std::size_t) noexcept { std::free(data); }
+void operator delete(void* data, std::align_val_t) noexcept { std::free(data); }
+void operator delete[](void* data, std::align_val_t) noexcept { std::free(data); }
+void operator delete(void* data, std::size_t, std::align_val_t) noexcept { std::free(data); }
+void operator delete[](void* data, std::size_t, std::align_val_t) noexcept { std::free(data); }
+
+using namespace yrgo::machine_learning;
+using test::TemporaryFile;
+
+namespace {
+
+NeuralNetwork CreateNetwork(void) {
+    yrgo::utils::random::Seed(1);
+    NeuralNetwork network{4, std::vector<std::size_t>{8, 8}, 2, ActFunc::kTanh, ActFunc::kTanh};
+    Matrix<double> input{64, 4};
+    Matrix<double> output{64, 2};
+    for (std::size_t i{}; i < 64; ++i) {
+        yrgo::utils::random::Fill(input.Row(i), 4, -1.0, 1.0);
+        yrgo::utils::random::Fill(output.Row(i), 2, -1.0, 1.0);
+    }
+    network.AddTrainingData(std::move(input), std::move(output));
+    return network;
+}
+
+TEST(AllocationTest, CounterCatchesAllocations) {
+    const AllocationCounter counter{};
+    const auto vector{new std::vector<double>(100)};
+    delete vector;
+    EXPECT_EQ(counter.Count(), 2U);
+}
+
+TEST(AllocationTest, TrainingIsAllocationFree) {
+    for (const auto batch_size : {1U, 16U}) {
+        auto network{CreateNetwork()};
+        ASSERT_TRUE(network.Train(1, 0.01, batch_size));
+        const AllocationCounter counter{};
+        ASSERT_TRUE(network.Train(10, 0.01, batch_size));
+        EXPECT_EQ(counter.Count(), 0U) << "batch size " << batch_size;
+    }
+}
+
+/********************************************************************************
+ * @brief Reader streaming the sets of a matrix in order.
+ ********************************************************************************/
+class MatrixReader : public DatasetReader<double> {
+  public:
+    MatrixReader(const Matrix<double>& input, const Matrix<double>& output)
+        : input_{input}
+        , output_{output} {}
+
+    std::size_t NumInputs(void) const override { return input_.NumColumns(); }
+    std::size_t NumOutputs(void) const override { return output_.NumColumns(); }
+
+    std::size_t Read(const MatrixView<double>& input, const MatrixView<double>& output) override {
+        std::size_t num_read{};
+        for (; num_read < input.NumRows() && next_set_ < input_.NumRows(); ++num_read) {
+            std::copy_n(input_.Row(next_set_), NumInputs(), input.Row(num_read));
+            std::copy_n(output_.Row(next_set_), NumOutputs(), output.Row(num_read));
+            ++next_set_;
+        }
+        return num_read;
+    }
+
+    void Rewind(void) override { next_set_ = 0; }
+
+  private:
+    const Matrix<double>& input_;
+    const Matrix<double>& output_;
+    std::size_t next_set_{};
+};
+
+/********************************************************************************
+ * @brief Provides training options counting the allocations made from the end
+ *        of the first epoch to the end of the last epoch.
+ ********************************************************************************/
+TrainingOptions SteadyStateOptions(const std::size_t batch_size, std::size_t& count) {
+    TrainingOptions options{};
+    options.num_epochs = 20;
+    options.batch_size = batch_size;
+    options.patience = 20;
+    options.shuffle_buffer_size = 16;
+    options.on_epoch = [&count, num_epochs = options.num_epochs](const EpochMetrics& metrics) {
+        if (metrics.epoch == 1) {
+            num_allocations = 0;
+            armed = true;
+        } else if (metrics.epoch == num_epochs) {
+            armed = false;
+            count = num_allocations;
+        }
+    };
+    return options;
+}
+
+TEST(AllocationTest, EpochsAreAllocationFree) {
+    for (const auto batch_size : {1U, 16U}) {
+        auto network{CreateNetwork()};
+        ASSERT_TRUE(network.SetValidationData({{0.1, 0.2, 0.3, 0.4}, {-0.4, 0.3, -0.2, 0.1}},
+                                              {{0.5, -0.5}, {-0.5, 0.5}}));
+        std::size_t count{1};
+        const auto report{network.Train(SteadyStateOptions(batch_size, count))};
+        EXPECT_EQ(report.num_epochs, 20U);
+        EXPECT_EQ(count, 0U) << "batch size " << batch_size;
+    }
+}
+
+/********************************************************************************
+ * @brief Provides the value of input/output j of set i in the test datasets.
+ ********************************************************************************/
+double Value(const std::size_t i, const std::size_t j) { return (i % 7) * 0.125 - j * 0.25; }
+
+/********************************************************************************
+ * @brief Streams the training of specified reader and verifies that the epochs
+ *        after the first one don't allocate memory.
+ ********************************************************************************/
+void ExpectStreamingAllocationFree(DatasetReader<double>& reader, const char* name) {
+    auto network{CreateNetwork()};
+    for (const auto batch_size : {1U, 16U}) {
+        std::size_t count{1};
+        const auto report{network.Train(reader, SteadyStateOptions(batch_size, count))};
+        EXPECT_EQ(report.num_epochs, 20U);
+        EXPECT_EQ(count, 0U) << name << ", batch size " << batch_size;
+    }
+}
+
+TEST(AllocationTest, StreamingEpochsAreAllocationFree) {
+    Matrix<double> input{100, 4};
+    Matrix<double> output{100, 2};
+    MatrixReader matrix_reader{input, output};
+    ExpectStreamingAllocationFree(matrix_reader, "MatrixReader");
+
+    const TemporaryFile csv_file{"allocation_test.csv"};
+    const TemporaryFile binary_file{"allocation_test.bin"};
+    {
+        std::ofstream csv{csv_file.Path()};
+        std::ofstream binary{binary_file.Path(), std::ios::binary};
+        for (std::size_t i{}; i < 100; ++i) {
+            for (std::size_t j{}; j < 6; ++j) {
+                const auto value{static_cast<float>(Value(i, j))};
+                csv << value << (j + 1 < 6 ? "," : "\n");
+                binary.write(reinterpret_cast<const char*>(&value), sizeof(value));
+            }
+        }
+    }
+    CsvReader<double> csv_reader{csv_file.Path(), 4, 2};
+    ExpectStreamingAllocationFree(csv_reader, "CsvReader");
+    BinaryReader<double> binary_reader{binary_file.Path(), 4, 2};
+    ExpectStreamingAllocationFree(binary_reader, "BinaryReader");
+    PrefetchReader<double> prefetch_reader{csv_reader, 32};
+    ExpectStreamingAllocationFree(prefetch_reader, "PrefetchReader");
+}
+
+TEST(AllocationTest, InferenceIsAllocationFree) {
+    auto network{CreateNetwork()};
+    const std::vector<double> input{0.1, 0.2, 0.3, 0.4};
+    Matrix<double> batch_input{32, 4};
+    Matrix<double> batch_output{32, 2};
+    network.Predict(input);
+    network.PredictBatch(batch_input.View(), batch_output.View());
+
+    const AllocationCounter counter{};
+    for (std::size_t i{}; i < 100; ++i) { network.Predict(input); }
+    network.PredictBatch(batch_input.View(), batch_output.View());
+    EXPECT_EQ(counter.Count(), 0U);
+}
+
+} /* namespace */
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,119 @@
+/********************************************************************************
+ * @brief Unit tests for the Arena class and the model arena of neural networks.
+ ********************************************************************************/
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <new>
+#include <vector>
+#include <arena.hpp>
+#include <neural_network.hpp>
+
+using namespace yrgo::machine_learning;
+
+namespace {
+
+template <typename U>
+bool IsAligned(const U* data) {
+    return reinterpret_cast<std::uintptr_t>(data) % yrgo::utils::memory::kCacheLineSize == 0;
+}
+
+template <typename U>
+bool IsInside(const std::span<U> buffer, const Arena& arena) {
+    const auto data{reinterpret_cast<const std::byte*>(buffer.data())};
+    return data >= arena.Data() && data + buffer.size_bytes() <= arena.Data() + arena.Size();
+}
+
+NeuralNetwork CreateNetwork(void) {
+    yrgo::utils::random::Seed(1);
+    NeuralNetwork network{2, std::vector<std::size_t>{3, 3}, 1, ActFunc::kTanh, ActFunc::kTanh};
+    network.AddTrainingData({{0, 0}, {0, 1}, {1, 0}, {1, 1}}, {{0}, {1}, {1}, {0}});
+    return network;
+}
+
+TEST(ArenaTest, AllocatesAlignedZeroedBuffers) {
+    Arena arena{Arena::SizeOf<double>(3) + Arena::SizeOf<float>(20)};
+    const auto first{arena.Allocate<double>(3)};
+    const auto second{arena.Allocate<float>(20)};
+    EXPECT_TRUE(IsAligned(first.data()));
+    EXPECT_TRUE(IsAligned(second.data()));
+    EXPECT_EQ(arena.Used(), arena.Size());
+    for (const auto value : first) { EXPECT_EQ(value, 0.0); }
+    for (const auto value : second) { EXPECT_EQ(value, 0.0f); }
+    EXPECT_THROW(arena.Allocate<double>(1), std::bad_alloc);
+}
+
+TEST(ArenaTest, CopiesAndRebasesBuffers) {
+    Arena arena{Arena::SizeOf<double>(4) * 2};
+    arena.Allocate<double>(4);
+    const auto buffer{arena.Allocate<double>(4)};
+    buffer[2] = 3.0;
+
+    Arena copy{arena};
+    const auto rebased{copy.Rebase(buffer, arena)};
+    EXPECT_NE(rebased.data(), buffer.data());
+    EXPECT_EQ(rebased[2], 3.0);
+
+    rebased[2] = 4.0;
+    EXPECT_TRUE(arena.CopyFrom(copy));
+    EXPECT_EQ(buffer[2], 4.0);
+    EXPECT_FALSE(arena.CopyFrom(Arena{1}));
+}
+
+TEST(ArenaTest, LayerBuffersLieInModelArena) {
+    auto network{CreateNetwork()};
+    network.SetOptimizer(OptimizerConfig{OptimizerType::kAdam});
+    const auto& arena{network.ModelArena()};
+    ASSERT_GT(arena.Size(), 0U);
+    EXPECT_EQ(arena.Used(), arena.Size());
+    for (const auto& layer : network.Layers()) {
+        EXPECT_TRUE(IsInside(layer.WeightMatrix(), arena));
+        EXPECT_TRUE(IsInside(layer.Bias(), arena));
+        EXPECT_TRUE(IsInside(layer.Output(), arena));
+        EXPECT_TRUE(IsAligned(layer.WeightMatrix().data()));
+        EXPECT_TRUE(IsAligned(layer.Output().data()));
+    }
+}
+
+TEST(ArenaTest, CopiedNetworkOwnsItsArena) {
+    auto network{CreateNetwork()};
+    const auto expected{network.Predict({0, 1})};
+    auto copy{network};
+    EXPECT_NE(copy.ModelArena().Data(), network.ModelArena().Data());
+    for (const auto& layer : copy.Layers()) {
+        EXPECT_TRUE(IsInside(layer.WeightMatrix(), copy.ModelArena()));
+    }
+    EXPECT_EQ(copy.Predict({0, 1}), expected);
+
+    ASSERT_TRUE(copy.Train(100, 0.1));
+    EXPECT_NE(copy.Predict({0, 1}), expected);
+    EXPECT_EQ(network.Predict({0, 1}), expected);
+}
+
+TEST(ArenaTest, RestoresSnapshot) {
+    auto network{CreateNetwork()};
+    network.SetOptimizer(OptimizerConfig{OptimizerType::kMomentum});
+    const auto expected{network.Predict({1, 0})};
+    const Arena snapshot{network.ModelArena()};
+
+    ASSERT_TRUE(network.Train(100, 0.1));
+    EXPECT_NE(network.Predict({1, 0}), expected);
+    EXPECT_TRUE(network.Restore(snapshot));
+    EXPECT_EQ(network.Predict({1, 0}), expected);
+    EXPECT_FALSE(network.Restore(Arena{}));
+}
+
+TEST(ArenaTest, SetOptimizerKeepsParameters) {
+    auto network{CreateNetwork()};
+    const auto expected{network.Predict({1, 1})};
+    const auto size{network.ModelArena().Size()};
+    network.SetOptimizer(OptimizerConfig{OptimizerType::kAdam});
+    EXPECT_GT(network.ModelArena().Size(), size);
+    EXPECT_EQ(network.Predict({1, 1}), expected);
+}
+
+} /* namespace */
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
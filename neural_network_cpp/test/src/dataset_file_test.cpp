@@ -0,0 +1,132 @@
+/********************************************************************************
+ * @brief Unit tests for the binary dataset files. Datasets are saved to temporary
+ *        files, which are then mapped and compared with the original sets.
+ ********************************************************************************/
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <dataset_file.hpp>
+#include <neural_network.hpp>
+#include <temporary_file.hpp>
+
+using namespace yrgo::machine_learning;
+using test::TemporaryFile;
+
+namespace {
+
+template <typename T>
+Matrix<T> CreateMatrix(const std::size_t num_rows, const std::size_t num_columns) {
+    Matrix<T> matrix{num_rows, num_columns};
+    for (std::size_t i{}; i < num_rows; ++i) {
+        for (std::size_t j{}; j < num_columns; ++j) {
+            matrix.Row(i)[j] = yrgo::utils::random::GetNumber<T>(-1, 1);
+        }
+    }
+    return matrix;
+}
+
+template <typename T>
+void ExpectSameMatrix(const MatrixView<const T>& expected, const MatrixView<const T>& actual) {
+    ASSERT_EQ(expected.NumRows(), actual.NumRows());
+    ASSERT_EQ(expected.NumColumns(), actual.NumColumns());
+    for (std::size_t i{}; i < expected.NumRows(); ++i) {
+        for (std::size_t j{}; j < expected.NumColumns(); ++j) {
+            EXPECT_EQ(expected.Row(i)[j], actual.Row(i)[j]);
+        }
+    }
+}
+
+template <typename T>
+void ExpectSameSets(const std::string& name) {
+    const auto input{CreateMatrix<T>(37, 5)};
+    const auto output{CreateMatrix<T>(37, 3)};
+    const TemporaryFile file{name};
+    ASSERT_TRUE(dataset_file::Save<T>(input.View(), output.View(), file.Path()));
+
+    MappedDataset<T> dataset{file.Path()};
+    EXPECT_EQ(dataset.NumSets(), 37U);
+    EXPECT_EQ(dataset.NumInputs(), 5U);
+    EXPECT_EQ(dataset.NumOutputs(), 3U);
+    ExpectSameMatrix<T>(input.View(), dataset.Inputs());
+    ExpectSameMatrix<T>(output.View(), dataset.Outputs());
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(dataset.Inputs().Row(1)) %
+              yrgo::utils::memory::kCacheLineSize, 0U);
+
+    // The sets are also provided in order through the reader interface.
+    Matrix<T> read_input{40, 5};
+    Matrix<T> read_output{40, 3};
+    for (std::size_t i{}; i < 2; ++i) {
+        ASSERT_EQ(dataset.Read(read_input.View(), read_output.View()), 37U);
+        EXPECT_EQ(dataset.Read(read_input.View(), read_output.View()), 0U);
+        ExpectSameMatrix<T>(input.View(), read_input.View().Rows(0, 37));
+        ExpectSameMatrix<T>(output.View(), read_output.View().Rows(0, 37));
+        dataset.Rewind();
+    }
+}
+
+TEST(DatasetFileTest, MappedSetsMatchOriginal) {
+    ExpectSameSets<double>("dataset_file_test_f64.bin");
+    ExpectSameSets<float>("dataset_file_test_f32.bin");
+}
+
+TEST(DatasetFileTest, InputsOnly) {
+    const auto input{CreateMatrix<double>(10, 2)};
+    const TemporaryFile file{"dataset_file_test_inputs.bin"};
+    ASSERT_TRUE(dataset_file::Save<double>(input.View(), {}, file.Path()));
+    const MappedDataset<double> dataset{file.Path()};
+    EXPECT_EQ(dataset.NumOutputs(), 0U);
+    EXPECT_EQ(dataset.Outputs().NumRows(), 0U);
+    ExpectSameMatrix<double>(input.View(), dataset.Inputs());
+
+    const auto output{CreateMatrix<double>(9, 1)};
+    EXPECT_FALSE(dataset_file::Save<double>(input.View(), output.View(), file.Path()));
+}
+
+TEST(DatasetFileTest, TrainOnMappedSets) {
+    Matrix<double> input{4, 2};
+    Matrix<double> output{4, 1};
+    for (std::size_t i{}; i < 4; ++i) {
+        input.Row(i)[0] = static_cast<double>(i >> 1);
+        input.Row(i)[1] = static_cast<double>(i & 1);
+        output.Row(i)[0] = static_cast<double>((i >> 1) ^ (i & 1));
+    }
+    const TemporaryFile file{"dataset_file_test_xor.bin"};
+    ASSERT_TRUE(dataset_file::Save<double>(input.View(), output.View(), file.Path()));
+    const MappedDataset<double> dataset{file.Path()};
+
+    yrgo::utils::random::Seed(1);
+    NeuralNetwork network{2, 8, 1, ActFunc::kTanh, ActFunc::kTanh};
+    ASSERT_TRUE(network.AddTrainingData(dataset.Inputs(), dataset.Outputs()));
+    EXPECT_EQ(network.NumTrainingSets(), 4U);
+    ASSERT_TRUE(network.Train(5000, 0.1));
+    for (std::size_t i{}; i < 4; ++i) {
+        const std::vector<double> set{input.Row(i), input.Row(i) + 2};
+        EXPECT_NEAR(network.Predict(set)[0], output.Row(i)[0], 0.1);
+    }
+}
+
+TEST(DatasetFileTest, RejectsInvalidFiles) {
+    const auto input{CreateMatrix<double>(10, 2)};
+    const auto output{CreateMatrix<double>(10, 1)};
+    const TemporaryFile file{"dataset_file_test_invalid.bin"};
+    EXPECT_THROW(MappedDataset<double>{file.Path()}, std::runtime_error);
+
+    ASSERT_TRUE(dataset_file::Save<double>(input.View(), output.View(), file.Path()));
+    EXPECT_THROW(MappedDataset<float>{file.Path()}, std::runtime_error);
+
+    std::filesystem::resize_file(file.Path(), std::filesystem::file_size(file.Path()) - 1);
+    EXPECT_THROW(MappedDataset<double>{file.Path()}, std::runtime_error);
+
+    std::ofstream{file.Path(), std::ios::binary} << "Not a dataset file, just some text.....";
+    EXPECT_THROW(MappedDataset<double>{file.Path()}, std::runtime_error);
+}
+
+} /* namespace */
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,183 @@
+/********************************************************************************
+ * @brief Unit tests for the dataset readers. Datasets are written to temporary
+ *        files, which are then read back and streamed through the training.
+ ********************************************************************************/
+#include <gtest/gtest.h>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <dataset.hpp>
+#include <neural_network.hpp>
+#include <temporary_file.hpp>
+
+using namespace yrgo::machine_learning;
+using test::TemporaryFile;
+
+namespace {
+
+/********************************************************************************
+ * @brief Provides the value of input/output j of set i in the test datasets.
+ ********************************************************************************/
+double Value(const std::size_t i, const std::size_t j) { return i * 0.5 + j * 0.25; }
+
+template <typename Stored>
+void WriteBinary(const std::string& path, const std::size_t num_sets,
+                 const std::size_t num_values) {
+    std::ofstream file{path, std::ios::binary};
+    for (std::size_t i{}; i < num_sets; ++i) {
+        for (std::size_t j{}; j < num_values; ++j) {
+            const auto value{static_cast<Stored>(Value(i, j))};
+            file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+    }
+}
+
+/********************************************************************************
+ * @brief Reads all sets of specified reader in chunks of specified size and
+ *        verifies them against the test dataset.
+ ********************************************************************************/
+void ExpectDataset(DatasetReader<double>& reader, const std::size_t num_sets,
+                   const std::size_t chunk_size) {
+    Matrix<double> input{chunk_size, reader.NumInputs()};
+    Matrix<double> output{chunk_size, reader.NumOutputs()};
+    std::size_t num_read{};
+    while (const auto size{reader.Read(input.View(), output.View())}) {
+        for (std::size_t i{}; i < size; ++i) {
+            for (std::size_t j{}; j < reader.NumInputs(); ++j) {
+                EXPECT_DOUBLE_EQ(input.Row(i)[j], Value(num_read + i, j));
+            }
+            for (std::size_t j{}; j < reader.NumOutputs(); ++j) {
+                EXPECT_DOUBLE_EQ(output.Row(i)[j], Value(num_read + i, reader.NumInputs() + j));
+            }
+        }
+        num_read += size;
+    }
+    EXPECT_EQ(num_read, num_sets);
+}
+
+/********************************************************************************
+ * @brief Verifies that CSV files are parsed correctly, with and without header.
+ ********************************************************************************/
+TEST(Dataset, CsvReader) {
+    TemporaryFile file{"dataset_test.csv"};
+    {
+        std::ofstream stream{file.Path()};
+        stream << "x0;x1;y\n";
+        for (std::size_t i{}; i < 10; ++i) {
+            stream << Value(i, 0) << "; " << Value(i, 1) << ";" << Value(i, 2) << "\r\n";
+            if (i == 4) { stream << "\n"; }
+        }
+    }
+    CsvReader<double> reader{file.Path(), 2, 1, true, ';'};
+    ExpectDataset(reader, 10, 3);
+    reader.Rewind();
+    ExpectDataset(reader, 10, 16);
+}
+
+/********************************************************************************
+ * @brief Verifies that malformed CSV lines and missing files are reported.
+ ********************************************************************************/
+TEST(Dataset, CsvReaderRejectsInvalidFiles) {
+    TemporaryFile file{"dataset_test_invalid.csv"};
+    {
+        std::ofstream stream{file.Path()};
+        stream << "0,1,2\n" << "0,x,2\n";
+    }
+    CsvReader<double> reader{file.Path(), 2, 1};
+    Matrix<double> input{4, 2};
+    Matrix<double> output{4, 1};
+    EXPECT_THROW(reader.Read(input.View(), output.View()), std::runtime_error);
+    EXPECT_THROW((CsvReader<double>{file.Path() + ".missing", 2, 1}), std::runtime_error);
+}
+
+/********************************************************************************
+ * @brief Verifies that float32 and float64 binary files are read correctly and
+ *        that files of invalid size are rejected.
+ ********************************************************************************/
+TEST(Dataset, BinaryReader) {
+    TemporaryFile file32{"dataset_test.f32"};
+    TemporaryFile file64{"dataset_test.f64"};
+    WriteBinary<float>(file32.Path(), 13, 4);
+    WriteBinary<double>(file64.Path(), 13, 4);
+
+    BinaryReader<double> reader32{file32.Path(), 3, 1};
+    BinaryReader<double> reader64{file64.Path(), 3, 1, BinaryFormat::kFloat64};
+    EXPECT_EQ(reader32.NumSets(), 13U);
+    EXPECT_EQ(reader64.NumSets(), 13U);
+    ExpectDataset(reader32, 13, 5);
+    ExpectDataset(reader64, 13, 5);
+    reader64.Rewind();
+    ExpectDataset(reader64, 13, 13);
+    EXPECT_THROW((BinaryReader<double>{file32.Path(), 2, 1}), std::runtime_error);
+}
+
+/********************************************************************************
+ * @brief Verifies that the prefetching reader provides the sets of its source in
+ *        order, regardless of how its chunks align with the reads.
+ ********************************************************************************/
+TEST(Dataset, PrefetchReader) {
+    TemporaryFile file{"dataset_test_prefetch.f64"};
+    WriteBinary<double>(file.Path(), 100, 3);
+    BinaryReader<double> source{file.Path(), 2, 1, BinaryFormat::kFloat64};
+    PrefetchReader<double> reader{source, 7};
+    EXPECT_EQ(reader.NumInputs(), 2U);
+    EXPECT_EQ(reader.NumOutputs(), 1U);
+    ExpectDataset(reader, 100, 10);
+    reader.Rewind();
+    ExpectDataset(reader, 100, 3);
+}
+
+/********************************************************************************
+ * @brief Verifies that a network can be trained on sets streamed from a file,
+ *        with a shuffle buffer smaller than the dataset.
+ ********************************************************************************/
+TEST(Dataset, TrainFromStream) {
+    TemporaryFile file{"dataset_test_xor.csv"};
+    {
+        std::ofstream stream{file.Path()};
+        for (std::size_t i{}; i < 4; ++i) {
+            stream << (i >> 1) << "," << (i & 1) << "," << ((i >> 1) ^ (i & 1)) << "\n";
+        }
+    }
+    const std::vector<std::vector<double>> input{{0, 0}, {0, 1}, {1, 0}, {1, 1}};
+    const std::vector<std::vector<double>> output{{0}, {1}, {1}, {0}};
+
+    for (const std::size_t batch_size : {1U, 2U}) {
+        yrgo::utils::random::Seed(1);
+        NeuralNetwork network{2, 8, 1, ActFunc::kTanh, ActFunc::kTanh};
+        CsvReader<double> source{file.Path(), 2, 1};
+        PrefetchReader<double> reader{source, 3};
+        TrainingOptions options{};
+        options.num_epochs = 5000 * batch_size;
+        options.learning_rate = 0.1;
+        options.batch_size = batch_size;
+        options.shuffle_buffer_size = 3;
+
+        const auto report{network.Train(reader, options)};
+        EXPECT_EQ(report.num_epochs, options.num_epochs);
+        EXPECT_LT(report.training_loss.back(), report.training_loss.front());
+        for (std::size_t i{}; i < input.size(); ++i) {
+            EXPECT_NEAR(network.Predict(input[i])[0], output[i][0], 0.1);
+        }
+    }
+}
+
+/********************************************************************************
+ * @brief Verifies that streaming training is rejected if the reader doesn't
+ *        match the network.
+ ********************************************************************************/
+TEST(Dataset, TrainFromMismatchedStream) {
+    TemporaryFile file{"dataset_test_mismatch.f32"};
+    WriteBinary<float>(file.Path(), 4, 3);
+    BinaryReader<double> reader{file.Path(), 1, 2};
+    NeuralNetwork network{2, 3, 1};
+    EXPECT_EQ(network.Train(reader, TrainingOptions{}).num_epochs, 0U);
+}
+
+} /* namespace */
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -5,6 +5,9 @@
  *        trained during 1000 epochs each with a 1 % learning rate. 
  ********************************************************************************/
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <vector>
 #include <dense_layer.hpp>
 
@@ -57,6 +60,145 @@ TEST(DenseLayerTest, AllTests) {
     RunTests(inputs, outputs);
 }
 
+TEST(DenseLayerTest, ContiguousWeights) {
+    const DenseLayer layer{5, 13};
+    const auto matrix{layer.WeightMatrix()};
+    EXPECT_EQ(layer.NumWeightsPerNode(), 13U);
+    EXPECT_GE(layer.WeightStride(), layer.NumWeightsPerNode());
+    EXPECT_EQ(layer.WeightStride() * sizeof(double) % 64, 0U);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(matrix.data()) % 64, 0U);
+    EXPECT_EQ(matrix.size(), layer.NumNodes() * layer.WeightStride());
+
+    for (std::size_t i{}; i < layer.NumNodes(); ++i) {
+        const auto row{layer.Weights(i)};
+        EXPECT_EQ(row.size(), layer.NumWeightsPerNode());
+        EXPECT_EQ(row.data(), matrix.data() + i * layer.WeightStride());
+        for (std::size_t j{row.size()}; j < layer.WeightStride(); ++j) {
+            EXPECT_EQ(row.data()[j], 0.0);
+        }
+    }
+}
+
+TEST(DenseLayerTest, BatchMatchesSingleSample) {
+    const std::vector<double> input{0.5, -1.0, 0.25};
+    const std::vector<double> output{1.0, 0.0};
+    DenseLayer single{2, 3};
+    DenseLayer batch{single};
+
+    // Two identical samples in one batch average to the same update as one sample.
+    Matrix<double> batch_input{2, input.size()};
+    Matrix<double> batch_output{2, output.size()};
+    for (std::size_t i{}; i < 2; ++i) {
+        std::copy(input.begin(), input.end(), batch_input.Row(i));
+        std::copy(output.begin(), output.end(), batch_output.Row(i));
+    }
+
+    for (std::size_t i{}; i < 10; ++i) {
+        single.Feedforward(input);
+        const auto expected_loss{training::Loss(single.ActivationFunction(), 
+                                                single.Output().data(), output.data(), 2)};
+        EXPECT_DOUBLE_EQ(single.Backpropagate(output), expected_loss);
+        single.Optimize(input, 0.1);
+        batch.FeedforwardBatch(batch_input.View());
+        EXPECT_NEAR(batch.BackpropagateBatch(batch_output.View()), 2 * expected_loss, 1e-12);
+        batch.OptimizeBatch(batch_input.View(), 0.1);
+    }
+
+    for (std::size_t i{}; i < single.NumNodes(); ++i) {
+        EXPECT_NEAR(single.Bias()[i], batch.Bias()[i], 1e-12);
+        for (std::size_t j{}; j < single.NumWeightsPerNode(); ++j) {
+            EXPECT_NEAR(single.Weights(i)[j], batch.Weights(i)[j], 1e-12);
+        }
+    }
+}
+
+TEST(DenseLayerTest, ActivationDeltaMatchesDerivative) {
+    // The derivatives are calculated from the output, so they are compared with
+    // the central difference of the output function.
+    constexpr double kStep{1e-6};
+    activation::Dispatch(ActFunc::kTanh, [&](const auto act) {
+        EXPECT_EQ(decltype(act)::kActFunc, ActFunc::kTanh);
+    });
+    for (const auto act_func : {ActFunc::kRelu, ActFunc::kTanh, ActFunc::kSigmoid, 
+                                ActFunc::kLeakyRelu, ActFunc::kElu, ActFunc::kIdentity}) {
+        activation::Dispatch(act_func, [&](const auto act) {
+            if constexpr (decltype(act)::kElementwise) {
+                for (double x{-3.05}; x < 3.0; x += 0.1) {
+                    const auto derivative{(act.Output(x + kStep) - act.Output(x - kStep)) / 
+                                          (2 * kStep)};
+                    EXPECT_NEAR(derivative, act.Delta(act.Output(x)), 1e-6);
+                }
+            }
+        });
+    }
+}
+
+TEST(DenseLayerTest, ApplyMatchesOutput) {
+    for (const auto act_func : {ActFunc::kRelu, ActFunc::kTanh, ActFunc::kSigmoid, 
+                                ActFunc::kLeakyRelu, ActFunc::kElu, ActFunc::kIdentity}) {
+        activation::Dispatch(act_func, [&](const auto act) {
+            if constexpr (decltype(act)::kElementwise) {
+                std::vector<double> values{};
+                for (double x{-3.05}; x < 3.0; x += 0.1) { values.push_back(x); }
+                const auto sums{values};
+                act.Apply(values.data(), values.size(), fast_math::Accuracy::kHigh);
+                for (std::size_t i{}; i < sums.size(); ++i) {
+                    EXPECT_NEAR(act.Output(sums[i]), values[i], 1e-6);
+                }
+            }
+        });
+    }
+}
+
+TEST(DenseLayerTest, SoftmaxIsStable) {
+    // The largest sum is subtracted before exponentiating, so huge sums must 
+    // give the same distribution as small sums with the same differences.
+    std::vector<double> small{1, 2, 3};
+    std::vector<double> large{1001, 1002, 1003};
+    activation::Softmax::Apply(small.data(), small.size(), fast_math::Accuracy::kExact);
+    activation::Softmax::Apply(large.data(), large.size(), fast_math::Accuracy::kHigh);
+    const double sum{std::exp(1.0) + std::exp(2.0) + std::exp(3.0)};
+    for (std::size_t i{}; i < small.size(); ++i) {
+        EXPECT_NEAR(small[i], std::exp(i + 1.0) / sum, 1e-12);
+        EXPECT_NEAR(large[i], small[i], 1e-6);
+    }
+}
+
+TEST(DenseLayerTest, SoftmaxCrossEntropyGradient) {
+    // With softmax and cross-entropy, the error of each node is reference - output.
+    DenseLayer layer{3, 2, ActFunc::kSoftmax};
+    layer.Feedforward({0.5, -0.5});
+    double sum{};
+    for (const auto output : layer.Output()) { sum += output; }
+    EXPECT_NEAR(sum, 1.0, 1e-12);
+    const std::vector<double> reference{0, 1, 0};
+    layer.Backpropagate(reference);
+    for (std::size_t i{}; i < reference.size(); ++i) {
+        EXPECT_DOUBLE_EQ(layer.Error()[i], reference[i] - layer.Output()[i]);
+    }
+    TrainLayer(layer, {0.5, -0.5}, reference, 2000, 0.1);
+    EXPECT_GT(layer.Output()[1], 0.9);
+}
+
+TEST(DenseLayerTest, SigmoidSquaredErrorGradient) {
+    // Sigmoid outputs are trained with the mean squared error, so the error of 
+    // each node is scaled by the derivative of the sigmoid.
+    DenseLayer layer{2, 2, ActFunc::kSigmoid};
+    const std::vector<double> input{0.5, -0.5};
+    const std::vector<double> reference{1, 0};
+    layer.Feedforward(input);
+    const auto expected_loss{training::Loss(ActFunc::kSigmoid, layer.Output().data(), 
+                                            reference.data(), reference.size())};
+    EXPECT_DOUBLE_EQ(layer.Backpropagate(reference), expected_loss);
+    for (std::size_t i{}; i < reference.size(); ++i) {
+        const auto output{layer.Output()[i]};
+        EXPECT_DOUBLE_EQ(layer.Error()[i], (reference[i] - output) * output * (1 - output));
+    }
+    TrainLayer(layer, input, reference, 2000, 0.1);
+    EXPECT_GT(layer.Output()[0], 0.9);
+    EXPECT_LT(layer.Output()[1], 0.1);
+}
+
 } /* namespace */
 
 int main(int argc, char** argv) {
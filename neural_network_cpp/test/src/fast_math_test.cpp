@@ -0,0 +1,103 @@
+/********************************************************************************
+ * @brief Unit tests for the fast activation function approximations. Each 
+ *        approximation is compared with the standard library (evaluated with
+ *        long double precision) for every accuracy tier and every instruction 
+ *        set supported by the CPU.
+ ********************************************************************************/
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <fast_math.hpp>
+#include <linalg.hpp>
+#include <simd_levels.hpp>
+
+using namespace yrgo::machine_learning;
+using test::SupportedLevels;
+
+namespace {
+
+/********************************************************************************
+ * @brief Provides a dense grid over [-10, 10] followed by a few large values up
+ *        to max_input, with a size that isn't a multiple of any SIMD width.
+ ********************************************************************************/
+template <typename T>
+std::vector<T> TestInputs(const T max_input) {
+    std::vector<T> inputs{};
+    for (int i{-10000}; i <= 10000; ++i) { inputs.push_back(static_cast<T>(i * 0.001)); }
+    for (const T x : {20, 50, 100, 1000, 100000}) {
+        if (x > max_input) { break; }
+        inputs.push_back(x);
+        inputs.push_back(-x);
+    }
+    return inputs;
+}
+
+/********************************************************************************
+ * @brief Provides the maximum error of specified approximation, measured as
+ *        absolute error or relative error for outputs larger than one.
+ ********************************************************************************/
+template <typename T, typename Function, typename Reference>
+double MaxError(Function function, Reference reference, const fast_math::Accuracy accuracy,
+                const T max_input = 100000) {
+    auto values{TestInputs<T>(max_input)};
+    const auto inputs{values};
+    function(values.data(), values.size(), accuracy);
+    double max_error{};
+    for (std::size_t i{}; i < inputs.size(); ++i) {
+        const auto expected{reference(static_cast<long double>(inputs[i]))};
+        const auto error{std::abs(values[i] - expected) / std::max(1.0L, std::abs(expected))};
+        max_error = std::max(max_error, static_cast<double>(error));
+    }
+    return max_error;
+}
+
+template <typename T>
+void ExpectAccuracy(void) {
+    const auto tanh{[](const long double x) { return std::tanh(x); }};
+    const auto sigmoid{[](const long double x) { return 1 / (1 + std::exp(-x)); }};
+    const auto gelu{[](const long double x) {
+        return 0.5L * x * (1 + std::tanh(0.79788456080286535588L * (x + 0.044715L * x * x * x)));
+    }};
+    const auto softplus{[](const long double x) { 
+        return std::max(x, 0.0L) + std::log1p(std::exp(-std::abs(x))); 
+    }};
+    const auto exp{[](const long double x) { return std::exp(x); }};
+    const auto elu{[](const long double x) { return x > 0 ? x : std::expm1(x); }};
+
+    for (const auto level : SupportedLevels()) {
+        linalg::SetSimdLevel(level);
+        for (const auto& [accuracy, tolerance] : {std::pair{fast_math::Accuracy::kExact, 1e-6},
+                                                 std::pair{fast_math::Accuracy::kHigh, 1e-6},
+                                                 std::pair{fast_math::Accuracy::kLow, 1e-3}}) {
+            EXPECT_LE(MaxError<T>(fast_math::Tanh<T>, tanh, accuracy), tolerance);
+            EXPECT_LE(MaxError<T>(fast_math::Sigmoid<T>, sigmoid, accuracy), tolerance);
+            EXPECT_LE(MaxError<T>(fast_math::Gelu<T>, gelu, accuracy), tolerance);
+            EXPECT_LE(MaxError<T>(fast_math::Softplus<T>, softplus, accuracy), tolerance);
+            EXPECT_LE(MaxError<T>(fast_math::Exp<T>, exp, accuracy, 50), tolerance);
+            EXPECT_LE(MaxError<T>(fast_math::Elu<T>, elu, accuracy), tolerance);
+        }
+    }
+    linalg::SetSimdLevel(linalg::SupportedSimdLevel());
+}
+
+TEST(FastMathTest, FloatMaxError) { ExpectAccuracy<float>(); }
+
+TEST(FastMathTest, DoubleMaxError) { ExpectAccuracy<double>(); }
+
+TEST(FastMathTest, SaturatesWithoutOverflow) {
+    std::vector<float> values{-1e30f, -1e4f, 1e4f, 1e30f};
+    fast_math::Tanh(values.data(), values.size(), fast_math::Accuracy::kLow);
+    EXPECT_EQ(values, (std::vector<float>{-1, -1, 1, 1}));
+    values = {-1e30f, 1e30f};
+    fast_math::Softplus(values.data(), values.size(), fast_math::Accuracy::kHigh);
+    EXPECT_NEAR(values[0], 0.0f, 1e-30f);
+    EXPECT_FLOAT_EQ(values[1], 1e30f);
+}
+
+} /* namespace */
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,83 @@
+/********************************************************************************
+ * @brief Unit tests for the training instrumentation, which is enabled for this
+ *        test executable only.
+ ********************************************************************************/
+#include <gtest/gtest.h>
+#include <chrono>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <instrumentation.hpp>
+#include <neural_network.hpp>
+
+using namespace yrgo::machine_learning;
+
+namespace {
+
+std::uint64_t Calls(const instrumentation::Phase phase) {
+    return instrumentation::Phases()[static_cast<std::size_t>(phase)].calls.Value();
+}
+
+std::uint64_t Ticks(const instrumentation::Phase phase) {
+    return instrumentation::Phases()[static_cast<std::size_t>(phase)].ticks.Value();
+}
+
+TEST(InstrumentationTest, Enabled) {
+    EXPECT_TRUE(instrumentation::kEnabled);
+}
+
+TEST(InstrumentationTest, CountsLayerFlops) {
+    yrgo::utils::random::Seed(1);
+    NeuralNetwork network{2, 3, 1, ActFunc::kTanh, ActFunc::kTanh};
+    network.Predict({1.0, 0.0});
+    EXPECT_EQ(network.Layers()[0].NumFlops(), 12U);
+    EXPECT_EQ(network.Layers()[1].NumFlops(), 6U);
+
+    std::ostringstream profile{};
+    network.PrintProfile(profile);
+    EXPECT_NE(profile.str().find("layer 1"), std::string::npos);
+}
+
+TEST(InstrumentationTest, TimesTrainingPhases) {
+    yrgo::utils::random::Seed(1);
+    NeuralNetwork network{2, 3, 1, ActFunc::kTanh, ActFunc::kTanh};
+    network.AddTrainingData({{0, 0}, {0, 1}, {1, 0}, {1, 1}}, {{0}, {1}, {1}, {0}});
+    ASSERT_TRUE(network.Train(10, 0.1));
+
+    // The profile is reset at the start of every training.
+    EXPECT_EQ(Calls(instrumentation::Phase::kShuffle), 10U);
+    EXPECT_EQ(Calls(instrumentation::Phase::kFeedforward), 2U * 40U);
+    EXPECT_GT(Calls(instrumentation::Phase::kBackpropagate), 0U);
+    EXPECT_GT(Calls(instrumentation::Phase::kOptimize), 0U);
+    EXPECT_EQ(Calls(instrumentation::Phase::kValidation), 0U);
+
+    // Per set: feedforward (2 * 3 * 2), backpropagation from the output layer
+    // (2 * 1 * 3) and optimization (2 * 3 * (2 + 1)).
+    const auto hidden_flops{network.Layers()[0].NumFlops()};
+    EXPECT_EQ(hidden_flops, 40U * (12U + 6U + 18U));
+
+    std::ostringstream profile{};
+    network.PrintProfile(profile);
+    EXPECT_NE(profile.str().find("feedforward"), std::string::npos);
+    EXPECT_NE(profile.str().find("GFLOP/s"), std::string::npos);
+}
+
+TEST(InstrumentationTest, NestedTimersAreExclusive) {
+    instrumentation::Reset();
+    {
+        const instrumentation::ScopedTimer outer{instrumentation::Phase::kData};
+        const instrumentation::ScopedTimer inner{instrumentation::Phase::kFeedforward};
+        std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    }
+    EXPECT_EQ(Calls(instrumentation::Phase::kData), 1U);
+    EXPECT_EQ(Calls(instrumentation::Phase::kFeedforward), 1U);
+    EXPECT_GT(Ticks(instrumentation::Phase::kFeedforward),
+              10 * Ticks(instrumentation::Phase::kData));
+}
+
+} /* namespace */
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
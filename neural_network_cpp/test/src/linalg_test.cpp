@@ -0,0 +1,220 @@
+/********************************************************************************
+ * @brief Unit tests for the linear algebra kernels. The kernels of every 
+ *        instruction set supported by the CPU are compared with the scalar 
+ *        kernels for a range of vector lengths, including lengths that are not
+ *        multiples of the SIMD width.
+ ********************************************************************************/
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <vector>
+#include <linalg.hpp>
+#include <matrix.hpp>
+#include <scalar.hpp>
+#include <simd_levels.hpp>
+#include <utils.hpp>
+
+using namespace yrgo::machine_learning;
+using test::SupportedLevels;
+
+namespace {
+
+std::vector<double> RandomVector(const std::size_t size) {
+    std::vector<double> vector{};
+    yrgo::utils::random::InitVector<double>(vector, size, -1, 1);
+    return vector;
+}
+
+Matrix<double> RandomMatrix(const std::size_t num_rows, const std::size_t num_columns) {
+    Matrix<double> matrix{num_rows, num_columns};
+    for (std::size_t i{}; i < num_rows; ++i) {
+        for (std::size_t j{}; j < num_columns; ++j) {
+            matrix.Row(i)[j] = yrgo::utils::random::GetNumber<double>(-1, 1);
+        }
+    }
+    return matrix;
+}
+
+TEST(LinalgTest, DotAndAxpyMatchScalar) {
+    for (std::size_t size{}; size < 70; ++size) {
+        const auto x{RandomVector(size)};
+        const auto y{RandomVector(size)};
+        linalg::SetSimdLevel(linalg::SimdLevel::kScalar);
+        const auto expected_dot{linalg::Dot(x.data(), y.data(), size)};
+        auto expected_axpy{y};
+        linalg::Axpy(0.5, x.data(), expected_axpy.data(), size);
+
+        for (const auto level : SupportedLevels()) {
+            EXPECT_EQ(linalg::SetSimdLevel(level), level);
+            EXPECT_NEAR(expected_dot, linalg::Dot(x.data(), y.data(), size), 1e-12);
+            auto axpy{y};
+            linalg::Axpy(0.5, x.data(), axpy.data(), size);
+            for (std::size_t i{}; i < size; ++i) {
+                EXPECT_NEAR(expected_axpy[i], axpy[i], 1e-12);
+            }
+        }
+    }
+    linalg::SetSimdLevel(linalg::SupportedSimdLevel());
+}
+
+TEST(LinalgTest, MatrixProducts) {
+    const auto a{RandomMatrix(7, 13)};
+    const auto b{RandomMatrix(11, 13)};
+    const auto c{RandomMatrix(13, 5)};
+
+    for (const auto level : SupportedLevels()) {
+        linalg::SetSimdLevel(level);
+        Matrix<double> product{7, 11};
+        linalg::MultiplyTransposed(a.View(), b.View(), product.View());
+        for (std::size_t i{}; i < 7; ++i) {
+            for (std::size_t j{}; j < 11; ++j) {
+                double expected{};
+                for (std::size_t k{}; k < 13; ++k) { expected += a.Row(i)[k] * b.Row(j)[k]; }
+                EXPECT_NEAR(expected, product.Row(i)[j], 1e-12);
+            }
+        }
+
+        Matrix<double> ac{7, 5};
+        linalg::Multiply(a.View(), c.View(), ac.View());
+        Matrix<double> atb{13, 13};
+        linalg::AddTransposedProduct(a.View(), a.View(), atb.View());
+        for (std::size_t i{}; i < 7; ++i) {
+            for (std::size_t j{}; j < 5; ++j) {
+                double expected{};
+                for (std::size_t k{}; k < 13; ++k) { expected += a.Row(i)[k] * c.Row(k)[j]; }
+                EXPECT_NEAR(expected, ac.Row(i)[j], 1e-12);
+            }
+        }
+        for (std::size_t i{}; i < 13; ++i) {
+            for (std::size_t j{}; j < 13; ++j) {
+                double expected{};
+                for (std::size_t k{}; k < 7; ++k) { expected += a.Row(k)[i] * a.Row(k)[j]; }
+                EXPECT_NEAR(expected, atb.Row(i)[j], 1e-12);
+            }
+        }
+    }
+    linalg::SetSimdLevel(linalg::SupportedSimdLevel());
+}
+
+template <typename T>
+Matrix<T> ConvertMatrix(const Matrix<double>& matrix) {
+    Matrix<T> converted{matrix.NumRows(), matrix.NumColumns()};
+    for (std::size_t i{}; i < matrix.NumRows(); ++i) {
+        for (std::size_t j{}; j < matrix.NumColumns(); ++j) {
+            converted.Row(i)[j] = static_cast<T>(matrix.Row(i)[j]);
+        }
+    }
+    return converted;
+}
+
+template <typename T, typename U>
+void ExpectMatrixProducts(const std::size_t m, const std::size_t n, const std::size_t k,
+                          const double tolerance) {
+    const auto a{ConvertMatrix<U>(RandomMatrix(m, k))};
+    const auto b{ConvertMatrix<T>(RandomMatrix(n, k))};
+    const auto c{ConvertMatrix<T>(RandomMatrix(k, n))};
+    Matrix<U> abt{m, n}, ac{m, n};
+    linalg::MultiplyTransposed(a.View(), b.View(), abt.View());
+    linalg::Multiply(a.View(), c.View(), ac.View());
+    for (std::size_t i{}; i < m; ++i) {
+        for (std::size_t j{}; j < n; ++j) {
+            double expected_abt{}, expected_ac{};
+            for (std::size_t r{}; r < k; ++r) {
+                const double a_ir{a.Row(i)[r]};
+                expected_abt += a_ir * static_cast<U>(b.Row(j)[r]);
+                expected_ac += a_ir * static_cast<U>(c.Row(r)[j]);
+            }
+            EXPECT_NEAR(expected_abt, abt.Row(i)[j], tolerance);
+            EXPECT_NEAR(expected_ac, ac.Row(i)[j], tolerance);
+        }
+    }
+
+    // A row of a * b^T doesn't depend on the other rows, i.e. a batch prediction
+    // matches the prediction of each sample exactly.
+    for (std::size_t i{}; i < m; ++i) {
+        Matrix<U> row{1, n};
+        linalg::MultiplyTransposed(a.View().Rows(i, 1), b.View(), row.View());
+        for (std::size_t j{}; j < n; ++j) { EXPECT_EQ(abt.Row(i)[j], row.Row(0)[j]); }
+    }
+}
+
+TEST(LinalgTest, MatrixProductsOfAllTileShapes) {
+    // The sizes cover partial register tiles, vector tails and blocks of the 
+    // inner dimension for every instruction set.
+    for (const auto level : SupportedLevels()) {
+        linalg::SetSimdLevel(level);
+        for (const std::size_t m : {1, 2, 3, 4, 5, 9}) {
+            for (const std::size_t n : {1, 3, 8, 17, 35}) {
+                for (const std::size_t k : {1, 7, 16, 300}) {
+                    ExpectMatrixProducts<double, double>(m, n, k, 1e-12);
+                    ExpectMatrixProducts<float, float>(m, n, k, 1e-4);
+                    ExpectMatrixProducts<BFloat16, float>(m, n, k, 1e-4);
+                }
+            }
+        }
+    }
+    linalg::SetSimdLevel(linalg::SupportedSimdLevel());
+}
+
+TEST(LinalgTest, ReducedPrecisionKernels) {
+    for (std::size_t size{}; size < 70; ++size) {
+        const auto x{RandomVector(size)};
+        const auto y{RandomVector(size)};
+        const std::vector<float> x_f{x.begin(), x.end()};
+        const std::vector<float> y_f{y.begin(), y.end()};
+        std::vector<BFloat16> x_bf16{};
+        for (const auto& value : x_f) { x_bf16.emplace_back(value); }
+        double expected{};
+        for (std::size_t i{}; i < size; ++i) { expected += x[i] * y[i]; }
+
+        for (const auto level : SupportedLevels()) {
+            linalg::SetSimdLevel(level);
+            EXPECT_NEAR(expected, linalg::Dot(x_f.data(), y_f.data(), size), 1e-4);
+            EXPECT_NEAR(expected, linalg::Dot(x_bf16.data(), y_f.data(), size), 0.05);
+            auto axpy{y_f};
+            linalg::Axpy(0.5f, x_bf16.data(), axpy.data(), size);
+            auto update{x_bf16};
+            linalg::Axpy<float, BFloat16>(0.5f, y_f.data(), update.data(), size);
+            for (std::size_t i{}; i < size; ++i) {
+                EXPECT_NEAR(y[i] + 0.5 * x[i], axpy[i], 1e-2);
+                EXPECT_NEAR(x[i] + 0.5 * y[i], static_cast<float>(update[i]), 2e-2);
+            }
+        }
+    }
+    linalg::SetSimdLevel(linalg::SupportedSimdLevel());
+}
+
+TEST(LinalgTest, SetSimdLevelWhileKernelsRun) {
+    const auto x{RandomVector(67)};
+    const auto y{RandomVector(67)};
+    linalg::SetSimdLevel(linalg::SimdLevel::kScalar);
+    const auto expected{linalg::Dot(x.data(), y.data(), x.size())};
+
+    // The kernels are switched while other threads use them.
+    std::atomic<bool> done{false};
+    std::atomic<std::size_t> num_mismatches{};
+    std::vector<std::thread> threads{};
+    for (std::size_t i{}; i < 2; ++i) {
+        threads.emplace_back([&]() {
+            while (!done) {
+                const auto dot{linalg::Dot(x.data(), y.data(), x.size())};
+                if (std::abs(dot - expected) > 1e-12) { ++num_mismatches; }
+            }
+        });
+    }
+    for (std::size_t i{}; i < 1000; ++i) {
+        for (const auto level : SupportedLevels()) { linalg::SetSimdLevel(level); }
+    }
+    done = true;
+    for (auto& thread : threads) { thread.join(); }
+    EXPECT_EQ(num_mismatches, 0U);
+    linalg::SetSimdLevel(linalg::SupportedSimdLevel());
+}
+
+} /* namespace */
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,104 @@
+/********************************************************************************
+ * @brief Unit tests for the binary model files. Networks are saved to temporary
+ *        files, which are then mapped and compared with the original networks.
+ ********************************************************************************/
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <model_file.hpp>
+#include <temporary_file.hpp>
+
+using namespace yrgo::machine_learning;
+using test::TemporaryFile;
+
+namespace {
+
+template <typename T>
+Matrix<ComputeType<T>> CreateInputMatrix(const std::size_t num_sets, const std::size_t num_inputs) {
+    Matrix<ComputeType<T>> input{num_sets, num_inputs};
+    for (std::size_t i{}; i < num_sets; ++i) {
+        for (std::size_t j{}; j < num_inputs; ++j) {
+            input.Row(i)[j] = yrgo::utils::random::GetNumber<ComputeType<T>>(-1, 1);
+        }
+    }
+    return input;
+}
+
+template <typename T>
+void ExpectSamePredictions(const std::string& name) {
+    const BasicNeuralNetwork<T> network{5, std::vector<std::size_t>{7, 3}, 2, ActFunc::kTanh};
+    const TemporaryFile file{name};
+    ASSERT_TRUE(model_file::Save(network, file.Path()));
+
+    BasicMappedNeuralNetwork<T> mapped{file.Path()};
+    EXPECT_EQ(mapped.NumLayers(), network.NumLayers());
+    EXPECT_EQ(mapped.NumInputs(), network.NumInputs());
+    EXPECT_EQ(mapped.NumOutputs(), network.NumOutputs());
+
+    const auto input{CreateInputMatrix<T>(300, network.NumInputs())};
+    Matrix<ComputeType<T>> expected{input.NumRows(), network.NumOutputs()};
+    Matrix<ComputeType<T>> actual{input.NumRows(), network.NumOutputs()};
+    BasicInferenceContext<T> context{network};
+    ASSERT_TRUE(network.PredictBatch(input.View(), expected.View(), context));
+    ASSERT_TRUE(mapped.PredictBatch(input.View(), actual.View()));
+
+    for (std::size_t i{}; i < input.NumRows(); ++i) {
+        const std::vector<ComputeType<T>> set{input.Row(i), input.Row(i) + input.NumColumns()};
+        const auto& prediction{mapped.Predict(set)};
+        for (std::size_t j{}; j < network.NumOutputs(); ++j) {
+            EXPECT_EQ(expected.Row(i)[j], actual.Row(i)[j]);
+            EXPECT_EQ(expected.Row(i)[j], prediction[j]);
+        }
+    }
+}
+
+TEST(ModelFileTest, MappedNetworkMatchesOriginal) {
+    ExpectSamePredictions<double>("model_file_test_f64.bin");
+    ExpectSamePredictions<float>("model_file_test_f32.bin");
+    ExpectSamePredictions<BFloat16>("model_file_test_bf16.bin");
+}
+
+TEST(ModelFileTest, CopyLayers) {
+    const NeuralNetwork network{2, 3, 1, ActFunc::kTanh};
+    const TemporaryFile file{"model_file_test_copy.bin"};
+    ASSERT_TRUE(model_file::Save(network, file.Path()));
+    const MappedNeuralNetwork mapped{file.Path()};
+    NeuralNetwork copy{mapped.CopyLayers()};
+
+    for (std::size_t i{}; i < network.NumLayers(); ++i) {
+        const auto& expected{network.Layers()[i]};
+        const auto& actual{copy.Layers()[i]};
+        EXPECT_EQ(expected.ActivationFunction(), actual.ActivationFunction());
+        for (std::size_t j{}; j < expected.NumNodes(); ++j) {
+            EXPECT_EQ(expected.Bias()[j], actual.Bias()[j]);
+            for (std::size_t k{}; k < expected.NumWeightsPerNode(); ++k) {
+                EXPECT_EQ(expected.Weights(j)[k], actual.Weights(j)[k]);
+            }
+        }
+    }
+}
+
+TEST(ModelFileTest, RejectsInvalidFiles) {
+    const NeuralNetwork network{2, 3, 1};
+    const TemporaryFile file{"model_file_test_invalid.bin"};
+    EXPECT_THROW(MappedNeuralNetwork{file.Path()}, std::runtime_error);
+
+    ASSERT_TRUE(model_file::Save(network, file.Path()));
+    EXPECT_THROW(BasicMappedNeuralNetwork<float>{file.Path()}, std::runtime_error);
+
+    std::filesystem::resize_file(file.Path(), std::filesystem::file_size(file.Path()) - 1);
+    EXPECT_THROW(MappedNeuralNetwork{file.Path()}, std::runtime_error);
+
+    std::ofstream{file.Path(), std::ios::binary} << "Not a model file, just some text.";
+    EXPECT_THROW(MappedNeuralNetwork{file.Path()}, std::runtime_error);
+}
+
+} /* namespace */
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
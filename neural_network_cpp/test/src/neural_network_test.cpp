@@ -0,0 +1,459 @@
+/********************************************************************************
+ * @brief Unit tests for neural networks with two inputs and one output. The 
+ *        networks are trained to predict a 2-bit XOR pattern, after which the 
+ *        different training and prediction paths are compared.
+ ********************************************************************************/
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <neural_network.hpp>
+
+using namespace yrgo::machine_learning;
+
+namespace {
+
+const std::vector<std::vector<double>> kTrainInput{{0, 0}, {0, 1}, {1, 0}, {1, 1}};
+const std::vector<std::vector<double>> kTrainOutput{{0}, {1}, {1}, {0}};
+
+NeuralNetwork CreateTrainedNetwork(const std::size_t num_epochs = 1000,
+                                   const double learning_rate = 0.05) {
+    NeuralNetwork network{2, 3, 1, ActFunc::kTanh};
+    network.AddTrainingData(kTrainInput, kTrainOutput);
+    network.Train(num_epochs, learning_rate);
+    return network;
+}
+
+Matrix<double> CreateInputMatrix(const std::size_t num_sets) {
+    Matrix<double> input{num_sets, 2};
+    for (std::size_t i{}; i < num_sets; ++i) {
+        input.Row(i)[0] = static_cast<double>(i % 2);
+        input.Row(i)[1] = static_cast<double>((i / 2) % 2);
+    }
+    return input;
+}
+
+TEST(NeuralNetworkTest, PredictBatchMatchesPredict) {
+    auto network{CreateTrainedNetwork()};
+    const auto input{CreateInputMatrix(1000)};
+    Matrix<double> output{input.NumRows(), network.NumOutputs()};
+    ASSERT_TRUE(network.PredictBatch(input.View(), output.View()));
+
+    for (std::size_t i{}; i < input.NumRows(); ++i) {
+        const std::vector<double> set{input.Row(i), input.Row(i) + input.NumColumns()};
+        EXPECT_NEAR(network.Predict(set)[0], output.Row(i)[0], 1e-12);
+    }
+}
+
+TEST(NeuralNetworkTest, PredictBatchRejectsSmallOutput) {
+    auto network{CreateTrainedNetwork(1)};
+    const auto input{CreateInputMatrix(4)};
+    Matrix<double> output{3, network.NumOutputs()};
+    EXPECT_FALSE(network.PredictBatch(input.View(), output.View()));
+}
+
+TEST(NeuralNetworkTest, ConcurrentPredictOnSharedNetwork) {
+    const auto network{CreateTrainedNetwork()};
+    const auto input{CreateInputMatrix(512)};
+    Matrix<double> expected{input.NumRows(), network.NumOutputs()};
+    InferenceContext reference_context{network};
+    ASSERT_TRUE(network.PredictBatch(input.View(), expected.View(), reference_context));
+
+    std::vector<Matrix<double>> outputs(4, Matrix<double>{input.NumRows(), network.NumOutputs()});
+    std::vector<std::thread> threads{};
+    for (auto& output : outputs) {
+        threads.emplace_back([&network, &input, &output]() {
+            InferenceContext context{network};
+            for (std::size_t i{}; i < input.NumRows(); ++i) {
+                const std::vector<double> set{input.Row(i), input.Row(i) + input.NumColumns()};
+                output.Row(i)[0] = network.Predict(set, context)[0];
+            }
+        });
+    }
+    for (auto& thread : threads) { thread.join(); }
+
+    for (const auto& output : outputs) {
+        for (std::size_t i{}; i < input.NumRows(); ++i) {
+            EXPECT_NEAR(expected.Row(i)[0], output.Row(i)[0], 1e-12);
+        }
+    }
+}
+
+TEST(NeuralNetworkTest, DeepNetwork) {
+    // A fixed seed makes the training reproducible, since a deep ReLU output 
+    // occasionally gets stuck for unlucky initial parameters.
+    yrgo::utils::random::Seed(1);
+    NeuralNetwork network{2, std::vector<std::size_t>{4, 4, 4}, 1, ActFunc::kTanh, ActFunc::kRelu};
+    EXPECT_EQ(network.NumLayers(), 4U);
+    EXPECT_EQ(network.NumInputs(), 2U);
+    EXPECT_EQ(network.NumHiddenNodes(), 4U);
+    EXPECT_EQ(network.NumOutputs(), 1U);
+
+    network.AddTrainingData(kTrainInput, kTrainOutput);
+    ASSERT_TRUE(network.Train(3000, 0.1));
+    for (std::size_t i{}; i < kTrainInput.size(); ++i) {
+        EXPECT_NEAR(network.Predict(kTrainInput[i])[0], kTrainOutput[i][0], 0.1);
+    }
+}
+
+TEST(NeuralNetworkTest, AddTrainingDataFromMatrix) {
+    Matrix<double> input{kTrainInput.size(), 2};
+    Matrix<double> output{kTrainOutput.size(), 1};
+    for (std::size_t i{}; i < kTrainInput.size(); ++i) {
+        std::copy(kTrainInput[i].begin(), kTrainInput[i].end(), input.Row(i));
+        output.Row(i)[0] = kTrainOutput[i][0];
+    }
+
+    // Networks trained with copied, borrowed and moved data in the same order
+    // end up with the same parameters.
+    NeuralNetwork copied{2, 3, 1, ActFunc::kTanh};
+    NeuralNetwork borrowed{copied};
+    NeuralNetwork moved{copied};
+    ASSERT_TRUE(copied.AddTrainingData(kTrainInput, kTrainOutput));
+    ASSERT_TRUE(borrowed.AddTrainingData(input.View(), output.View()));
+    EXPECT_FALSE(moved.AddTrainingData(Matrix<double>{4, 3}, Matrix<double>{4, 1}));
+    ASSERT_TRUE(moved.AddTrainingData(Matrix<double>{input}, Matrix<double>{output}));
+    EXPECT_EQ(borrowed.NumTrainingSets(), 4U);
+    EXPECT_EQ(moved.NumTrainingSets(), 4U);
+
+    for (auto* network : {&copied, &borrowed, &moved}) {
+        yrgo::utils::random::Seed(1);
+        ASSERT_TRUE(network->Train(20, 0.1));
+    }
+    for (std::size_t i{}; i < kTrainInput.size(); ++i) {
+        const auto expected{copied.Predict(kTrainInput[i])[0]};
+        EXPECT_DOUBLE_EQ(expected, borrowed.Predict(kTrainInput[i])[0]);
+        EXPECT_DOUBLE_EQ(expected, moved.Predict(kTrainInput[i])[0]);
+    }
+}
+
+TEST(NeuralNetworkTest, CreateFromLayers) {
+    std::vector<DenseLayer> layers{DenseLayer{8, 2}, DenseLayer{4, 8}, DenseLayer{1, 4}};
+    const NeuralNetwork network{layers};
+    EXPECT_EQ(network.NumLayers(), 3U);
+    EXPECT_EQ(network.NumInputs(), 2U);
+    EXPECT_EQ(network.NumOutputs(), 1U);
+
+    EXPECT_THROW(NeuralNetwork{std::vector<DenseLayer>{}}, std::invalid_argument);
+    EXPECT_THROW((NeuralNetwork{{DenseLayer{8, 2}, DenseLayer{1, 4}}}), std::invalid_argument);
+}
+
+TEST(NeuralNetworkTest, SynchronousParallelMatchesBatchTraining) {
+    NeuralNetwork serial{2, std::vector<std::size_t>{5, 3}, 1, ActFunc::kTanh};
+    NeuralNetwork parallel{serial};
+    serial.AddTrainingData(kTrainInput, kTrainOutput);
+    parallel.AddTrainingData(kTrainInput, kTrainOutput);
+
+    // Equal seeds give both networks the same training order.
+    yrgo::utils::random::Seed(1);
+    ASSERT_TRUE(serial.Train(50, 0.1, 4));
+    yrgo::utils::random::Seed(1);
+    ASSERT_TRUE(parallel.TrainParallel(50, 0.1, 4, 3));
+
+    for (std::size_t i{}; i < serial.NumLayers(); ++i) {
+        const auto& expected{serial.Layers()[i]};
+        const auto& actual{parallel.Layers()[i]};
+        for (std::size_t j{}; j < expected.NumNodes(); ++j) {
+            EXPECT_NEAR(expected.Bias()[j], actual.Bias()[j], 1e-9);
+            for (std::size_t k{}; k < expected.NumWeightsPerNode(); ++k) {
+                EXPECT_NEAR(expected.Weights(j)[k], actual.Weights(j)[k], 1e-9);
+            }
+        }
+    }
+}
+
+TEST(NeuralNetworkTest, HogwildTraining) {
+    NeuralNetwork network{2, 3, 1, ActFunc::kTanh};
+    EXPECT_FALSE(network.TrainParallel(10, 0.1, 1, 2, ParallelMode::kHogwild));
+    network.AddTrainingData(kTrainInput, kTrainOutput);
+    ASSERT_TRUE(network.TrainParallel(100, 0.05, 1, 2, ParallelMode::kHogwild));
+    for (const auto& input : kTrainInput) {
+        EXPECT_TRUE(std::isfinite(network.Predict(input)[0]));
+    }
+}
+
+template <typename T>
+BasicNeuralNetwork<T> ConvertNetwork(const NeuralNetwork& network) {
+    std::vector<BasicDenseLayer<T>> layers{};
+    for (const auto& source : network.Layers()) {
+        auto& layer{layers.emplace_back(source.NumNodes(), source.NumWeightsPerNode(), 
+                                        source.ActivationFunction())};
+        for (std::size_t i{}; i < source.NumNodes(); ++i) {
+            layer.Bias()[i] = static_cast<float>(source.Bias()[i]);
+            for (std::size_t j{}; j < source.NumWeightsPerNode(); ++j) {
+                layer.Weights(i)[j] = static_cast<float>(source.Weights(i)[j]);
+            }
+        }
+    }
+    return BasicNeuralNetwork<T>{std::move(layers)};
+}
+
+TEST(NeuralNetworkTest, ReducedPrecisionMatchesDouble) {
+    auto network{CreateTrainedNetwork()};
+    auto single{ConvertNetwork<float>(network)};
+    auto brain{ConvertNetwork<BFloat16>(network)};
+    for (const auto& input : kTrainInput) {
+        const std::vector<float> input_f{input.begin(), input.end()};
+        const auto expected{network.Predict(input)[0]};
+        EXPECT_NEAR(expected, single.Predict(input_f)[0], 1e-5);
+        EXPECT_NEAR(expected, brain.Predict(input_f)[0], 5e-2);
+    }
+}
+
+TEST(NeuralNetworkTest, TrainFloatNetwork) {
+    BasicNeuralNetwork<float> network{2, 3, 1, ActFunc::kTanh};
+    const std::vector<std::vector<float>> input{{0, 0}, {0, 1}, {1, 0}, {1, 1}};
+    const std::vector<std::vector<float>> output{{0}, {1}, {1}, {0}};
+    network.AddTrainingData(input, output);
+    ASSERT_TRUE(network.Train(100, 0.05f, 2));
+    for (const auto& set : input) {
+        EXPECT_TRUE(std::isfinite(network.Predict(set)[0]));
+    }
+}
+
+TEST(NeuralNetworkTest, FastActivationsMatchExact) {
+    auto network{CreateTrainedNetwork()};
+    const auto input{CreateInputMatrix(64)};
+    Matrix<double> expected{input.NumRows(), network.NumOutputs()};
+    Matrix<double> output{input.NumRows(), network.NumOutputs()};
+    ASSERT_TRUE(network.PredictBatch(input.View(), expected.View()));
+
+    for (const auto& [accuracy, tolerance] : {std::pair{fast_math::Accuracy::kHigh, 1e-5},
+                                              std::pair{fast_math::Accuracy::kLow, 1e-2}}) {
+        network.SetActivationAccuracy(accuracy);
+        ASSERT_TRUE(network.PredictBatch(input.View(), output.View()));
+        for (std::size_t i{}; i < input.NumRows(); ++i) {
+            const std::vector<double> set{input.Row(i), input.Row(i) + input.NumColumns()};
+            EXPECT_NEAR(expected.Row(i)[0], output.Row(i)[0], tolerance);
+            EXPECT_NEAR(expected.Row(i)[0], network.Predict(set)[0], tolerance);
+        }
+    }
+}
+
+TEST(NeuralNetworkTest, SoftmaxClassifier) {
+    // XOR as two classes, trained with the fused softmax and cross-entropy gradient.
+    const std::vector<std::vector<double>> classes{{1, 0}, {0, 1}, {0, 1}, {1, 0}};
+    NeuralNetwork network{2, 8, 2, ActFunc::kTanh, ActFunc::kSoftmax};
+    network.AddTrainingData(kTrainInput, classes);
+    ASSERT_TRUE(network.Train(3000, 0.1));
+    for (std::size_t i{}; i < kTrainInput.size(); ++i) {
+        const auto& output{network.Predict(kTrainInput[i])};
+        EXPECT_NEAR(output[0] + output[1], 1.0, 1e-12);
+        EXPECT_NEAR(output[1], classes[i][1], 0.2);
+    }
+    EXPECT_THROW((NeuralNetwork{2, 3, 1, ActFunc::kSoftmax}), std::invalid_argument);
+}
+
+TEST(NeuralNetworkTest, TrainWithOptimizers) {
+    const std::vector<std::pair<OptimizerType, double>> optimizers{
+        {OptimizerType::kMomentum, 0.02}, {OptimizerType::kNesterov, 0.02},
+        {OptimizerType::kRmsProp, 0.005}, {OptimizerType::kAdam, 0.02},
+        {OptimizerType::kAdamW, 0.02}};
+    for (const auto& [type, learning_rate] : optimizers) {
+        // A fixed seed gives the same initial parameters for every optimizer.
+        yrgo::utils::random::Seed(1);
+        NeuralNetwork network{2, 8, 1, ActFunc::kTanh, ActFunc::kTanh};
+        network.SetOptimizer({type});
+        network.AddTrainingData(kTrainInput, kTrainOutput);
+        ASSERT_TRUE(network.Train(2000, learning_rate));
+        for (std::size_t i{}; i < kTrainInput.size(); ++i) {
+            EXPECT_NEAR(network.Predict(kTrainInput[i])[0], kTrainOutput[i][0], 0.1);
+        }
+    }
+}
+
+TEST(NeuralNetworkTest, OptimizerCountsUpdatesOfAllTrainingPaths) {
+    NeuralNetwork serial{2, 4, 1, ActFunc::kTanh, ActFunc::kTanh};
+    serial.SetOptimizer({OptimizerType::kAdam});
+    NeuralNetwork parallel{serial};
+    serial.AddTrainingData(kTrainInput, kTrainOutput);
+    parallel.AddTrainingData(kTrainInput, kTrainOutput);
+
+    // Single samples and batches of one give the same updates, so the networks
+    // only match if the bias correction of Adam continues with the batch size.
+    yrgo::utils::random::Seed(1);
+    ASSERT_TRUE(serial.Train(3, 0.01, 1));
+    ASSERT_TRUE(serial.Train(3, 0.01, 2));
+    yrgo::utils::random::Seed(1);
+    ASSERT_TRUE(parallel.TrainParallel(3, 0.01, 1, 2));
+    ASSERT_TRUE(parallel.Train(3, 0.01, 2));
+    for (const auto& input : kTrainInput) {
+        EXPECT_NEAR(serial.Predict(input)[0], parallel.Predict(input)[0], 1e-9);
+    }
+}
+
+TEST(NeuralNetworkTest, TrainWithOptions) {
+    NeuralNetwork network{2, 8, 1, ActFunc::kTanh, ActFunc::kTanh};
+    EXPECT_EQ(network.Train(TrainingOptions{}).num_epochs, 0U);
+    network.AddTrainingData(kTrainInput, kTrainOutput);
+    TrainingOptions options{};
+    options.num_epochs = 20;
+    options.learning_rate = 0.05;
+    options.schedule.type = ScheduleType::kCosine;
+    options.schedule.warmup_epochs = 2;
+
+    // Without validation sets every epoch is run and no loss is measured.
+    auto report{network.Train(options)};
+    EXPECT_EQ(report.num_epochs, 20U);
+    EXPECT_FALSE(report.stopped_early);
+    EXPECT_TRUE(report.validation_loss.empty());
+    EXPECT_GT(report.wall_time.count(), 0.0);
+
+    ASSERT_TRUE(network.SetValidationData(kTrainInput, kTrainOutput));
+    EXPECT_EQ(network.NumValidationSets(), 4U);
+    report = network.Train(options);
+    EXPECT_EQ(report.num_epochs, 20U);
+    EXPECT_EQ(report.validation_loss.size(), 20U);
+}
+
+TEST(NeuralNetworkTest, EpochMetrics) {
+    NeuralNetwork network{2, 8, 1, ActFunc::kTanh, ActFunc::kTanh};
+    network.AddTrainingData(kTrainInput, kTrainOutput);
+    network.SetValidationData(kTrainInput, kTrainOutput);
+    std::vector<EpochMetrics> metrics{};
+    TrainingOptions options{};
+    options.num_epochs = 500;
+    options.learning_rate = 0.05;
+    options.on_epoch = [&metrics](const EpochMetrics& epoch) { metrics.push_back(epoch); };
+
+    const auto report{network.Train(options)};
+    ASSERT_EQ(metrics.size(), 500U);
+    ASSERT_EQ(report.training_loss.size(), 500U);
+    for (std::size_t i{}; i < metrics.size(); ++i) {
+        EXPECT_EQ(metrics[i].epoch, i + 1);
+        EXPECT_DOUBLE_EQ(metrics[i].learning_rate, 0.05);
+        EXPECT_DOUBLE_EQ(metrics[i].training_loss, report.training_loss[i]);
+        EXPECT_DOUBLE_EQ(metrics[i].validation_loss, report.validation_loss[i]);
+    }
+    EXPECT_LT(metrics.back().training_loss, metrics.front().training_loss);
+
+    // The training loss is measured while the parameters change, so it trails the
+    // validation loss measured after the epoch (with the same sets).
+    EXPECT_NEAR(metrics.back().training_loss, metrics.back().validation_loss, 0.05);
+}
+
+TEST(NeuralNetworkTest, BatchLossMatchesSerialLoss) {
+    NeuralNetwork serial{2, 4, 1, ActFunc::kTanh, ActFunc::kTanh};
+    NeuralNetwork parallel{serial};
+    serial.AddTrainingData(kTrainInput, kTrainOutput);
+    parallel.AddTrainingData(kTrainInput, kTrainOutput);
+    TrainingOptions options{};
+    options.num_epochs = 10;
+    options.learning_rate = 0.1;
+    options.batch_size = 4;
+
+    yrgo::utils::random::Seed(1);
+    const auto expected{serial.Train(options)};
+    options.num_threads = 2;
+    yrgo::utils::random::Seed(1);
+    const auto actual{parallel.Train(options)};
+    ASSERT_EQ(expected.training_loss.size(), actual.training_loss.size());
+    for (std::size_t i{}; i < expected.training_loss.size(); ++i) {
+        EXPECT_NEAR(expected.training_loss[i], actual.training_loss[i], 1e-9);
+    }
+}
+
+TEST(NeuralNetworkTest, EarlyStopping) {
+    NeuralNetwork network{2, 8, 1, ActFunc::kTanh, ActFunc::kTanh};
+    network.AddTrainingData(kTrainInput, kTrainOutput);
+    network.SetValidationData(kTrainInput, kTrainOutput);
+    TrainingOptions options{};
+    options.num_epochs = 100000;
+    options.learning_rate = 0.05;
+    options.patience = 10;
+    options.min_improvement = 1e-4;
+
+    const auto report{network.Train(options)};
+    EXPECT_TRUE(report.stopped_early);
+    EXPECT_LT(report.num_epochs, options.num_epochs);
+    EXPECT_EQ(report.num_epochs, report.validation_loss.size());
+    ASSERT_GT(report.best_epoch, 0U);
+    EXPECT_LE(report.best_epoch + options.patience, report.num_epochs);
+
+    // The parameters of the best epoch are restored.
+    double loss{};
+    for (std::size_t i{}; i < kTrainInput.size(); ++i) {
+        const auto error{kTrainOutput[i][0] - network.Predict(kTrainInput[i])[0]};
+        loss += error * error;
+    }
+    EXPECT_NEAR(loss / kTrainInput.size(), report.validation_loss[report.best_epoch - 1], 1e-12);
+}
+
+TEST(NeuralNetworkTest, ParallelEarlyStoppingMatchesSerial) {
+    NeuralNetwork serial{2, 8, 1, ActFunc::kTanh, ActFunc::kTanh};
+    NeuralNetwork parallel{serial};
+    for (auto* network : {&serial, &parallel}) {
+        network->AddTrainingData(kTrainInput, kTrainOutput);
+        network->SetValidationData(kTrainInput, kTrainOutput);
+    }
+    TrainingOptions options{};
+    options.num_epochs = 100000;
+    options.learning_rate = 0.05;
+    options.schedule.type = ScheduleType::kCosine;
+    options.batch_size = 4;
+    options.patience = 10;
+    options.min_improvement = 1e-4;
+
+    // The parallel epochs run in one set of threads, which stops with the schedule
+    // and early stopping of the serial training.
+    yrgo::utils::random::Seed(1);
+    const auto expected{serial.Train(options)};
+    options.num_threads = 2;
+    yrgo::utils::random::Seed(1);
+    const auto actual{parallel.Train(options)};
+    EXPECT_TRUE(actual.stopped_early);
+    EXPECT_EQ(actual.num_epochs, expected.num_epochs);
+    EXPECT_EQ(actual.best_epoch, expected.best_epoch);
+    EXPECT_NEAR(parallel.Predict(kTrainInput[1])[0], serial.Predict(kTrainInput[1])[0], 1e-9);
+}
+
+TEST(NeuralNetworkTest, TrainCopyWithValidationData) {
+    NeuralNetwork network{2, 3, 1, ActFunc::kTanh, ActFunc::kTanh};
+    network.AddTrainingData(kTrainInput, kTrainOutput);
+    network.SetValidationData(kTrainInput, kTrainOutput);
+    TrainingOptions options{};
+    options.num_epochs = 10;
+    options.learning_rate = 0.1;
+
+    // The copy validates with its own prediction buffer.
+    NeuralNetwork copy{network};
+    const auto report{copy.Train(options)};
+    ASSERT_EQ(report.validation_loss.size(), options.num_epochs);
+    for (const auto loss : report.validation_loss) { EXPECT_FALSE(std::isnan(loss)); }
+
+    NeuralNetwork assigned{2, 3, 1};
+    assigned = network;
+    EXPECT_EQ(assigned.Train(options).validation_loss.size(), options.num_epochs);
+}
+
+TEST(NeuralNetworkTest, EpochCallbackExceptionStopsParallelTraining) {
+    NeuralNetwork network{2, 3, 1, ActFunc::kTanh, ActFunc::kTanh};
+    network.AddTrainingData(kTrainInput, kTrainOutput);
+    TrainingOptions options{};
+    options.num_epochs = 100;
+    options.learning_rate = 0.1;
+    std::size_t num_epochs{};
+    options.on_epoch = [&num_epochs](const EpochMetrics& metrics) {
+        num_epochs = metrics.epoch;
+        if (metrics.epoch == 3) { throw std::runtime_error{"Stop"}; }
+    };
+
+    // The exception reaches the caller after all worker threads are joined.
+    for (const std::size_t num_threads : {1, 2, 4}) {
+        options.num_threads = num_threads;
+        EXPECT_THROW(network.Train(options), std::runtime_error);
+        EXPECT_EQ(num_epochs, 3U);
+    }
+    options.on_epoch = nullptr;
+    EXPECT_EQ(network.Train(options).num_epochs, options.num_epochs);
+}
+
+} /* namespace */
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
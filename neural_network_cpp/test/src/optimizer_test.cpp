@@ -0,0 +1,114 @@
+/********************************************************************************
+ * @brief Unit tests for the optimizers. The fused update kernels are compared
+ *        with straightforward scalar implementations of the update rules for
+ *        every instruction set supported by the CPU, using a number of
+ *        parameters that isn't a multiple of any SIMD width.
+ ********************************************************************************/
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include <linalg.hpp>
+#include <optimizer.hpp>
+#include <simd_levels.hpp>
+#include <utils.hpp>
+
+using namespace yrgo::machine_learning;
+using test::SupportedLevels;
+
+namespace {
+
+constexpr std::size_t kNumParameters{37};
+constexpr std::size_t kNumUpdates{5};
+
+/********************************************************************************
+ * @brief Reference implementation of one update of a single parameter.
+ ********************************************************************************/
+void ReferenceUpdate(const OptimizerConfig& config, const optimizer::UpdateStep& step,
+                     const double gradient, double& w, double& s1, double& s2) {
+    auto d{gradient * step.gradient_scale};
+    if (config.type == OptimizerType::kAdamW) {
+        w -= step.learning_rate * config.weight_decay * w;
+    } else {
+        d -= config.weight_decay * w;
+    }
+    const auto t{static_cast<double>(step.count)};
+    switch (config.type) {
+        case OptimizerType::kSgd:
+            w += step.learning_rate * d;
+            break;
+        case OptimizerType::kMomentum:
+            s1 = config.momentum * s1 + d;
+            w += step.learning_rate * s1;
+            break;
+        case OptimizerType::kNesterov:
+            s1 = config.momentum * s1 + d;
+            w += step.learning_rate * (d + config.momentum * s1);
+            break;
+        case OptimizerType::kRmsProp:
+            s1 = config.decay * s1 + (1 - config.decay) * d * d;
+            w += step.learning_rate * d / (std::sqrt(s1) + config.epsilon);
+            break;
+        default:
+            s1 = config.momentum * s1 + (1 - config.momentum) * d;
+            s2 = config.decay * s2 + (1 - config.decay) * d * d;
+            w += step.learning_rate * (s1 / (1 - std::pow(config.momentum, t))) /
+                (std::sqrt(s2 / (1 - std::pow(config.decay, t))) + config.epsilon);
+    }
+}
+
+template <typename T>
+void ExpectMatchesReference(const OptimizerConfig& config, const double tolerance) {
+    std::vector<std::vector<double>> gradients{};
+    yrgo::utils::random::InitVector<double>(gradients, kNumUpdates, kNumParameters, -1, 1);
+    std::vector<double> initial{};
+    yrgo::utils::random::InitVector<double>(initial, kNumParameters, -1, 1);
+
+    auto expected{initial};
+    std::vector<double> s1(kNumParameters), s2(kNumParameters);
+    for (std::size_t i{}; i < kNumUpdates; ++i) {
+        const optimizer::UpdateStep step{0.01, 0.5, i + 1};
+        for (std::size_t j{}; j < kNumParameters; ++j) {
+            ReferenceUpdate(config, step, gradients[i][j], expected[j], s1[j], s2[j]);
+        }
+    }
+
+    for (const auto level : SupportedLevels()) {
+        linalg::SetSimdLevel(level);
+        std::vector<T> parameters{initial.begin(), initial.end()};
+        std::vector<T> state(optimizer::NumStateBuffers(config.type) * kNumParameters);
+        for (std::size_t i{}; i < kNumUpdates; ++i) {
+            const std::vector<T> gradient{gradients[i].begin(), gradients[i].end()};
+            optimizer::Update(config, {0.01, 0.5, i + 1}, gradient.data(), parameters.data(),
+                              state.empty() ? nullptr : state.data(), kNumParameters,
+                              kNumParameters);
+        }
+        for (std::size_t j{}; j < kNumParameters; ++j) {
+            EXPECT_NEAR(expected[j], parameters[j], tolerance);
+        }
+    }
+    linalg::SetSimdLevel(linalg::SupportedSimdLevel());
+}
+
+TEST(OptimizerTest, UpdatesMatchReference) {
+    for (const auto type : {OptimizerType::kSgd, OptimizerType::kMomentum,
+                            OptimizerType::kNesterov, OptimizerType::kRmsProp,
+                            OptimizerType::kAdam, OptimizerType::kAdamW}) {
+        const OptimizerConfig config{type, 0.9, 0.999, 1e-8, 0.01};
+        ExpectMatchesReference<double>(config, 1e-12);
+        ExpectMatchesReference<float>(config, 1e-5);
+    }
+}
+
+TEST(OptimizerTest, NumStateBuffers) {
+    EXPECT_EQ(optimizer::NumStateBuffers(OptimizerType::kSgd), 0U);
+    EXPECT_EQ(optimizer::NumStateBuffers(OptimizerType::kNesterov), 1U);
+    EXPECT_EQ(optimizer::NumStateBuffers(OptimizerType::kRmsProp), 1U);
+    EXPECT_EQ(optimizer::NumStateBuffers(OptimizerType::kAdamW), 2U);
+}
+
+} /* namespace */
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
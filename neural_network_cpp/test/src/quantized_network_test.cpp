@@ -0,0 +1,111 @@
+/********************************************************************************
+ * @brief Unit tests for int8 quantized neural networks. Trained networks are
+ *        quantized, after which the predictions are compared with the 
+ *        predictions of the original networks.
+ ********************************************************************************/
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include <linalg.hpp>
+#include <quantized_network.hpp>
+
+using namespace yrgo::machine_learning;
+
+namespace {
+
+Matrix<double> CreateInputMatrix(const std::size_t num_sets, const std::size_t num_inputs) {
+    Matrix<double> input{num_sets, num_inputs};
+    for (std::size_t i{}; i < num_sets; ++i) {
+        for (std::size_t j{}; j < num_inputs; ++j) {
+            input.Row(i)[j] = yrgo::utils::random::GetNumber<double>(-1, 1);
+        }
+    }
+    return input;
+}
+
+NeuralNetwork CreateNetwork(const std::vector<std::size_t>& num_nodes) {
+    // Zero-mean weights scaled by the fan-in resemble a trained network, in 
+    // contrast to the default initialization, whose gain amplifies any error.
+    std::vector<DenseLayer> layers{};
+    for (std::size_t i{1}; i < num_nodes.size(); ++i) {
+        auto& layer{layers.emplace_back(num_nodes[i], num_nodes[i - 1], ActFunc::kTanh)};
+        const auto limit{1.0 / std::sqrt(static_cast<double>(num_nodes[i - 1]))};
+        for (std::size_t j{}; j < layer.NumNodes(); ++j) {
+            layer.Bias()[j] = yrgo::utils::random::GetNumber<double>(-limit, limit);
+            for (auto& weight : layer.Weights(j)) {
+                weight = yrgo::utils::random::GetNumber<double>(-3 * limit, 3 * limit);
+            }
+        }
+    }
+    return NeuralNetwork{std::move(layers)};
+}
+
+TEST(QuantizedNetworkTest, DotInt8MatchesScalar) {
+    for (std::size_t size{}; size < 100; ++size) {
+        std::vector<std::int8_t> x(size), y(size);
+        std::int32_t expected{};
+        for (std::size_t i{}; i < size; ++i) {
+            x[i] = static_cast<std::int8_t>(yrgo::utils::random::GetNumber<int>(-127, 127));
+            y[i] = static_cast<std::int8_t>(yrgo::utils::random::GetNumber<int>(-127, 127));
+            expected += x[i] * y[i];
+        }
+        for (const auto level : {linalg::SimdLevel::kScalar, linalg::SimdLevel::kAvx2, 
+                                 linalg::SimdLevel::kAvx512}) {
+            linalg::SetSimdLevel(level);
+            EXPECT_EQ(expected, linalg::DotInt8(x.data(), y.data(), size));
+        }
+    }
+    linalg::SetSimdLevel(linalg::SupportedSimdLevel());
+}
+
+TEST(QuantizedNetworkTest, MatchesOriginalNetwork) {
+    const auto network{CreateNetwork({32, 64, 32, 4})};
+    const auto calibration{CreateInputMatrix(256, network.NumInputs())};
+    QuantizedNeuralNetwork quantized{network, calibration.View()};
+    EXPECT_EQ(quantized.NumInputs(), network.NumInputs());
+    EXPECT_EQ(quantized.NumOutputs(), network.NumOutputs());
+
+    const auto input{CreateInputMatrix(128, network.NumInputs())};
+    const auto report{quantized.Compare(network, input.View())};
+    EXPECT_EQ(report.num_sets, input.NumRows());
+    EXPECT_LT(report.max_error, 0.1);
+    EXPECT_LT(report.mean_error, 0.02);
+    EXPECT_GE(report.original_size, 4 * report.quantized_size);
+}
+
+TEST(QuantizedNetworkTest, PredictBatchMatchesPredict) {
+    // More sets than fit in one block of the batch prediction.
+    const BasicNeuralNetwork<float> network{8, 16, 2, ActFunc::kTanh};
+    Matrix<float> input{300, network.NumInputs()};
+    for (std::size_t i{}; i < input.NumRows(); ++i) {
+        for (std::size_t j{}; j < input.NumColumns(); ++j) {
+            input.Row(i)[j] = yrgo::utils::random::GetNumber<float>(0, 1);
+        }
+    }
+    QuantizedNeuralNetwork quantized{network, input.View()};
+    Matrix<float> output{input.NumRows(), quantized.NumOutputs()};
+    ASSERT_TRUE(quantized.PredictBatch(input.View(), output.View()));
+    Matrix<float> small_output{input.NumRows() - 1, quantized.NumOutputs()};
+    EXPECT_FALSE(quantized.PredictBatch(input.View(), small_output.View()));
+
+    for (std::size_t i{}; i < input.NumRows(); ++i) {
+        const std::vector<float> set{input.Row(i), input.Row(i) + input.NumColumns()};
+        const auto& prediction{quantized.Predict(set)};
+        for (std::size_t j{}; j < quantized.NumOutputs(); ++j) {
+            EXPECT_EQ(prediction[j], output.Row(i)[j]);
+        }
+    }
+}
+
+TEST(QuantizedNetworkTest, RequiresCalibrationSets) {
+    const NeuralNetwork network{2, 3, 1};
+    const Matrix<double> empty{};
+    EXPECT_THROW((QuantizedNeuralNetwork{network, empty.View()}), std::invalid_argument);
+}
+
+} /* namespace */
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,78 @@
+/********************************************************************************
+ * @brief Unit tests for neural networks with a topology fixed at compile time.
+ *        Trained networks are copied to static networks, after which the
+ *        predictions are compared with the predictions of the original networks.
+ ********************************************************************************/
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+#include <static_neural_network.hpp>
+
+using namespace yrgo::machine_learning;
+
+namespace {
+
+template <typename Network, typename StaticNetwork>
+void ExpectSamePredictions(Network& network, const StaticNetwork& copy) {
+    using T = typename StaticNetwork::Input::value_type;
+    for (std::size_t i{}; i < 20; ++i) {
+        typename StaticNetwork::Input input{};
+        yrgo::utils::random::Fill(input.data(), input.size(), T{-1}, T{1});
+        const auto expected{network.Predict(std::vector<T>(input.begin(), input.end()))};
+        const auto output{copy.Predict(input)};
+        for (std::size_t j{}; j < output.size(); ++j) {
+            EXPECT_NEAR(output[j], expected[j], 1e-5);
+        }
+    }
+}
+
+TEST(StaticNeuralNetworkTest, MatchesTrainedNetwork) {
+    yrgo::utils::random::Seed(1);
+    const std::vector<std::vector<double>> input{{0, 0}, {0, 1}, {1, 0}, {1, 1}};
+    NeuralNetwork network{2, 3, 1, ActFunc::kTanh};
+    network.AddTrainingData(input, {{0}, {1}, {1}, {0}});
+    ASSERT_TRUE(network.Train(1000, 0.1));
+
+    const StaticNeuralNetwork<ActFunc::kTanh, ActFunc::kRelu, 2, 3, 1> copy{network};
+    static_assert(copy.NumInputs() == 2 && copy.NumOutputs() == 1 && copy.NumLayers() == 2);
+    for (const auto& set : input) {
+        const auto output{copy.Predict({set[0], set[1]})};
+        EXPECT_NEAR(output[0], network.Predict(set)[0], 1e-12);
+    }
+    EXPECT_EQ(copy.Layer<1>().Bias()[0], network.Layers()[1].Bias()[0]);
+    EXPECT_EQ(copy.Layer<0>().Weights()[2][1], network.Layers()[0].Weights(2)[1]);
+}
+
+TEST(StaticNeuralNetworkTest, MatchesDeepNetworks) {
+    yrgo::utils::random::Seed(2);
+    NeuralNetwork network{4, std::vector<std::size_t>{6, 5}, 3, ActFunc::kTanh,
+                          ActFunc::kSoftmax};
+    const BasicStaticNeuralNetwork<double, ActFunc::kTanh, ActFunc::kSoftmax,
+                                   4, 6, 5, 3> copy{network};
+    ExpectSamePredictions(network, copy);
+
+    BasicNeuralNetwork<float> float_network{4, std::vector<std::size_t>{6, 5}, 3,
+                                            ActFunc::kTanh, ActFunc::kSoftmax};
+    const BasicStaticNeuralNetwork<float, ActFunc::kTanh, ActFunc::kSoftmax,
+                                   4, 6, 5, 3> float_copy{float_network};
+    ExpectSamePredictions(float_network, float_copy);
+}
+
+TEST(StaticNeuralNetworkTest, RejectsMismatchingNetworks) {
+    const NeuralNetwork network{2, 3, 1, ActFunc::kTanh};
+    using Xor = StaticNeuralNetwork<ActFunc::kTanh, ActFunc::kRelu, 2, 3, 1>;
+    EXPECT_NO_THROW(Xor{network});
+    EXPECT_THROW((StaticNeuralNetwork<ActFunc::kTanh, ActFunc::kRelu, 2, 4, 1>{network}),
+                 std::invalid_argument);
+    EXPECT_THROW((StaticNeuralNetwork<ActFunc::kRelu, ActFunc::kRelu, 2, 3, 1>{network}),
+                 std::invalid_argument);
+    EXPECT_THROW((StaticNeuralNetwork<ActFunc::kTanh, ActFunc::kRelu, 2, 3, 3, 1>{network}),
+                 std::invalid_argument);
+}
+
+} /* namespace */
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
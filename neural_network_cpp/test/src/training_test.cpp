@@ -0,0 +1,86 @@
+/********************************************************************************
+ * @brief Unit tests for the learning-rate schedules and the loss functions used
+ *        when training neural networks.
+ ********************************************************************************/
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include <training.hpp>
+
+using namespace yrgo::machine_learning;
+
+namespace {
+
+TEST(TrainingTest, ConstantSchedule) {
+    const LearningRateSchedule schedule{};
+    for (std::size_t i{}; i < 10; ++i) {
+        EXPECT_DOUBLE_EQ(training::LearningRate(schedule, 0.1, i, 10), 0.1);
+    }
+}
+
+TEST(TrainingTest, StepSchedule) {
+    const LearningRateSchedule schedule{ScheduleType::kStep, 3, 0.1};
+    EXPECT_DOUBLE_EQ(training::LearningRate(schedule, 1.0, 0, 10), 1.0);
+    EXPECT_DOUBLE_EQ(training::LearningRate(schedule, 1.0, 2, 10), 1.0);
+    EXPECT_DOUBLE_EQ(training::LearningRate(schedule, 1.0, 3, 10), 0.1);
+    EXPECT_DOUBLE_EQ(training::LearningRate(schedule, 1.0, 6, 10), 0.01);
+}
+
+TEST(TrainingTest, CosineSchedule) {
+    LearningRateSchedule schedule{};
+    schedule.type = ScheduleType::kCosine;
+    schedule.min_learning_rate = 0.1;
+    EXPECT_DOUBLE_EQ(training::LearningRate(schedule, 1.0, 0, 10), 1.0);
+    EXPECT_DOUBLE_EQ(training::LearningRate(schedule, 1.0, 5, 10), 0.55);
+    for (std::size_t i{1}; i < 10; ++i) {
+        const auto learning_rate{training::LearningRate(schedule, 1.0, i, 10)};
+        EXPECT_LT(learning_rate, training::LearningRate(schedule, 1.0, i - 1, 10));
+        EXPECT_GT(learning_rate, schedule.min_learning_rate);
+    }
+}
+
+TEST(TrainingTest, Warmup) {
+    LearningRateSchedule schedule{};
+    schedule.type = ScheduleType::kCosine;
+    schedule.warmup_epochs = 3;
+    EXPECT_DOUBLE_EQ(training::LearningRate(schedule, 1.0, 0, 13), 0.25);
+    EXPECT_DOUBLE_EQ(training::LearningRate(schedule, 1.0, 2, 13), 0.75);
+    EXPECT_DOUBLE_EQ(training::LearningRate(schedule, 1.0, 3, 13), 1.0);
+    EXPECT_DOUBLE_EQ(training::LearningRate(schedule, 1.0, 8, 13), 0.5);
+}
+
+TEST(TrainingTest, Loss) {
+    const std::vector<double> output{0.5, 0.25, 0.25};
+    const std::vector<double> reference{1, 0, 0};
+    EXPECT_DOUBLE_EQ(training::Loss(ActFunc::kTanh, output.data(), reference.data(), 3),
+                     (0.25 + 0.0625 + 0.0625) / 3);
+    EXPECT_DOUBLE_EQ(training::Loss(ActFunc::kSoftmax, output.data(), reference.data(), 3),
+                     -std::log(0.5));
+    EXPECT_DOUBLE_EQ(training::Loss(ActFunc::kSigmoid, output.data(), reference.data(), 3),
+                     (0.25 + 0.0625 + 0.0625) / 3);
+}
+
+TEST(TrainingTest, SigmoidSquaredErrorGradient) {
+    // The error of a sigmoid output node must be the negative derivative of half
+    // the squared error with respect to the weighted sum.
+    constexpr double kStep{1e-6};
+    const activation::Sigmoid sigmoid{};
+    for (const double reference : {0.0, 0.3, 1.0}) {
+        for (double x{-3.05}; x < 3.0; x += 0.1) {
+            const auto output{sigmoid.Output(x)};
+            const auto derivative{
+                (training::LossTerm(ActFunc::kSigmoid, sigmoid.Output(x + kStep), reference) -
+                 training::LossTerm(ActFunc::kSigmoid, sigmoid.Output(x - kStep), reference)) / 
+                (2 * kStep)};
+            EXPECT_NEAR(-derivative / 2, 
+                        (reference - output) * training::OutputDelta(sigmoid, output), 1e-6);
+        }
+    }
+}
+
+} /* namespace */
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
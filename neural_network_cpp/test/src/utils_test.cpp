@@ -0,0 +1,118 @@
+/********************************************************************************
+ * @brief Unit tests for the random number generation utilities.
+ ********************************************************************************/
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <thread>
+#include <vector>
+#include <utils.hpp>
+
+using namespace yrgo::utils;
+
+namespace {
+
+TEST(UtilsTest, SeedIsReproducible) {
+    random::Seed(42);
+    std::vector<double> expected{};
+    random::InitVector<double>(expected, 100, -1, 1);
+    const auto expected_number{random::GetNumber<int>(0, 1000)};
+
+    random::Seed(42);
+    std::vector<double> actual{};
+    random::InitVector<double>(actual, 100, -1, 1);
+    EXPECT_EQ(expected, actual);
+    EXPECT_EQ(expected_number, random::GetNumber<int>(0, 1000));
+}
+
+TEST(UtilsTest, NumbersWithinRange) {
+    random::Seed(1);
+    std::vector<int> counts(7);
+    for (int i{}; i < 70000; ++i) {
+        const auto number{random::GetNumber<int>(-3, 3)};
+        ASSERT_GE(number, -3);
+        ASSERT_LE(number, 3);
+        ++counts[number + 3];
+    }
+    for (const auto count : counts) { EXPECT_NEAR(count, 10000, 500); }
+
+    for (const auto size : {1U, 2U, 3U, 1001U}) {
+        std::vector<float> floats{};
+        random::InitVector<float>(floats, size, -2, 5);
+        for (const auto number : floats) {
+            EXPECT_GE(number, -2.0f);
+            EXPECT_LE(number, 5.0f);
+        }
+    }
+    std::vector<double> doubles{};
+    random::InitVector<double>(doubles, 10000, 10, 20);
+    EXPECT_GE(*std::min_element(doubles.begin(), doubles.end()), 10.0);
+    EXPECT_LT(*std::max_element(doubles.begin(), doubles.end()), 20.0);
+    EXPECT_NEAR(std::accumulate(doubles.begin(), doubles.end(), 0.0) / doubles.size(), 15, 0.1);
+}
+
+template <typename T>
+void ExpectFillIsReproducible(const std::size_t size) {
+    std::vector<T> expected(size), actual(size), next(size);
+    random::Seed(3);
+    random::Fill(expected.data(), size, T{-1}, T{1});
+    random::Fill(next.data(), size, T{-1}, T{1});
+    random::Seed(3);
+    random::Fill(actual.data(), size, T{-1}, T{1});
+    EXPECT_EQ(expected, actual);
+    EXPECT_NE(expected, next);
+    for (const auto number : expected) {
+        EXPECT_GE(number, T{-1});
+        EXPECT_LT(number, T{1});
+    }
+}
+
+TEST(UtilsTest, FillIsReproducible) {
+    // Large buffers are filled with interleaved generators, small ones with the
+    // generator of the thread only.
+    for (const auto size : {1U, 63U, 64U, 67U, 1000U}) {
+        ExpectFillIsReproducible<float>(size);
+        ExpectFillIsReproducible<double>(size);
+    }
+    std::vector<float> floats(100000);
+    random::Fill(floats.data(), floats.size(), 0.0f, 1.0f);
+    const auto mean{std::accumulate(floats.begin(), floats.end(), 0.0) / floats.size()};
+    EXPECT_NEAR(mean, 0.5, 0.01);
+}
+
+TEST(UtilsTest, ShuffleIsPermutation) {
+    random::Seed(1);
+    std::vector<std::size_t> vector(1000);
+    std::iota(vector.begin(), vector.end(), 0);
+    random::ShuffleVector<std::size_t>(vector);
+    EXPECT_FALSE(std::is_sorted(vector.begin(), vector.end()));
+    std::sort(vector.begin(), vector.end());
+    for (std::size_t i{}; i < vector.size(); ++i) { EXPECT_EQ(vector[i], i); }
+
+    // Every element must be equally likely to end up first.
+    std::vector<int> counts(4);
+    for (int i{}; i < 40000; ++i) {
+        std::vector<int> small{0, 1, 2, 3};
+        random::ShuffleVector<int>(small);
+        ++counts[small.front()];
+    }
+    for (const auto count : counts) { EXPECT_NEAR(count, 10000, 500); }
+}
+
+TEST(UtilsTest, ThreadsHaveOwnGenerators) {
+    random::Seed(7);
+    std::uint64_t first{}, second{};
+    std::thread thread1{[&first]() { first = random::Generator()(); }};
+    thread1.join();
+    std::thread thread2{[&second]() { second = random::Generator()(); }};
+    thread2.join();
+    EXPECT_NE(first, second);
+}
+
+} /* namespace */
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}